@@ -0,0 +1,71 @@
+"""
+Measures per query cost of support and basis queries of BSplines and
+NURBS. Supports and rational basis values are written directly into the
+output arrays, so runtime per query should not depend on the number of
+queries.
+"""
+
+from time import perf_counter as tic
+
+import numpy as np
+
+import splinepy
+
+
+def best_of(func, repeat=3):
+    """Returns best runtime of func in seconds."""
+    timings = []
+    for _ in range(repeat):
+        now = tic()
+        func()
+        timings.append(tic() - now)
+    return min(timings)
+
+
+if __name__ == "__main__":
+    np_rng = np.random.default_rng()
+    dim = 3
+
+    print(
+        f"{'spline':>8} {'para_dim':>8} {'function':>24} "
+        f"{'n_queries':>10} {'[us/query]':>11}"
+    )
+    for para_dim in (1, 2, 3):
+        degrees = [2] * para_dim
+        knot_vectors = [[0, 0, 0, 0.25, 0.5, 0.75, 1, 1, 1]] * para_dim
+        n_cps = 6**para_dim
+        bspline = splinepy.BSpline(
+            degrees=degrees,
+            knot_vectors=knot_vectors,
+            control_points=np_rng.random((n_cps, dim)),
+        )
+        nurbs = splinepy.NURBS(
+            degrees=degrees,
+            knot_vectors=knot_vectors,
+            control_points=np_rng.random((n_cps, dim)),
+            weights=np_rng.random((n_cps, 1)) + 0.5,
+        )
+        orders = [1] + [0] * (para_dim - 1)
+        for spline in (bspline, nurbs):
+            for n_queries in (1000, 100000):
+                queries = np_rng.random((n_queries, para_dim))
+                functions = {
+                    "support": lambda s=spline, q=queries: s.support(
+                        q, nthreads=1
+                    ),
+                    "basis": lambda s=spline, q=queries: s.basis(
+                        q, nthreads=1
+                    ),
+                    "basis_and_support": lambda s=spline, q=queries: (
+                        s.basis_and_support(q, nthreads=1)
+                    ),
+                    "basis_der_and_support": lambda s=spline, q=queries: (
+                        s.basis_derivative_and_support(q, orders, nthreads=1)
+                    ),
+                }
+                for name, func in functions.items():
+                    per_query = best_of(func) / n_queries * 1e6
+                    print(
+                        f"{spline.name:>8} {para_dim:>8} {name:>24} "
+                        f"{n_queries:>10} {per_query:>11.3f}"
+                    )
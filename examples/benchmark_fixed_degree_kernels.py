@@ -0,0 +1,61 @@
+"""
+Compares compile-time degree kernels against the generic evaluation path
+for bezier splines of common parametric dimensions and degrees.
+"""
+
+from time import perf_counter as tic
+
+import numpy as np
+
+import splinepy
+
+
+def best_of(func, repeat=3):
+    """Returns best runtime of func in seconds."""
+    timings = []
+    for _ in range(repeat):
+        now = tic()
+        func()
+        timings.append(tic() - now)
+    return min(timings)
+
+
+if __name__ == "__main__":
+    np_rng = np.random.default_rng()
+    core = splinepy.splinepy_core
+    n_queries = 20000
+    dim = 3
+
+    print(
+        f"{'para_dim':>8} {'degree':>6} {'function':>16} "
+        f"{'generic [s]':>12} {'fixed [s]':>12} {'speedup':>8}"
+    )
+    for para_dim in (1, 2, 3):
+        queries = np_rng.random((n_queries, para_dim))
+        orders = [1] + [0] * (para_dim - 1)
+        for degree in (1, 2, 3):
+            bezier = splinepy.Bezier(
+                degrees=[degree] * para_dim,
+                control_points=np_rng.random(
+                    ((degree + 1) ** para_dim, dim)
+                ),
+            )
+            functions = {
+                "evaluate": lambda b=bezier, q=queries: b.evaluate(
+                    q, nthreads=1
+                ),
+                "derivative": lambda b=bezier, q=queries: b.derivative(
+                    q, orders, nthreads=1
+                ),
+                "basis": lambda b=bezier, q=queries: b.basis(q, nthreads=1),
+            }
+            for name, func in functions.items():
+                core.use_fixed_degree_kernels(False)
+                generic = best_of(func)
+                core.use_fixed_degree_kernels(True)
+                fixed = best_of(func)
+                print(
+                    f"{para_dim:>8} {degree:>6} {name:>16} "
+                    f"{generic:>12.5f} {fixed:>12.5f} "
+                    f"{generic / fixed:>8.2f}"
+                )
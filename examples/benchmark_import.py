@@ -0,0 +1,91 @@
+"""
+Measures import time and resident memory of splinepy, before and after the
+first spline with parametric dimension above 3. Compare a default build with
+one configured with `-DSPLINEPY_LAZY_MORE=ON`, where those splines are in a
+separate library that is only loaded on first use.
+
+Each measurement runs in a fresh interpreter. Memory is read from
+/proc/self/status, so it is only reported on Linux.
+"""
+
+import json
+import subprocess
+import sys
+
+MEASURE = r"""
+import json
+import sys
+from time import perf_counter as tic
+
+
+def rss_mb():
+    try:
+        with open("/proc/self/status") as f:
+            for line in f:
+                if line.startswith("VmRSS:"):
+                    return int(line.split()[1]) / 1024
+    except OSError:
+        pass
+    return float("nan")
+
+
+def more_loaded():
+    try:
+        with open("/proc/self/maps") as f:
+            return "splinepy_more" in f.read()
+    except OSError:
+        return None
+
+
+import numpy as np
+
+base_rss = rss_mb()
+now = tic()
+import splinepy
+
+import_time = tic() - now
+import_rss = rss_mb()
+loaded_at_import = more_loaded()
+
+now = tic()
+splinepy.Bezier(degrees=[1] * 4, control_points=np.zeros((16, 2)))
+first_use_time = tic() - now
+
+print(
+    json.dumps(
+        {
+            "import [ms]": import_time * 1e3,
+            "import RSS [MB]": import_rss - base_rss,
+            "more loaded at import": loaded_at_import,
+            "first para_dim 4 [ms]": first_use_time * 1e3,
+            "RSS after first para_dim 4 [MB]": rss_mb() - base_rss,
+            "more loaded after use": more_loaded(),
+            "minimal": splinepy.splinepy_core.is_minimal(),
+        }
+    )
+)
+"""
+
+
+def measure():
+    """Runs measurement in a fresh interpreter."""
+    out = subprocess.run(
+        [sys.executable, "-c", MEASURE],
+        check=True,
+        capture_output=True,
+        text=True,
+    )
+    return json.loads(out.stdout.strip().splitlines()[-1])
+
+
+if __name__ == "__main__":
+    n_runs = 5
+    runs = [measure() for _ in range(n_runs)]
+
+    print(f"best of {n_runs} fresh interpreters")
+    for key, value in runs[0].items():
+        if isinstance(value, float):
+            value = min(run[key] for run in runs)
+            print(f"{key:>32}: {value:10.2f}")
+        else:
+            print(f"{key:>32}: {value!s:>10}")
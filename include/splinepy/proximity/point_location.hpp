@@ -0,0 +1,125 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "splinepy/proximity/proximity.hpp"
+#include "splinepy/splines/splinepy_base.hpp"
+#include "splinepy/utils/default_initialization_allocator.hpp"
+
+namespace splinepy::proximity {
+
+/*!
+ * Locates physical points in a set of volumetric patches (para_dim == dim).
+ *
+ * Each patch is bounded by the axis aligned bounding box of its control
+ * points, which are registered in a uniform grid of cells. For a query, only
+ * the patches of its cell whose bounding box contains the query are inverse
+ * mapped with `Proximity::VerboseQuery()`. A query is inside a patch if the
+ * distance to its closest point is within tolerance. Newton iterations of the
+ * inverse mapping use their own tolerance, given per query. Candidates are
+ * checked in ascending patch id, so points on an interface belong to the patch
+ * with the lowest id.
+ *
+ * Construction plants a kdtree for every patch, so instances are meant to be
+ * kept and reused for as long as the patches don't change.
+ */
+class PointLocation {
+public:
+  using Patches_ =
+      std::vector<std::shared_ptr<splinepy::splines::SplinepyBase>>;
+  using IntVector_ = splinepy::utils::DefaultInitializationVector<int>;
+  using DoubleVector_ = splinepy::utils::DefaultInitializationVector<double>;
+
+  /// @brief Per-thread buffers for proximity queries
+  struct Workspace {
+    DoubleVector_ guess;
+    DoubleVector_ nearest;
+    DoubleVector_ difference;
+    DoubleVector_ first_derivatives;
+    DoubleVector_ second_derivatives;
+
+    Workspace(const int para_dim, const int dim)
+        : guess(para_dim),
+          nearest(dim),
+          difference(dim),
+          first_derivatives(para_dim * dim),
+          second_derivatives(para_dim * para_dim * dim) {}
+  };
+
+protected:
+  Patches_ patches_;
+  std::vector<std::unique_ptr<Proximity>> proximities_;
+
+  // (n_patches, 2, dim) control point bounding boxes
+  DoubleVector_ patch_bounds_;
+
+  // uniform cell grid - (2, dim) bounds, (dim) resolutions and cell sizes
+  DoubleVector_ grid_bounds_;
+  IntVector_ grid_resolutions_;
+  DoubleVector_ cell_sizes_;
+
+  // patch ids of each cell in compressed format
+  IntVector_ cell_offsets_;
+  IntVector_ cell_patch_ids_;
+
+  int para_dim_;
+  int dim_;
+  int sample_resolution_;
+  double tolerance_;
+
+  /// @brief Cell id of given point. -1 if point is outside of the grid
+  /// @param point (dim)
+  int CellId(const double* point) const;
+
+public:
+  /// @brief Computes bounding boxes, registers them in a cell grid and plants
+  /// a kdtree for each patch
+  /// @param patches
+  /// @param sample_resolution kdtree sampling resolution. For non-positive
+  /// values, two times control mesh resolutions are used
+  /// @param tolerance distance tolerance for inside classification
+  /// @param n_thread
+  PointLocation(const Patches_& patches,
+                const int sample_resolution,
+                const double tolerance,
+                const int n_thread = 1);
+
+  /// @brief Sample resolution this was constructed with
+  int SampleResolution() const { return sample_resolution_; }
+
+  /// @brief Distance tolerance for inside classification
+  double Tolerance() const { return tolerance_; }
+
+  /// @brief Locates a single point
+  /// @param[in] query (dim)
+  /// @param[in] newton_tolerance convergence tolerance of inverse mapping
+  /// @param[in] max_iterations newton max iterations. negative for default
+  /// @param[in] workspace
+  /// @param[out] para_coord (para_dim) untouched if not found
+  /// @return patch id or -1
+  int Locate(const double* query,
+             const double newton_tolerance,
+             const int max_iterations,
+             Workspace& workspace,
+             double* para_coord) const;
+
+  /// @brief Locates multiple points. Para coords of points that are not
+  /// found are set to NaN.
+  /// @param[in] queries (n_queries, dim)
+  /// @param[in] n_queries
+  /// @param[in] newton_tolerance
+  /// @param[in] max_iterations
+  /// @param[in] n_thread
+  /// @param[out] patch_ids (n_queries)
+  /// @param[out] para_coords (n_queries, para_dim)
+  void LocateMany(const double* queries,
+                  const int n_queries,
+                  const double newton_tolerance,
+                  const int max_iterations,
+                  const int n_thread,
+                  int* patch_ids,
+                  double* para_coords) const;
+};
+
+} // namespace splinepy::proximity
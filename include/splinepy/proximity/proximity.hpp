@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include <napf.hpp>
 
 #include "splinepy/splines/splinepy_base.hpp"
@@ -35,6 +37,26 @@ public:
 
   using SystemMatrix = splinepy::utils::Matrix<double, int>;
 
+  /// @brief Optional statistics of kdtree planting and queries. Counters are
+  /// atomic, as queries are usually executed concurrently. Times are in
+  /// nanoseconds.
+  struct Statistics {
+    std::atomic<long long> n_kdtree_plantings{0};
+    std::atomic<long long> n_samples{0};
+    std::atomic<long long> sampling_time{0};
+    std::atomic<long long> kdtree_build_time{0};
+    std::atomic<long long> n_queries{0};
+    std::atomic<long long> n_iterations{0};
+    std::atomic<long long> n_max_iterations_reached{0};
+    std::atomic<long long> n_bound_hits{0};
+    std::atomic<long long> n_evaluations{0};
+    std::atomic<long long> n_derivative_evaluations{0};
+    std::atomic<long long> query_time{0};
+
+    /// @brief Sets all counters to zero
+    void Reset();
+  };
+
 protected:
   // helpee spline
   const splinepy::splines::SplinepyBase& spline_;
@@ -45,10 +67,48 @@ protected:
   std::unique_ptr<Cloud_> cloud_;
   std::unique_ptr<Tree_> kdtree_;
 
+  // statistics - only recorded if the flag is set
+  bool record_statistics_{false};
+  mutable Statistics statistics_;
+
 public:
   /// Constructor. As a spline helper class, always need a spline.
   Proximity(const splinepy::splines::SplinepyBase& spline) : spline_(spline){};
 
+  /// @brief Enables / disables recording of statistics. Should not be called
+  /// during queries.
+  void RecordStatistics(const bool record) { record_statistics_ = record; }
+
+  /// @brief Returns true if statistics are being recorded
+  bool IsRecordingStatistics() const { return record_statistics_; }
+
+  /// @brief Recorded statistics
+  const Statistics& GetStatistics() const { return statistics_; }
+
+  /// @brief Sets all statistics counters to zero
+  void ResetStatistics() { statistics_.Reset(); }
+
+  /// @brief Records statistics for the lifetime of this object and restores
+  /// the previous recording state afterwards, also if an exception is thrown.
+  class ScopedStatisticsRecording {
+  protected:
+    Proximity& proximity_;
+    const bool was_recording_;
+
+  public:
+    explicit ScopedStatisticsRecording(Proximity& proximity)
+        : proximity_(proximity),
+          was_recording_(proximity.IsRecordingStatistics()) {
+      proximity_.RecordStatistics(true);
+    }
+    ScopedStatisticsRecording(const ScopedStatisticsRecording&) = delete;
+    ScopedStatisticsRecording&
+    operator=(const ScopedStatisticsRecording&) = delete;
+    ~ScopedStatisticsRecording() {
+      proximity_.RecordStatistics(was_recording_);
+    }
+  };
+
   /*!
    * Plants a kdtree with given resolution.
    *
@@ -107,7 +167,7 @@ public:
   void FirstOrderFallBack() {}
 
   /// @brief Given physical coordinate, finds closest parametric coordinate.
-  /// Always takes initial guess based on kdtree.
+  /// Takes initial guess based on kdtree, unless warm_start is set.
   ///
   /// @param[in] query
   /// @param[in] tolerance
@@ -120,6 +180,9 @@ public:
   /// @param[out] convergence_norm
   /// @param[out] first_derivatives (para_dim x dim)
   /// @param[out] second_derivatives (para_dim x para_dim x dim)
+  /// @param[in] warm_start if true, final_guess is used as initial guess and
+  /// kdtree won't be queried
+  /// @param[out] n_iterations (optional) number of newton iterations
   void VerboseQuery(const double* query,
                     const double& tolerance,
                     const int& max_iterations,
@@ -130,7 +193,9 @@ public:
                     double& distance,
                     double& convergence_norm,
                     double* first_derivatives /* spline jacobian */,
-                    double* second_derivatives /* spline hessian */) const;
+                    double* second_derivatives /* spline hessian */,
+                    const bool warm_start = false,
+                    int* n_iterations = nullptr) const;
 };
 
 } // namespace splinepy::proximity
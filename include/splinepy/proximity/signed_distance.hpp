@@ -0,0 +1,139 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <napf.hpp>
+
+#include "splinepy/proximity/proximity.hpp"
+#include "splinepy/splines/splinepy_base.hpp"
+#include "splinepy/utils/arrays.hpp"
+#include "splinepy/utils/default_initialization_allocator.hpp"
+#include "splinepy/utils/grid_points.hpp"
+
+namespace splinepy::proximity {
+
+/*!
+ * Samples signed distance to a closed boundary on regular grids.
+ *
+ * Boundary is given as a set of splines with para_dim == dim - 1, where dim
+ * is either 2 or 3. All boundary splines are sampled once to plant a single
+ * kdtree, which provides candidate patches and initial guesses for each grid
+ * point. Grid points within a narrow band are refined with
+ * `Proximity::VerboseQuery()`, using the closest parametric coordinate of the
+ * previous grid point on the same grid line as a warm start. Sign is taken
+ * from the boundary normal at the closest point: positive in the direction of
+ * the (oriented) normal vector.
+ */
+class SignedDistance {
+public:
+  using Cloud_ = Proximity::Cloud_;
+  using Tree_ = Proximity::Tree_;
+  using RealArray_ = splinepy::utils::Array<double>;
+  using IntVector_ = splinepy::utils::DefaultInitializationVector<int>;
+  using DoubleVector_ = splinepy::utils::DefaultInitializationVector<double>;
+  using Boundaries_ =
+      std::vector<std::shared_ptr<splinepy::splines::SplinepyBase>>;
+
+protected:
+  // boundary splines and their normal orientation (+1 or -1)
+  Boundaries_ boundaries_;
+  DoubleVector_ normal_orientations_;
+
+  // one proximity helper per boundary. kdtree is not planted
+  std::vector<std::unique_ptr<Proximity>> proximities_;
+
+  // sampled boundaries and their oriented normals
+  std::vector<splinepy::utils::GridPoints> sample_grids_;
+  IntVector_ sample_offsets_;
+  IntVector_ sample_boundary_ids_;
+  RealArray_ samples_;
+  RealArray_ sample_normals_;
+
+  // global kdtree
+  std::unique_ptr<Cloud_> cloud_;
+  std::unique_ptr<Tree_> kdtree_;
+
+  int para_dim_;
+  int dim_;
+
+  /// @brief Shared implementation of dense and sparse grid sampling. Calls
+  /// `store(i_thread, grid_id, signed_distance, in_band)` for each grid point.
+  template<typename StoreFunc>
+  void SampleGridImpl(const double* grid_bounds,
+                      const int* grid_resolutions,
+                      const double band_width,
+                      const int n_candidates,
+                      const double tolerance,
+                      const int max_iterations,
+                      const int n_thread,
+                      const StoreFunc& store) const;
+
+public:
+  /// @brief Samples boundaries and plants a kdtree
+  /// @param boundaries boundary splines, all with para_dim == dim - 1
+  /// @param normal_orientations (n_boundaries) factors applied to each
+  /// boundary's normal. Use nullptr for all positive
+  /// @param sample_resolution sampling resolution per parametric dimension
+  /// @param n_thread
+  SignedDistance(const Boundaries_& boundaries,
+                 const double* normal_orientations,
+                 const int sample_resolution,
+                 const int n_thread = 1);
+
+  /// @brief Computes (not normalized) normal vector from first derivatives of
+  /// a boundary spline. For dim == 2, this is tangent rotated by -90 degrees,
+  /// for dim == 3, cross product of two tangents.
+  /// @param[in] first_derivatives (para_dim x dim)
+  /// @param[in] dim
+  /// @param[out] normal (dim)
+  static void NormalFromFirstDerivatives(const double* first_derivatives,
+                                         const int dim,
+                                         double* normal);
+
+  /// @brief Number of sampled boundary points
+  int NumberOfSamples() const { return samples_.size() / dim_; }
+
+  /// @brief Samples signed distance on a grid and writes all values.
+  /// @param grid_bounds (2 x dim) [min_0, min_1, ..., max_0, max_1, ...]
+  /// @param grid_resolutions (dim) first dimension varies fastest in output
+  /// @param band_width only grid points whose kdtree distance is below this
+  /// value are refined with newton iterations. Non-positive value refines all.
+  /// @param n_candidates number of nearest samples to collect candidate
+  /// boundaries from
+  /// @param tolerance newton tolerance
+  /// @param max_iterations newton max iterations. negative for default
+  /// @param n_thread
+  /// @param distances (prod(grid_resolutions)) output
+  void SampleGrid(const double* grid_bounds,
+                  const int* grid_resolutions,
+                  const double band_width,
+                  const int n_candidates,
+                  const double tolerance,
+                  const int max_iterations,
+                  const int n_thread,
+                  double* distances) const;
+
+  /// @brief Samples signed distance on a grid and only keeps values within
+  /// the narrow band. Output is sorted by grid id.
+  /// @param grid_bounds (2 x dim)
+  /// @param grid_resolutions (dim)
+  /// @param band_width should be positive
+  /// @param n_candidates
+  /// @param tolerance
+  /// @param max_iterations
+  /// @param n_thread
+  /// @param grid_ids output
+  /// @param distances output
+  void SampleGridSparse(const double* grid_bounds,
+                        const int* grid_resolutions,
+                        const double band_width,
+                        const int n_candidates,
+                        const double tolerance,
+                        const int max_iterations,
+                        const int n_thread,
+                        IntVector_& grid_ids,
+                        DoubleVector_& distances) const;
+};
+
+} // namespace splinepy::proximity
@@ -7,8 +7,12 @@
 #include <pybind11/pybind11.h>
 
 //
+#include "splinepy/proximity/point_location.hpp"
 #include "splinepy/py/py_spline.hpp"
+#include "splinepy/splines/homogeneous_patches.hpp"
 #include "splinepy/utils/default_initialization_allocator.hpp"
+#include "splinepy/utils/spatial_hash.hpp"
+#include "splinepy/utils/union_find.hpp"
 
 namespace splinepy::py {
 
@@ -45,12 +49,37 @@ ToCoreSplineVector(py::list pysplines,
 /// @return py::list
 py::list ToPySplineList(CoreSplineVector& splist);
 
-/*
- * Sort Vector using lambda expressions
- * https://stackoverflow.com/a/12399290
- */
-template<typename T>
-IntVector ArgSort(const std::vector<T>& v);
+/// @brief Groups query ids by their patch ids using counting sort. Within a
+/// patch, queries keep their original order.
+/// @param[in] patch_ids (n_queries)
+/// @param[in] n_queries
+/// @param[in] n_patches
+/// @param[out] offsets (n_patches + 1) queries of patch i are
+/// order[offsets[i]:offsets[i + 1]]
+/// @param[out] order (n_queries)
+void GroupQueriesByPatch(const int* patch_ids,
+                         const int n_queries,
+                         const int n_patches,
+                         IntVector& offsets,
+                         IntVector& order);
+
+/// @brief finds mismatches between specified properties and all the entries
+/// in the vector. Properties with empty / non-positive values are not checked.
+/// @param splist
+/// @param name
+/// @param para_dim
+/// @param dim
+/// @param degrees
+/// @param control_mesh_resolutions
+/// @param nthreads
+/// @return mismatch info. Empty if everything matches
+std::string FindMismatch(const CoreSplineVector& splist,
+                         const std::string name,
+                         const int para_dim,
+                         const int dim,
+                         const IntVector& degrees,
+                         const IntVector& control_mesh_resolutions,
+                         const int nthreads);
 
 /// @brief raises if there's any mismatch between specified properties and all
 /// the entries in the vector.
@@ -88,33 +117,38 @@ void RaiseMismatch(const CoreSplineVector& splist0,
                    const int nthreads);
 
 /**
- * @brief Determine the connectivity from center-vertices, assuming nothing of
- * the underlying grid
+ * @brief Connects face centers stored in a spatial hash
  *
- * Duplicate Points are not eliminated, assuming that a maximum of two points
- * are equivalent. If this is not the case an exception is thrown. In theory
- * this has complexity O(nlogn) whereas a KDTree has complexity O(n (logn)^dim).
+ * Faces in [first_query, face_centers.Size()) are matched against all faces.
+ * A face with exactly one other face within tolerance is connected to it and,
+ * if the other face was inserted before first_query, the other face is
+ * connected back, unless it is already connected, non-manifold or matched by
+ * another face. Faces without a partner keep their entry. If more than two
+ * faces coincide (non-manifold contact), all of them are set to -1 and
+ * reported instead of throwing. Expected complexity is O(n).
  *
- * @tparam PhysicalPointType Type of Point coordinates
- * @tparam ScalarType Type determining the precision
- * @tparam parametric_dimension dimension of the object (e.g. surface in 3D)
- * @tparam boolean check_orientation to check if neighboring elements match
- *                          structured grid
- * @param face_center_vertices vertices in the centers of spline-surfaces
- * @param metric used for preordering the vertices along a line
- * @param tolerance tolerance (distance between two vertices that are joined)
-
- * @return connectivity as a std::vector<std::array<...>>
+ * @param face_centers spatial hash with cell size of at least tolerance
+ * @param first_query first face id to match
+ * @param tolerance distance between two face centers to be connected
+ * @param nthreads
+ * @param interfaces (face_centers.Size()) global face ids. Entries of queried
+ * faces should be initialized with boundary ids (-1).
+ * @param non_manifold_faces sorted face ids of non-manifold contacts are
+ * appended
  */
-py::array_t<int>
-FindConnectivityFromCenters(const py::array_t<double>& face_center_vertices,
-                            const int parametric_dimension,
-                            const py::array_t<double>& metric,
-                            const double tolerance);
+void ConnectFaceCenters(const splinepy::utils::SpatialHash& face_centers,
+                        const int first_query,
+                        const double tolerance,
+                        const int nthreads,
+                        int* interfaces,
+                        IntVector& non_manifold_faces);
 
 /**
  * @brief  Determines the Connectivity of spline patches
  *
+ * Uses a spatial hash (see ConnectFaceCenters()). Non-manifold contacts are
+ * treated as boundaries and a warning is printed.
+ *
  * @param py_center_vertices  Vertices in the center of the boundaries
  * @param tolerance tolerance between two neighboring face centers for them
  * to be fused
@@ -126,6 +160,38 @@ InterfacesFromBoundaryCenters(const py::array_t<double>& py_center_vertices,
                               const double& tolerance,
                               const int& parametric_dimension);
 
+/// @brief Checks if two splines have identical basis functions, i.e., same
+/// type, degrees, knot vectors and weights. Null splines never share basis.
+/// @param a
+/// @param b
+bool SharesBasis(const std::shared_ptr<splinepy::splines::SplinepyBase>& a,
+                 const std::shared_ptr<splinepy::splines::SplinepyBase>& b);
+
+/// @brief Finds pairs of coincident control points on an interface
+///
+/// Face control points of start spline are mapped to the adjacent spline
+/// using the axis mappings of GetBoundaryOrientation(). If the mapping is not
+/// possible (non-conforming control meshes) or mapped control points do not
+/// coincide, pairs are found with a spatial hash instead.
+///
+/// @param spline_start
+/// @param boundary_start
+/// @param control_points_start (n_control_points, dim) of spline_start
+/// @param spline_end
+/// @param boundary_end
+/// @param control_points_end (n_control_points, dim) of spline_end
+/// @param tolerance distance and angle tolerance
+/// @param pairs (output) local ids (start, end) are appended
+void InterfaceControlPointPairs(
+    const std::shared_ptr<splinepy::splines::SplinepyBase>& spline_start,
+    const int boundary_start,
+    const double* control_points_start,
+    const std::shared_ptr<splinepy::splines::SplinepyBase>& spline_end,
+    const int boundary_end,
+    const double* control_points_end,
+    const double tolerance,
+    IntVector& pairs);
+
 /// @brief Orientation between two adjacent splines
 ///
 /// If two splines share the same boundary this function retrieves their
@@ -148,6 +214,62 @@ void GetBoundaryOrientation(
     int* int_mappings_ptr,
     bool* bool_orientations_ptr);
 
+/// @brief Jacobian at the center of a face
+/// @param spline
+/// @param face_id
+/// @param jacobian (output) (dim, para_dim)
+void FaceCenterJacobian(
+    const std::shared_ptr<splinepy::splines::SplinepyBase>& spline,
+    const int face_id,
+    double* jacobian);
+
+/// @brief Orientation between two adjacent splines from Jacobians at their
+/// face centers, see GetBoundaryOrientation()
+/// @param para_dim_
+/// @param dim_
+/// @param boundary_start
+/// @param jacobian_start (dim, para_dim)
+/// @param boundary_end
+/// @param jacobian_end (dim, para_dim)
+/// @param tolerance
+/// @param int_mappings_ptr (output) integer mappings
+/// @param bool_orientations_ptr (output) axis alignment
+void OrientationFromJacobians(const int para_dim_,
+                              const int dim_,
+                              const int boundary_start,
+                              const double* jacobian_start,
+                              const int boundary_end,
+                              const double* jacobian_end,
+                              const double tolerance,
+                              int* int_mappings_ptr,
+                              bool* bool_orientations_ptr);
+
+/// @brief Batched orientations of multiple connections. Jacobians are
+/// evaluated once per involved face in parallel and shared between
+/// connections.
+/// @param splines
+/// @param n_connections
+/// @param base_id_ptr (n_connections)
+/// @param base_face_id_ptr (n_connections)
+/// @param neighbor_id_ptr (n_connections)
+/// @param neighbor_face_id_ptr (n_connections)
+/// @param tolerance
+/// @param n_threads
+/// @param int_mapping_ptr (output) (n_connections, para_dim)
+/// @param bool_orientations_ptr (output) (n_connections, para_dim)
+void BoundaryOrientations(
+    const std::vector<std::shared_ptr<splinepy::splines::SplinepyBase>>&
+        splines,
+    const int n_connections,
+    const int* base_id_ptr,
+    const int* base_face_id_ptr,
+    const int* neighbor_id_ptr,
+    const int* neighbor_face_id_ptr,
+    const double tolerance,
+    const int n_threads,
+    int* int_mapping_ptr,
+    bool* bool_orientations_ptr);
+
 /// @brief Get the Boundary Orientations object
 ///
 /// @param spline_list
@@ -177,10 +299,11 @@ py::list ExtractAllBoundarySplines(const py::list& spline_list,
                                    const int& n_threads);
 
 /**
- * @brief  Adds a Boundary using a seed and G-continuity on boundary-splines
+ * @brief  Adds a Boundary using G-continuity on boundary-splines
  *
- * This function might be a slight overkill, as it assigns all functions an ID,
- * even when previously assigned a different ID -> Future Project
+ * Normals are computed once per face and adjacent boundary patches with G1
+ * continuous faces are grouped with union-find. All boundary patches get a
+ * new ID, numbered in the order of their first patch.
  *
  * @param boundary_splines boundary patches
  * @param boundary_interfaces interfaces between boundary splines
@@ -235,6 +358,23 @@ public:
   /// @brief Fields - they are saved as multi-patches
   py::list field_multipatches_;
 
+  /// face centers of the current interfaces. Kept to append patches
+  std::shared_ptr<splinepy::utils::SpatialHash> face_center_hash_ = nullptr;
+
+  /// global face ids with non-manifold contacts, found with interfaces
+  py::array_t<int> non_manifold_faces_;
+
+  /// shared basis evaluation, if all patches share the same basis. Selected
+  /// automatically at patch setting and dropped once patches change their
+  /// basis, see ValidHomogeneousPatches().
+  std::shared_ptr<splinepy::splines::HomogeneousPatches> homogeneous_patches_ =
+      nullptr;
+
+  /// cell grid and kdtrees for point location. Built on first use and kept
+  /// until patches or their control points are set
+  std::shared_ptr<const splinepy::proximity::PointLocation> point_location_ =
+      nullptr;
+
   /// default number of threads for all the operations besides queries
   int n_default_threads_{1};
 
@@ -299,6 +439,10 @@ public:
     interfaces_ = other->interfaces_;
     boundary_ids_ = other->boundary_ids_;
     field_multipatches_ = other->field_multipatches_;
+    face_center_hash_ = other->face_center_hash_;
+    non_manifold_faces_ = other->non_manifold_faces_;
+    homogeneous_patches_ = other->homogeneous_patches_;
+    point_location_ = other->point_location_;
     n_default_threads_ = other->n_default_threads_;
     same_parametric_bounds_ = other->same_parametric_bounds_;
     has_null_splines_ = other->has_null_splines_;
@@ -375,6 +519,16 @@ public:
   /// @param recompute compute even if already available
   py::array_t<int> GetInterfaces(const bool recompute = false);
 
+  /// @brief global face ids with non-manifold contacts, i.e., more than two
+  /// coinciding faces. They are treated as boundaries in interfaces
+  py::array_t<int> GetNonManifoldFaces() { return non_manifold_faces_; }
+
+  /// @brief Appends patches. If interfaces were computed, only faces of new
+  /// patches are matched and interfaces are updated incrementally.
+  /// @param patches
+  /// @param nthreads
+  void AppendPatches(py::list& patches, const int nthreads);
+
   /// @brief Gets IDs of boundary patch
   /// @param bid boundary ID to be extracted
   py::array_t<int> BoundaryPatchIds(const int bid);
@@ -388,11 +542,63 @@ public:
   /// @return
   py::object PyBoundaryMultipatch(const int bid);
 
+  /// @brief Returns homogeneous_patches_ if patches still share its basis.
+  /// Otherwise, drops it and returns nullptr.
+  /// @param nthreads
+  std::shared_ptr<splinepy::splines::HomogeneousPatches>
+  ValidHomogeneousPatches(const int nthreads);
+
+  /// @brief Returns true if all patches share the same basis, which allows
+  /// shared basis evaluation
+  bool IsHomogeneous() {
+    return ValidHomogeneousPatches(n_default_threads_) != nullptr;
+  }
+
   /// @brief Evaluate at query points
   /// @param queries Query points
   /// @param nthreads Number of threads to use
   py::array_t<double> Evaluate(py::array_t<double> queries, const int nthreads);
 
+  /// @brief Evaluates each query at its own patch
+  /// @param queries (n, para_dim)
+  /// @param patch_ids (n) patch id of each query
+  /// @param nthreads Number of threads to use
+  /// @return (n, dim)
+  py::array_t<double> EvaluatePatches(const py::array_t<double>& queries,
+                                      const py::array_t<int>& patch_ids,
+                                      const int nthreads);
+
+  /// @brief Evaluates derivatives of each query at its own patch
+  /// @param queries (n, para_dim)
+  /// @param patch_ids (n)
+  /// @param orders (para_dim) or (n_orders, para_dim)
+  /// @param nthreads
+  /// @return (n, dim) or (n, n_orders, dim)
+  py::array_t<double> DerivativePatches(const py::array_t<double>& queries,
+                                        const py::array_t<int>& patch_ids,
+                                        const py::array_t<int>& orders,
+                                        const int nthreads);
+
+  /// @brief Evaluates jacobian of each query at its own patch
+  /// @param queries (n, para_dim)
+  /// @param patch_ids (n)
+  /// @param nthreads
+  /// @return (n, dim, para_dim)
+  py::array_t<double> JacobianPatches(const py::array_t<double>& queries,
+                                      const py::array_t<int>& patch_ids,
+                                      const int nthreads);
+
+  /// @brief Evaluates basis functions and support of each query at its own
+  /// patch. Support ids are local to each patch. All involved patches should
+  /// have the same number of supports.
+  /// @param queries (n, para_dim)
+  /// @param patch_ids (n)
+  /// @param nthreads
+  /// @return (basis (n, n_support), support (n, n_support))
+  py::tuple BasisAndSupportPatches(const py::array_t<double>& queries,
+                                   const py::array_t<int>& patch_ids,
+                                   const int nthreads);
+
   /// @brief Sample multi patch
   /// @param resolution
   /// @param nthreads Number of threads to use
@@ -401,6 +607,44 @@ public:
                              const int nthreads,
                              const bool same_parametric_bounds);
 
+  /// @brief Samples each patch with its own resolutions. Samples are packed
+  /// contiguously and threads are balanced by number of samples.
+  /// @param resolutions (n_patches) or (n_patches, para_dim). At least 2
+  /// @param nthreads
+  /// @return (sampled (offsets[-1], dim), offsets (n_patches + 1))
+  py::tuple SamplePatches(const py::array_t<int>& resolutions,
+                          const int nthreads);
+
+  /// @brief Per patch sample resolutions from physical size. Length along
+  /// each parametric axis is estimated with the longest control polygon line,
+  /// which also grows with curvature.
+  /// @param spacing target distance between samples
+  /// @param min_resolution at least 2
+  /// @param max_resolution
+  /// @param nthreads
+  /// @return resolutions (n_patches, para_dim)
+  py::array_t<int> SampleResolutions(const double spacing,
+                                     const int min_resolution,
+                                     const int max_resolution,
+                                     const int nthreads);
+
+  /// @brief Samples multi patch without duplicated vertices on interfaces.
+  /// Sample points on interfaces are matched using interface orientations
+  /// and only merged if they coincide within tolerance. Only interface
+  /// samples are evaluated for matching, each unique vertex is then
+  /// evaluated once.
+  /// @param resolution
+  /// @param tolerance distance between merged samples
+  /// @param angle_tolerance cosine tolerance of interface orientations
+  /// @param nthreads
+  /// @return (vertices (n_unique, dim), connectivity (n_patches *
+  /// (resolution - 1)^para_dim, 2^para_dim)) with quads/hexahedra in VTK
+  /// ordering
+  py::tuple SampleWatertight(const int resolution,
+                             const double tolerance,
+                             const double angle_tolerance,
+                             const int nthreads);
+
   /// @brief Adds fields
   /// @param fields
   /// @param check_name
@@ -419,6 +663,19 @@ public:
   /// @brief Gets list of fields
   py::list GetFields() { return field_multipatches_; }
 
+  /// @brief Evaluates geometry and all fields at once. Basis functions of
+  /// each query are computed once with the geometry patch and contracted with
+  /// control points of the patch and of all fields that share its basis.
+  /// Remaining fields are evaluated directly and null splines yield zeros.
+  /// @param queries (n, para_dim)
+  /// @param patch_ids None to evaluate all queries at all patches, or (n) to
+  /// evaluate each query at its own patch
+  /// @param nthreads
+  /// @return list of evaluated geometry and fields
+  py::list EvaluateWithFields(const py::array_t<double>& queries,
+                              const py::object& patch_ids,
+                              const int nthreads);
+
   /// @brief Get summed number of all control points
   int GetNumberOfControlPoints();
 
@@ -427,6 +684,109 @@ public:
 
   /// @brief Create a list of all control points
   py::array_t<double> GetControlPoints();
+
+  /// @brief Global control point numbering, where coincident control points
+  /// on interfaces share the same id. Interfaces are computed if needed.
+  /// Control points are only merged across interfaces.
+  /// @param tolerance
+  /// @param nthreads
+  /// @return (local_to_global (n_control_points,), n_unique)
+  py::tuple GlobalControlPointIds(const double tolerance, const int nthreads);
+
+  /// @brief Orientations of all interfaces. Each interface appears once,
+  /// starting from the face with the lower global face id. Interfaces are
+  /// computed if needed.
+  /// @param tolerance
+  /// @param nthreads
+  /// @return (base_ids, base_face_ids, neighbor_ids, neighbor_face_ids,
+  /// axis_mappings (n, para_dim), axis_orientations (n, para_dim))
+  py::tuple InterfaceOrientations(const double tolerance, const int nthreads);
+
+  /// @brief Partitions patches using recursive bisection of the patch
+  /// adjacency graph given by interfaces. Interfaces are computed if needed.
+  /// @param n_parts
+  /// @param weights "uniform", "control_points", "elements" or (n_patches)
+  /// array of patch weights
+  /// @param renumber if true, also returns patch order that groups patches by
+  /// part and keeps neighbors close
+  /// @param nthreads
+  /// @return parts (n_patches) or (parts, order)
+  py::object Partition(const int n_parts,
+                       const py::object& weights,
+                       const bool renumber,
+                       const int nthreads);
+
+  /// @brief Global basis matrix in CSR format. Row i contains basis function
+  /// values (or derivatives) of query i at patch patch_ids[i], column ids
+  /// are stacked control point ids (see GetControlPointOffsets()) or merged
+  /// ids (see GlobalControlPointIds()).
+  /// @param queries (n, para_dim)
+  /// @param patch_ids (n)
+  /// @param orders None for basis, (para_dim) for basis derivatives
+  /// @param merge if true, uses global control point ids as columns
+  /// @param tolerance tolerance for merging
+  /// @param nthreads
+  /// @return (data, indices, indptr, n_columns)
+  py::tuple BasisMatrix(const py::array_t<double>& queries,
+                        const py::array_t<int>& patch_ids,
+                        const py::object& orders,
+                        const bool merge,
+                        const double tolerance,
+                        const int nthreads);
+
+  /// @brief Sets control points of all patches at once. Values are scattered
+  /// to each patch in parallel using control point pointers. Control points
+  /// cached on python side are updated too.
+  /// @param control_points (n_control_points, dim) stacked in patch order,
+  /// see GetControlPointOffsets()
+  /// @param nthreads
+  void SetControlPoints(const py::array_t<double>& control_points,
+                        const int nthreads);
+
+  /// @brief Samples signed distance to the boundary on a regular grid. If
+  /// para_dim == dim, boundary patches are extracted and distance is positive
+  /// outside of the multipatch. If para_dim == dim - 1, patches are taken as
+  /// boundary and sign follows their normal vectors.
+  /// @param grid_bounds (2, dim)
+  /// @param grid_resolutions (dim,) first dimension varies fastest in output
+  /// @param sample_resolution boundary sampling resolution for kdtree
+  /// @param band_width only grid points within this kdtree distance are
+  /// refined. Non-positive value refines all
+  /// @param n_candidates number of nearest samples to collect candidates from
+  /// @param tolerance
+  /// @param max_iterations
+  /// @param sparse if true, returns (grid_ids, distances) within the band
+  /// @param nthreads
+  py::object SignedDistanceField(const py::array_t<double>& grid_bounds,
+                                 const py::array_t<int>& grid_resolutions,
+                                 const int sample_resolution,
+                                 const double band_width,
+                                 const int n_candidates,
+                                 const double tolerance,
+                                 const int max_iterations,
+                                 const bool sparse,
+                                 const int nthreads);
+
+  /// @brief Locates physical points in volumetric patches (para_dim == dim).
+  /// Returns (patch_ids, para_coords). Points that are not inside of any patch
+  /// have patch id of -1 and NaN as para_coords. Points on interfaces are
+  /// assigned to the patch with the lowest id. Cell grid and kdtrees are
+  /// cached and only rebuilt if patches, sample_resolution or tolerance
+  /// change. Control points that are modified through individual patches
+  /// require patches to be set again.
+  /// @param queries (n, dim)
+  /// @param sample_resolution kdtree sampling resolution of each patch. For
+  /// non-positive values, two times control mesh resolutions are used
+  /// @param tolerance distance tolerance for inside classification
+  /// @param newton_tolerance convergence tolerance of inverse mapping
+  /// @param max_iterations
+  /// @param nthreads
+  py::tuple LocatePoints(const py::array_t<double>& queries,
+                         const int sample_resolution,
+                         const double tolerance,
+                         const double newton_tolerance,
+                         const int max_iterations,
+                         const int nthreads);
 };
 
 /// @brief ToDerived for PyMultipatches
@@ -434,4 +794,26 @@ public:
 /// @return
 py::object ToDerived(std::shared_ptr<PyMultipatch> core_obj);
 
+/// @brief Creates many splines from stacked arrays at once. Inputs are
+/// validated and cores are created in parallel, only the final python
+/// objects are created serially.
+/// @param degrees (n_splines, para_dim)
+/// @param control_points (n_control_points, dim) stacked in spline order.
+/// Each spline keeps its own copy
+/// @param knot_vectors None for Bezier types or (n_knots) stacked knots of
+/// all splines and parametric dimensions
+/// @param knot_vector_offsets (n_splines * para_dim + 1) non-decreasing,
+/// from 0 to n_knots
+/// @param weights None for non-rational types or (n_control_points)
+/// @param as_multipatch returns a Multipatch instead of a list
+/// @param nthreads
+/// @return list of splines or Multipatch
+py::object CreateMany(const py::array_t<int>& degrees,
+                      const py::array_t<double>& control_points,
+                      const py::object& knot_vectors,
+                      const py::object& knot_vector_offsets,
+                      const py::object& weights,
+                      const bool as_multipatch,
+                      const int nthreads);
+
 } // namespace splinepy::py
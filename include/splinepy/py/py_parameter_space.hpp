@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "splinepy/splines/splinepy_base.hpp"
+
+namespace splinepy::py {
+
+/// @brief Python side knot vector of a spline. It does not hold the knot
+/// vector itself, but looks it up at each access. Reads use the spline's
+/// parameter space as is, which may be shared with other splines. Writes ask
+/// the spline for its own copy first.
+class PyKnotVector {
+public:
+  using CoreSpline_ = std::shared_ptr<splinepy::splines::SplinepyBase>;
+  using KnotVector_ = bsplinelib::parameter_spaces::KnotVector;
+
+  /// @brief spline this knot vector belongs to
+  CoreSpline_ core_;
+  /// @brief parametric dimension of this knot vector
+  int p_dim_;
+
+  PyKnotVector(const CoreSpline_& core, const int p_dim)
+      : core_(core),
+        p_dim_(p_dim) {}
+
+  /// @brief Knot vector for reading
+  std::shared_ptr<const KnotVector_> Read() const {
+    return std::as_const(*core_).SplinepyKnotVector(p_dim_);
+  }
+
+  /// @brief Knot vector for writing. Call right before each write.
+  std::shared_ptr<KnotVector_> Write() const {
+    return core_->SplinepyKnotVector(p_dim_);
+  }
+};
+
+/// @brief Python side parameter space of a spline. Same access rules as
+/// PyKnotVector.
+class PyParameterSpace {
+public:
+  using CoreSpline_ = std::shared_ptr<splinepy::splines::SplinepyBase>;
+  using ParameterSpace_ = bsplinelib::parameter_spaces::ParameterSpaceBase;
+
+  /// @brief spline this parameter space belongs to
+  CoreSpline_ core_;
+
+  PyParameterSpace(const CoreSpline_& core) : core_(core) {}
+
+  /// @brief Parameter space for reading
+  std::shared_ptr<const ParameterSpace_> Read() const {
+    return std::as_const(*core_).SplinepyParameterSpace();
+  }
+
+  /// @brief Parameter space for writing. Call right before each write.
+  std::shared_ptr<ParameterSpace_> Write() const {
+    return core_->SplinepyParameterSpace();
+  }
+
+  /// @brief Knot vector of given parametric dimension
+  PyKnotVector KnotVector(const int p_dim) const { return {core_, p_dim}; }
+};
+
+} // namespace splinepy::py
@@ -4,6 +4,8 @@
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
+#include "splinepy/py/py_parameter_space.hpp"
+
 // first four are required for Create* implementations
 #include "splinepy/splines/splinepy_base.hpp"
 #include "splinepy/utils/print.hpp"
@@ -82,6 +84,9 @@ public:
   /// @brief Place to store and access from both python and cpp side.
   py::dict data_;
 
+  /// @brief True iff core views control points of data_, see NewCore
+  bool views_control_points_ = false;
+
   // ctor
   PySpline() = default;
   /// @brief Move constructor
@@ -110,16 +115,21 @@ public:
 
   /// Creates a corresponding spline based on kwargs
   /// similar to previous update_c()
-  /// Runs sanity checks on inputs
+  /// Runs sanity checks on inputs. With view_control_points=True,
+  /// non-rational beziers view control points instead of copying them.
   void NewCore(const py::kwargs& kwargs);
 
   /// will throw if c_spline_ is not initialized.
-  /// use this for runtime core calls
+  /// use this for runtime core calls. Replaces views with a templated bezier
+  /// first, as they only support queries.
   CoreSpline_& Core();
 
-  /// @brief Core spline
+  /// @brief Core spline for queries. Keeps views.
   const CoreSpline_& Core() const;
 
+  /// @brief Templated bezier with current properties of a view
+  CoreSpline_ MaterializedCore() const;
+
   /// @brief What am I?
   std::string WhatAmI() const { return Core()->SplinepyWhatAmI(); }
   /// @brief Get spline name
@@ -139,21 +149,25 @@ public:
   /// similar to update_p
   py::dict CurrentCoreProperties() const;
 
+  /// @brief Returns new PySpline with a copy of the core spline. Copies of
+  /// (rational) bsplines share parameter space and coordinates with the
+  /// original until one of them writes, see SplinepyDeepCopy().
+  std::shared_ptr<PySpline> CopyCore() const;
+
   /// Returns coordinate pointers in a tuple. For rational splines,
   /// This will return control_point_pointers and weight_pointers
   /// For non-rational splines, only the former.
   py::tuple CoordinatePointers();
 
   /// @brief Returns ParameterSpace meant to be
-  /// called library internally to prepare @property
+  /// called library internally to prepare @property. Only writes through it
+  /// stop sharing the parameter space with other splines.
   /// @return
-  std::shared_ptr<bsplinelib::parameter_spaces::ParameterSpaceBase>
-  ParameterSpace();
+  PyParameterSpace ParameterSpace();
 
   /// Returns knot vector of given dimension. meant to be
   /// called library internally to prepare @property
-  std::shared_ptr<bsplinelib::parameter_spaces::KnotVector>
-  KnotVector(const int para_dim);
+  PyKnotVector KnotVector(const int para_dim);
 
   /// AABB of spline parametric space
   py::array_t<double> ParametricBounds() const;
@@ -210,13 +224,15 @@ public:
                                       py::array_t<int> orders,
                                       int nthreads) const;
 
-  /// Proximity query (verbose)
+  /// Proximity query (verbose). If return_statistics is set, proximity
+  /// statistics of this call are appended as a dict.
   py::tuple Proximities(py::array_t<double> queries,
                         py::array_t<int> initial_guess_sample_resolutions,
                         double tolerance,
                         int max_iterations,
                         bool aggresive_search_bounds,
-                        int nthreads);
+                        int nthreads,
+                        bool return_statistics = false);
 
   /// (multiple) Degree elevation
   void ElevateDegrees(py::array_t<int> para_dims);
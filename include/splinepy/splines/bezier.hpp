@@ -8,6 +8,7 @@
 #include <bezman/src/point.hpp>
 
 #include "splinepy/proximity/proximity.hpp"
+#include "splinepy/splines/helpers/fixed_degree_kernels.hpp"
 #include "splinepy/splines/splinepy_base.hpp"
 
 namespace splinepy::splines {
@@ -50,6 +51,12 @@ public:
   using Derivative_ = typename std::array<std::size_t, para_dim>;
   using Dimension_ = std::size_t;
   using Proximity_ = splinepy::proximity::Proximity;
+  /// @brief Compile-time degree kernels. Looked up per call, as degrees can
+  /// change in place.
+  using FixedDegreeKernels_ =
+      splinepy::splines::helpers::FixedDegreeBezierKernels<para_dim,
+                                                           dim,
+                                                           Coordinate_>;
 
   /// @brief Creates Base for Bezier
   /// @param degrees
@@ -251,6 +258,9 @@ public:
   /// @brief Gets proximity
   constexpr const Proximity_& GetProximity() const { return *proximity_; }
 
+  /// @brief Gets proximity through base interface
+  virtual Proximity_* SplinepyProximity() { return proximity_.get(); }
+
   /// Deep copy of current spline
   virtual std::shared_ptr<SplinepyBase> SplinepyDeepCopy() const {
     return std::make_shared<Bezier>(*this);
@@ -5,6 +5,7 @@
 
 #include "splinepy/splines/helpers/basis_functions.hpp"
 #include "splinepy/splines/helpers/extract.hpp"
+#include "splinepy/splines/helpers/fixed_degree_kernels.hpp"
 #include "splinepy/splines/helpers/properties.hpp"
 #include "splinepy/splines/helpers/scalar_type_wrapper.hpp"
 #include "splinepy/utils/print.hpp"
@@ -153,6 +154,10 @@ void Bezier<para_dim, dim>::SplinepyGrevilleAbscissae(
 template<std::size_t para_dim, std::size_t dim>
 void Bezier<para_dim, dim>::SplinepyEvaluate(const double* para_coord,
                                              double* evaluated) const {
+  if (const auto kernels = FixedDegreeKernels_::Find(Base_::GetDegrees())) {
+    kernels.evaluate(para_coord, Base_::control_points.data(), evaluated);
+    return;
+  }
   splinepy::splines::helpers::ScalarTypeEvaluate(*this, para_coord, evaluated);
 }
 
@@ -160,6 +165,13 @@ template<std::size_t para_dim, std::size_t dim>
 void Bezier<para_dim, dim>::SplinepyDerivative(const double* para_coord,
                                                const int* orders,
                                                double* derived) const {
+  if (const auto kernels = FixedDegreeKernels_::Find(Base_::GetDegrees())) {
+    kernels.derivative(para_coord,
+                       orders,
+                       Base_::control_points.data(),
+                       derived);
+    return;
+  }
   splinepy::splines::helpers::ScalarTypeDerivative(*this,
                                                    para_coord,
                                                    orders,
@@ -213,6 +225,10 @@ void Bezier<para_dim, dim>::SplinepyElevateDegree(const int& p_dim) {
 template<std::size_t para_dim, std::size_t dim>
 void Bezier<para_dim, dim>::SplinepyBasis(const double* para_coord,
                                           double* basis) const {
+  if (const auto kernels = FixedDegreeKernels_::Find(Base_::GetDegrees())) {
+    kernels.basis(para_coord, basis);
+    return;
+  }
   splinepy::splines::helpers::BezierBasis(*this, para_coord, basis);
 }
 
@@ -220,6 +236,10 @@ template<std::size_t para_dim, std::size_t dim>
 void Bezier<para_dim, dim>::SplinepyBasisDerivative(const double* para_coord,
                                                     const int* order,
                                                     double* basis_der) const {
+  if (const auto kernels = FixedDegreeKernels_::Find(Base_::GetDegrees())) {
+    kernels.basis_derivative(para_coord, order, basis_der);
+    return;
+  }
   splinepy::splines::helpers::BezierBasisDerivative(*this,
                                                     para_coord,
                                                     order,
@@ -6,6 +6,7 @@
 #include "splinepy/proximity/proximity.hpp"
 #include "splinepy/splines/helpers/basis_functions.hpp"
 #include "splinepy/splines/helpers/extract.hpp"
+#include "splinepy/splines/helpers/parameter_space_cache.hpp"
 #include "splinepy/splines/helpers/properties.hpp"
 #include "splinepy/splines/helpers/scalar_type_wrapper.hpp"
 #include "splinepy/splines/splinepy_base.hpp"
@@ -91,49 +92,67 @@ public:
   using BinomialRatio_ = typename BinomialRatios_::value_type;
   // Advanced use
   using Proximity_ = splinepy::proximity::Proximity;
+  using ParameterSpaceCache_ =
+      splinepy::splines::helpers::ParameterSpaceCache<ParameterSpace_>;
+  /// @brief Compile-time degree kernels. Looked up per call, as degrees can
+  /// change in place.
+  using FixedDegreeKernels_ =
+      splinepy::splines::helpers::FixedDegreeBSplineKernels<para_dim,
+                                                           false>;
 
   /** raw ptr based inithelper.
    *  degrees should have same size as parametric dimension
    *  having knot_vectors vector of vector, we can keep track of their length,
    * as well as the length of control_points/weights.
+   *  With intern_parameter_space, identical parameter spaces are shared, see
+   * splinepy::splines::helpers::ParameterSpaceCache.
    */
   static Base_ CreateBase(const int* degrees,
                           const std::vector<std::vector<double>>& knot_vectors,
                           double* control_points,
-                          const int dim) {
+                          const int dim,
+                          const bool intern_parameter_space = false) {
     // process all the info and turn them into SplineLib types to initialize
     // Base_.
 
     // Prepare temporary containers
-    Degrees_ sl_degrees;          // std::array
-    Knots_ sl_knots;              // std::vector
-    KnotVectors_ sl_knot_vectors; // std::array
     Coordinates_ sl_control_points;
     int ncps{1};
-
-    // Formulate degrees and knotvectors
     for (int i{}; i < kParaDim; ++i) {
-      // degrees
-      sl_degrees[i] = Degree_(degrees[i]);
-      // knot vectors
-      const auto& knot_vector = knot_vectors[i];
-      const int nkv = knot_vector.size();
-      sl_knots.clear();
-      sl_knots.reserve(nkv);
-      // try if this works after namedtype ext
-      // sl_knots = knot_vector;
-      for (int j{}; j < nkv; ++j) {
-        sl_knots.emplace_back(Knot_{knot_vector[j]});
-      }
-      std::shared_ptr sl_knot_vector{std::make_shared<KnotVector_>(sl_knots)};
-      sl_knot_vectors[i] = sl_knot_vector;
-
-      ncps *= nkv - degrees[i] - 1;
+      ncps *= static_cast<int>(knot_vectors[i].size()) - degrees[i] - 1;
     }
 
-    // Formulate ParameterSpace
+    // Formulate degrees, knotvectors and ParameterSpace
+    auto create_parameter_space = [&]() {
+      Degrees_ sl_degrees;          // std::array
+      Knots_ sl_knots;              // std::vector
+      KnotVectors_ sl_knot_vectors; // std::array
+      for (int i{}; i < kParaDim; ++i) {
+        // degrees
+        sl_degrees[i] = Degree_(degrees[i]);
+        // knot vectors
+        const auto& knot_vector = knot_vectors[i];
+        const int nkv = knot_vector.size();
+        sl_knots.clear();
+        sl_knots.reserve(nkv);
+        // try if this works after namedtype ext
+        // sl_knots = knot_vector;
+        for (int j{}; j < nkv; ++j) {
+          sl_knots.emplace_back(Knot_{knot_vector[j]});
+        }
+        std::shared_ptr sl_knot_vector{
+            std::make_shared<KnotVector_>(sl_knots)};
+        sl_knot_vectors[i] = sl_knot_vector;
+      }
+      return std::make_shared<ParameterSpace_>(sl_knot_vectors, sl_degrees);
+    };
     auto sl_parameter_space =
-        std::make_shared<ParameterSpace_>(sl_knot_vectors, sl_degrees);
+        (intern_parameter_space)
+            ? ParameterSpaceCache_::Instance().Intern(kParaDim,
+                                                      degrees,
+                                                      knot_vectors,
+                                                      create_parameter_space)
+            : create_parameter_space();
 
     // Formulate control_points - this will be a view. make sure to keep the
     // pointer alive
@@ -151,15 +170,68 @@ public:
   /// @param degrees
   /// @param knot_vectors
   /// @param control_points
+  /// @param dim
+  /// @param intern_parameter_space shares parameter space with identical
+  /// splines. Defaults to the global switch.
   BSpline(const int* degrees,
           const std::vector<std::vector<double>>& knot_vectors,
           double* control_points,
-          const int dim)
-      : Base_(CreateBase(degrees, knot_vectors, control_points, dim)) {}
+          const int dim,
+          const bool intern_parameter_space =
+              splinepy::splines::helpers::ParameterSpaceInterningEnabled())
+      : Base_(CreateBase(degrees,
+                         knot_vectors,
+                         control_points,
+                         dim,
+                         intern_parameter_space)) {
+    shared_parameter_space_ = intern_parameter_space;
+    // coordinates are a view on control_points
+    external_coordinates_ = true;
+  }
 
-  /// @brief copy ctor casts
+  /// @brief copy ctor. Copy-on-write: parameter space and coordinates are
+  /// shared with other until one of them modifies them. Spaces that may be
+  /// written from outside, i.e., handed out or viewed, are copied right away.
   /// @param other
-  BSpline(const BSpline& other) : Base_(static_cast<const Base_&>(other)) {}
+  BSpline(const BSpline& other)
+      : Base_(other.ParameterSpaceForCopy(), other.VectorSpaceForCopy()) {
+    shared_parameter_space_ = !other.external_parameter_space_;
+    shared_vector_space_ = !other.external_coordinates_;
+  }
+
+  /// @brief Selects the deep copy ctor
+  struct DeepCopyTag_ {};
+
+  /// @brief deep copy ctor. Copies parameter space and coordinates right
+  /// away, e.g., for a working copy that is modified next. Unlike the copy
+  /// ctor, other's spaces are not marked as shared.
+  /// @param other
+  BSpline(const BSpline& other, DeepCopyTag_)
+      : Base_(std::make_shared<ParameterSpace_>(
+                  *other.Base_::Base_::parameter_space_),
+              std::make_shared<VectorSpace_>(*other.Base_::vector_space_)) {}
+
+  /// @brief Replaces a parameter space that may be shared with other splines
+  /// with an own copy. Call before modifying the parameter space.
+  void DetachParameterSpace() {
+    if (!shared_parameter_space_) {
+      return;
+    }
+    Base_::Base_::parameter_space_ =
+        std::make_shared<ParameterSpace_>(*Base_::Base_::parameter_space_);
+    shared_parameter_space_ = false;
+  }
+
+  /// @brief Replaces coordinates that may be shared with other splines with
+  /// an own copy. Call before modifying coordinates.
+  void DetachVectorSpace() {
+    if (!shared_vector_space_) {
+      return;
+    }
+    Base_::vector_space_ =
+        std::make_shared<VectorSpace_>(*Base_::vector_space_);
+    shared_vector_space_ = false;
+  }
 
   /// Inherited constructor
   using Base_::Base_;
@@ -256,11 +328,32 @@ public:
 
   virtual std::shared_ptr<bsplinelib::parameter_spaces::ParameterSpaceBase>
   SplinepyParameterSpace() {
+    // may be written to
+    DetachParameterSpace();
+    external_parameter_space_ = true;
+    return Base_::Base_::parameter_space_;
+  };
+
+  virtual std::shared_ptr<
+      const bsplinelib::parameter_spaces::ParameterSpaceBase>
+  SplinepyParameterSpace() const {
     return Base_::Base_::parameter_space_;
   };
 
   virtual std::shared_ptr<bsplinelib::parameter_spaces::KnotVector>
   SplinepyKnotVector(const int p_dim) {
+    if (!(p_dim < para_dim)) {
+      splinepy::utils::PrintAndThrowError(
+          "Invalid parametric dimension. Should be smaller than",
+          para_dim);
+    }
+    DetachParameterSpace();
+    external_parameter_space_ = true;
+    return Base_::Base_::parameter_space_->GetKnotVectors()[p_dim];
+  };
+
+  virtual std::shared_ptr<const bsplinelib::parameter_spaces::KnotVector>
+  SplinepyKnotVector(const int p_dim) const {
     if (!(p_dim < para_dim)) {
       splinepy::utils::PrintAndThrowError(
           "Invalid parametric dimension. Should be smaller than",
@@ -276,6 +369,10 @@ public:
         && SplinepyBase_::control_point_pointers_->Len() == ncps) {
       return SplinepyBase_::control_point_pointers_;
     }
+    // pointers may write anytime
+    DetachVectorSpace();
+    external_coordinates_ = true;
+
     auto cpp = std::make_shared<ControlPointPointers_>();
     cpp->dim_ = Base_::Dim();
     cpp->coordinate_begins_.reserve(ncps);
@@ -326,14 +423,41 @@ public:
                                                      duplicate_tolerance);
   }
 
+  /// @brief Evaluates with compile-time degree kernels, if there are any
+  /// for current degrees.
+  /// @param orders nullptr for evaluation
+  /// @return false if caller should use the generic path
+  bool FixedDegreeEvaluate(const double* para_coord,
+                           const int* orders,
+                           double* evaluated) const {
+    const auto& parameter_space = GetParameterSpace();
+    const auto kernels =
+        FixedDegreeKernels_::Find(parameter_space.GetDegrees());
+    if (!kernels) {
+      return false;
+    }
+    kernels.evaluate(
+        splinepy::splines::helpers::FindKnotSpans(*this, para_coord),
+        para_coord,
+        orders,
+        &GetCoordinates()(0, 0),
+        Base_::Dim(),
+        evaluated);
+    return true;
+  }
+
   virtual void SplinepyEvaluate(const double* para_coord,
                                 double* evaluated) const {
-    Base_::Evaluate(para_coord, evaluated);
+    if (!FixedDegreeEvaluate(para_coord, nullptr, evaluated)) {
+      Base_::Evaluate(para_coord, evaluated);
+    }
   }
   virtual void SplinepyDerivative(const double* para_coord,
                                   const int* orders,
                                   double* derived) const {
-    Base_::EvaluateDerivative(para_coord, orders, derived);
+    if (!FixedDegreeEvaluate(para_coord, orders, derived)) {
+      Base_::EvaluateDerivative(para_coord, orders, derived);
+    }
   }
 
   virtual void SplinepyJacobian(const double* para_coord,
@@ -364,9 +488,10 @@ public:
   virtual void SplinepyBasisAndSupport(const double* para_coord,
                                        double* basis,
                                        int* support) const {
-
-    SplinepyBasis(para_coord, basis);
-    SplinepySupport(para_coord, support);
+    splinepy::splines::helpers::BSplineBasisAndSupport(*this,
+                                                       para_coord,
+                                                       basis,
+                                                       support);
   }
 
   /// Basis Function Derivative and their support IDs
@@ -374,8 +499,11 @@ public:
                                                  const int* orders,
                                                  double* basis_der,
                                                  int* support) const {
-    SplinepyBasisDerivative(para_coord, orders, basis_der);
-    SplinepySupport(para_coord, support);
+    splinepy::splines::helpers::BSplineBasisDerivativeAndSupport(*this,
+                                                                 para_coord,
+                                                                 orders,
+                                                                 basis_der,
+                                                                 support);
   }
 
   virtual void SplinepyPlantNewKdTreeForProximity(const int* resolutions,
@@ -409,22 +537,30 @@ public:
   }
 
   virtual void SplinepyElevateDegree(const int& p_dim) {
+    DetachParameterSpace();
+    DetachVectorSpace();
     splinepy::splines::helpers::ScalarTypeElevateDegree(*this, p_dim);
   }
 
   virtual bool SplinepyReduceDegree(const int& p_dim, const double& tolerance) {
+    DetachParameterSpace();
+    DetachVectorSpace();
     return splinepy::splines::helpers::ScalarTypeReduceDegree(*this,
                                                               p_dim,
                                                               tolerance);
   }
 
   virtual bool SplinepyInsertKnot(const int& p_dim, const double& knot) {
+    DetachParameterSpace();
+    DetachVectorSpace();
     return splinepy::splines::helpers::ScalarTypeInsertKnot(*this, p_dim, knot);
   }
 
   virtual bool SplinepyRemoveKnot(const int& p_dim,
                                   const double& knot,
                                   const double& tolerance) {
+    DetachParameterSpace();
+    DetachVectorSpace();
     return splinepy::splines::helpers::ScalarTypeRemoveKnot(*this,
                                                             p_dim,
                                                             knot,
@@ -462,6 +598,9 @@ public:
   /// @brief Gets proximity
   constexpr const Proximity_& GetProximity() const { return *proximity_; }
 
+  /// @brief Gets proximity through base interface
+  virtual Proximity_* SplinepyProximity() { return proximity_.get(); }
+
   /// Deep copy of current spline
   virtual std::shared_ptr<SplinepyBase> SplinepyDeepCopy() const {
     return std::make_shared<BSpline>(*this);
@@ -470,6 +609,34 @@ public:
 protected:
   /// @brief Unique pointer to proximity
   std::unique_ptr<Proximity_> proximity_ = std::make_unique<Proximity_>(*this);
+  /// @brief Parameter space may be shared with other splines, either from
+  /// ParameterSpaceCache_ or with copies. Mutable, as copying shares it.
+  mutable bool shared_parameter_space_{false};
+  /// @brief Coordinates may be shared with copies
+  mutable bool shared_vector_space_{false};
+  /// @brief Parameter space was handed out and may be written to anytime
+  bool external_parameter_space_{false};
+  /// @brief Coordinates are a view or pointers to them were handed out
+  bool external_coordinates_{false};
+
+  /// @brief Parameter space for a copy of this spline
+  std::shared_ptr<ParameterSpace_> ParameterSpaceForCopy() const {
+    if (external_parameter_space_) {
+      return std::make_shared<ParameterSpace_>(
+          *Base_::Base_::parameter_space_);
+    }
+    shared_parameter_space_ = true;
+    return Base_::Base_::parameter_space_;
+  }
+
+  /// @brief Vector space for a copy of this spline
+  std::shared_ptr<VectorSpace_> VectorSpaceForCopy() const {
+    if (external_coordinates_) {
+      return std::make_shared<VectorSpace_>(*Base_::vector_space_);
+    }
+    shared_vector_space_ = true;
+    return Base_::vector_space_;
+  }
 };
 
 } /* namespace splinepy::splines */
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <splinepy/splines/splinepy_base.hpp>
+
+#if defined(_WIN32)
+#define SPLINEPY_MORE_EXPORT __declspec(dllexport)
+#else
+#define SPLINEPY_MORE_EXPORT __attribute__((visibility("default")))
+#endif
+
+namespace splinepy::splines::create {
+
+/// @brief Factories of splines with parametric dimension in [4, 10].
+///
+/// With SPLINEPY_LAZY_MORE, these instantiations are compiled into a
+/// separate shared library, which is loaded on first use of a high
+/// dimensional spline. This keeps them out of import time and resident
+/// memory of processes that never need them.
+struct MoreFactories {
+  using CreateBezier_ =
+      std::shared_ptr<SplinepyBase> (*)(const int para_dim,
+                                        const int dim,
+                                        const int* degrees,
+                                        const double* control_points);
+  using CreateRationalBezier_ =
+      std::shared_ptr<SplinepyBase> (*)(const int para_dim,
+                                        const int dim,
+                                        const int* degrees,
+                                        const double* control_points,
+                                        const double* weights);
+  using CreateBSpline_ = std::shared_ptr<SplinepyBase> (*)(
+      const int para_dim,
+      const int dim,
+      const int* degrees,
+      const std::vector<std::vector<double>>* knot_vectors,
+      double* control_points);
+  using CreateNurbs_ = std::shared_ptr<SplinepyBase> (*)(
+      const int para_dim,
+      const int dim,
+      const int* degrees,
+      const std::vector<std::vector<double>>* knot_vectors,
+      double* control_points,
+      double* weights);
+
+  CreateBezier_ bezier{};
+  CreateRationalBezier_ rational_bezier{};
+  CreateBSpline_ bspline{};
+  CreateNurbs_ nurbs{};
+};
+
+/// @brief Name of the entry point of the shared library
+constexpr const char* kMoreFactoriesSymbol = "SplinepyMoreFactories";
+
+/// @brief Loads the shared library with high dimensional splines once and
+/// returns its factories. The library is searched next to the module that
+/// contains splinepy, or at the path given by environment variable
+/// SPLINEPY_MORE_LIBRARY.
+/// @return nullptr if library is not available
+const MoreFactories* LoadMoreFactories();
+
+} // namespace splinepy::splines::create
+
+/// @brief Entry point of the shared library
+extern "C" SPLINEPY_MORE_EXPORT const splinepy::splines::create::MoreFactories*
+SplinepyMoreFactories();
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "splinepy/splines/splinepy_base.hpp"
+#include "splinepy/utils/default_initialization_allocator.hpp"
+
+namespace splinepy::splines {
+
+/*!
+ * Spline with parametric and physical dimension known only at runtime.
+ *
+ * Fallback for (para_dim, dim) combinations without template
+ * instantiations. Covers all four spline types: beziers are represented with
+ * open knot vectors without interior knots, which gives Bernstein basis and
+ * a support of all control points. Like BSplineLib, rational splines save
+ * weighted control points with weight as last entry, so that coordinate
+ * pointers behave the same as for templated splines.
+ *
+ * Copies are copy-on-write: they share knot vectors and control points until
+ * a copy requests coordinate pointers, which are the only way to write.
+ * Non-rational beziers can also view caller-owned control points, see the
+ * view ctor. Copies of views own their control points.
+ *
+ * Queries (evaluation, derivatives, basis and support), properties and
+ * boundary extraction are implemented. Modifications like knot insertion and
+ * degree elevation as well as proximity are not and throw.
+ */
+class DynamicSpline : public splinepy::splines::SplinepyBase {
+public:
+  using IntVector_ = splinepy::utils::DefaultInitializationVector<int>;
+  using DoubleVector_ = splinepy::utils::DefaultInitializationVector<double>;
+
+protected:
+  int para_dim_;
+  int dim_;
+  bool is_rational_;
+  bool has_knot_vectors_;
+  IntVector_ degrees_;
+  // never modified after construction and shared between copies
+  std::shared_ptr<const std::vector<std::vector<double>>> knot_vectors_;
+  // (n_control_points, dim + is_rational), weighted if rational. Shared
+  // between copies until one of them hands out writable pointers
+  std::shared_ptr<DoubleVector_> control_points_;
+  // caller-owned control points of views. control_points_ is unused then
+  double* viewed_control_points_ = nullptr;
+  IntVector_ control_mesh_resolutions_;
+
+  /// @brief Number of values per control point
+  int Stride() const { return dim_ + static_cast<int>(is_rational_); }
+
+  /// @brief Control points for reading
+  const double* ControlPoints() const;
+
+  /// @brief Control points for writing. Copies the buffer first, if it is
+  /// shared with other splines.
+  double* MutableControlPoints();
+
+  /// @brief Knot span index that contains para_coord in given direction
+  int Span(const int i_para_dim, const double para_coord) const;
+
+  /// @brief Non-zero basis function derivatives up to order in one direction
+  /// on the span of para_coord, see BSplineBasis1D().
+  /// @param[in] i_para_dim
+  /// @param[in] para_coord
+  /// @param[in] order
+  /// @param[out] derivatives ((order + 1), degree + 1)
+  void BasisDerivatives1D(const int i_para_dim,
+                          const double para_coord,
+                          const int order,
+                          DoubleVector_& derivatives) const;
+
+  /// @brief Non-rational tensor product basis derivatives for all orders in
+  /// [0, orders]. Derivatives of sub-order k are at k's linear index with
+  /// first parametric dimension fastest.
+  /// @param[in] para_coord
+  /// @param[in] orders
+  /// @param[out] derivatives (prod(orders + 1), n_supports)
+  /// @param[out] support (n_supports), skipped if nullptr
+  void TensorBasisDerivatives(const double* para_coord,
+                              const int* orders,
+                              DoubleVector_& derivatives,
+                              int* support) const;
+
+public:
+  /// @brief ctor. Creates bezier types if knot_vectors is nullptr and
+  /// rational types if weights are given.
+  /// @param para_dim
+  /// @param dim
+  /// @param degrees (para_dim)
+  /// @param knot_vectors (para_dim, n_knots), can be nullptr
+  /// @param control_points (n_control_points, dim), nullptr only for views
+  /// @param weights (n_control_points), can be nullptr
+  DynamicSpline(const int para_dim,
+                const int dim,
+                const int* degrees,
+                const std::vector<std::vector<double>>* knot_vectors,
+                const double* control_points,
+                const double* weights);
+
+  /// @brief View ctor for non-rational beziers. Control points are neither
+  /// copied nor owned and have to outlive this spline. Coordinate pointers
+  /// write to them.
+  /// @param para_dim
+  /// @param dim
+  /// @param degrees (para_dim)
+  /// @param control_points (n_control_points, dim)
+  DynamicSpline(const int para_dim,
+                const int dim,
+                const int* degrees,
+                double* control_points);
+
+  /// @brief Copy ctor. Shares buffers with other, unless other has handed
+  /// out coordinate pointers, which may write to them anytime, or is a view.
+  /// Coordinate pointers are not shared with copies.
+  DynamicSpline(const DynamicSpline& other);
+
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyParaDim
+  virtual int SplinepyParaDim() const { return para_dim_; }
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyDim
+  virtual int SplinepyDim() const { return dim_; }
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepySplineName
+  virtual std::string SplinepySplineName() const;
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyWhatAmI
+  virtual std::string SplinepyWhatAmI() const;
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyHasKnotVectors
+  virtual bool SplinepyHasKnotVectors() const { return has_knot_vectors_; }
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyIsRational
+  virtual bool SplinepyIsRational() const { return is_rational_; }
+  /// @brief Returns true iff control points are caller-owned
+  bool IsView() const { return viewed_control_points_ != nullptr; }
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyNumberOfControlPoints
+  virtual int SplinepyNumberOfControlPoints() const;
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyNumberOfSupports
+  virtual int SplinepyNumberOfSupports() const;
+
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyCurrentProperties
+  virtual void
+  SplinepyCurrentProperties(int* degrees,
+                            std::vector<std::vector<double>>* knot_vectors,
+                            double* control_points,
+                            double* weights) const;
+
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyControlPointPointers
+  virtual std::shared_ptr<ControlPointPointers_> SplinepyControlPointPointers();
+  /// @copydoc
+  /// splinepy::splines::SplinepyBase::SplinepyWeightedControlPointPointers
+  virtual std::shared_ptr<WeightedControlPointPointers_>
+  SplinepyWeightedControlPointPointers();
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyWeightPointers
+  virtual std::shared_ptr<WeightPointers_> SplinepyWeightPointers();
+
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyParametricBounds
+  virtual void SplinepyParametricBounds(double* para_bounds) const;
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyControlMeshResolutions
+  virtual void SplinepyControlMeshResolutions(int* control_mesh_res) const;
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyGrevilleAbscissae
+  virtual void
+  SplinepyGrevilleAbscissae(double* greville_abscissae,
+                            const int& i_para_dim,
+                            const double& duplicate_tolerance) const;
+
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyEvaluate
+  virtual void SplinepyEvaluate(const double* para_coord,
+                                double* evaluated) const;
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyDerivative
+  virtual void SplinepyDerivative(const double* para_coord,
+                                  const int* orders,
+                                  double* derived) const;
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyJacobian
+  virtual void SplinepyJacobian(const double* para_coord,
+                                double* jacobians) const;
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyBasis
+  virtual void SplinepyBasis(const double* para_coord, double* basis) const;
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyBasisDerivative
+  virtual void SplinepyBasisDerivative(const double* para_coord,
+                                       const int* order,
+                                       double* basis_der) const;
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepySupport
+  virtual void SplinepySupport(const double* para_coord, int* support) const;
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyBasisAndSupport
+  virtual void SplinepyBasisAndSupport(const double* para_coord,
+                                       double* basis,
+                                       int* support) const;
+  /// @copydoc
+  /// splinepy::splines::SplinepyBase::SplinepyBasisDerivativeAndSupport
+  virtual void SplinepyBasisDerivativeAndSupport(const double* para_coord,
+                                                 const int* orders,
+                                                 double* basis_der,
+                                                 int* support) const;
+
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyKnotMultiplicities
+  virtual std::vector<std::vector<int>> SplinepyKnotMultiplicities() const;
+
+  /// @brief Boundary spline as DynamicSpline with one less parametric
+  /// dimension. Like the templated splines, this takes the control mesh slice
+  /// and therefore assumes open knot vectors.
+  /// @param boundary_id 2 * axis for lower and 2 * axis + 1 for upper bound
+  virtual std::shared_ptr<SplinepyBase>
+  SplinepyExtractBoundary(const int& boundary_id);
+
+  /// @copydoc splinepy::splines::SplinepyBase::SplinepyDeepCopy
+  virtual std::shared_ptr<SplinepyBase> SplinepyDeepCopy() const;
+};
+
+} // namespace splinepy::splines
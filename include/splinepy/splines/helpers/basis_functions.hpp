@@ -1,10 +1,17 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <numeric>
+#include <type_traits>
+#include <vector>
 
 #include <BSplineLib/ParameterSpaces/parameter_space.hpp>
 #include <BSplineLib/Utilities/math_operations.hpp>
 
+#include "splinepy/splines/helpers/fixed_degree_kernels.hpp"
+#include "splinepy/utils/scratch_arena.hpp"
+
 namespace splinepy::splines::helpers {
 
 /// Bezier basis - scalar io here
@@ -70,6 +77,215 @@ constexpr inline void BezierSupport(const SplineType& spline,
   std::iota(support, &support[spline.SplinepyNumberOfSupports()], 0);
 }
 
+/// Index of knot span that contains u, i.e., knots[span] <= u <
+/// knots[span + 1]. Queries on the last knot belong to the last span and
+/// queries outside the valid range are clamped to it.
+inline int FindKnotSpan(const double* knots,
+                        const int n_knots,
+                        const int degree,
+                        const double u) {
+  const int last_span = n_knots - degree - 2;
+  if (u >= knots[last_span + 1]) {
+    return last_span;
+  }
+  if (u <= knots[degree]) {
+    return degree;
+  }
+  return static_cast<int>(
+             std::upper_bound(knots + degree, knots + last_span + 1, u)
+             - knots)
+         - 1;
+}
+
+/// Knot spans of para_coord for fixed degree kernels
+template<typename SplineType, typename QueryType>
+inline KnotSpans<SplineType::kParaDim>
+FindKnotSpans(const SplineType& spline, const QueryType* para_coord) {
+  static_assert(SplineType::kHasKnotVectors,
+                "FindKnotSpans is only for bspline families.");
+  const auto& parameter_space = spline.GetParameterSpace();
+  const auto& degrees = parameter_space.GetDegrees();
+  const auto& knot_vectors = parameter_space.GetKnotVectors();
+
+  KnotSpans<SplineType::kParaDim> spans;
+  for (std::size_t i{}; i < SplineType::kParaDim; ++i) {
+    const auto& knots = knot_vectors[i]->GetKnots();
+    const int n_knots = static_cast<int>(knots.size());
+    const int degree = static_cast<int>(degrees[i]);
+    spans.knots[i] = knots.data();
+    spans.spans[i] = FindKnotSpan(knots.data(),
+                                  n_knots,
+                                  degree,
+                                  static_cast<double>(para_coord[i]));
+    spans.control_mesh_resolutions[i] = n_knots - degree - 1;
+  }
+  return spans;
+}
+
+/// Number of doubles BSplineBasis1D() needs as work buffer
+constexpr int BSplineBasis1DWorkSize(const int degree) {
+  return (degree + 1) * (degree + 5);
+}
+
+/// 1D B-spline basis or its derivative of given order, following
+/// algorithm A2.3 of "The NURBS Book". Writes degree + 1 non-zero values into
+/// values. work needs BSplineBasis1DWorkSize(degree) entries.
+inline void BSplineBasis1D(const double* knots,
+                           const int n_knots,
+                           const int degree,
+                           const double u,
+                           const int order,
+                           double* values,
+                           double* work) {
+  const int n = degree + 1;
+  if (order > degree) {
+    std::fill_n(values, n, 0.);
+    return;
+  }
+
+  // ndu(j, r) stores basis values in upper and knot differences in lower
+  // triangle
+  double* ndu = work;
+  double* left = ndu + n * n;
+  double* right = left + n;
+  double* a = right + n;
+  auto ndu_ = [&](const int j, const int r) -> double& {
+    return ndu[j * n + r];
+  };
+
+  const int span = FindKnotSpan(knots, n_knots, degree, u);
+  ndu_(0, 0) = 1.;
+  for (int j{1}; j <= degree; ++j) {
+    left[j] = u - knots[span + 1 - j];
+    right[j] = knots[span + j] - u;
+    double saved{};
+    for (int r{}; r < j; ++r) {
+      ndu_(j, r) = right[r + 1] + left[j - r];
+      const double temp = ndu_(r, j - 1) / ndu_(j, r);
+      ndu_(r, j) = saved + right[r + 1] * temp;
+      saved = left[j - r] * temp;
+    }
+    ndu_(j, j) = saved;
+  }
+
+  if (order == 0) {
+    for (int j{}; j < n; ++j) {
+      values[j] = ndu_(j, degree);
+    }
+    return;
+  }
+
+  // two alternating rows of coefficients
+  double factor{1.};
+  for (int k{degree}; k > degree - order; --k) {
+    factor *= k;
+  }
+  for (int r{}; r < n; ++r) {
+    double* a_prev = a;
+    double* a_next = a + n;
+    a_prev[0] = 1.;
+    double d{};
+    for (int k{1}; k <= order; ++k) {
+      d = 0.;
+      const int rk = r - k;
+      const int pk = degree - k;
+      if (r >= k) {
+        a_next[0] = a_prev[0] / ndu_(pk + 1, rk);
+        d = a_next[0] * ndu_(rk, pk);
+      }
+      const int j1 = (rk >= -1) ? 1 : -rk;
+      const int j2 = (r - 1 <= pk) ? k - 1 : degree - r;
+      for (int j{j1}; j <= j2; ++j) {
+        a_next[j] = (a_prev[j] - a_prev[j - 1]) / ndu_(pk + 1, rk + j);
+        d += a_next[j] * ndu_(rk + j, pk);
+      }
+      if (r <= pk) {
+        a_next[k] = -a_prev[k - 1] / ndu_(pk + 1, r);
+        d += a_next[k] * ndu_(r, pk);
+      }
+      std::swap(a_prev, a_next);
+    }
+    values[r] = d * factor;
+  }
+}
+
+/// Tensor product B-spline basis or its derivative. Order may be nullptr for
+/// basis values. 1D values are evaluated into the scratch arena. First
+/// parametric dimension runs fastest, same as support.
+template<typename SplineType,
+         typename QueryType,
+         typename OrderType,
+         typename BasisType>
+inline void TensorProductBSplineBasis(const SplineType& spline,
+                                      const QueryType* para_coord,
+                                      const OrderType* order,
+                                      BasisType* basis) {
+  static_assert(SplineType::kHasKnotVectors,
+                "BSplineBasis is only for bspline families.");
+  constexpr int para_dim = SplineType::kParaDim;
+
+  const auto& parameter_space = spline.GetParameterSpace();
+  const auto& degrees = parameter_space.GetDegrees();
+  const auto& knot_vectors = parameter_space.GetKnotVectors();
+
+  if constexpr (std::is_same_v<QueryType, double>
+                && std::is_same_v<BasisType, double>
+                && std::is_same_v<OrderType, int>) {
+    using Kernels = FixedDegreeBSplineKernels<para_dim, false>;
+    if (const auto kernels = Kernels::Find(degrees)) {
+      kernels.basis(FindKnotSpans(spline, para_coord),
+                    para_coord,
+                    order,
+                    basis);
+      return;
+    }
+  }
+
+  // 1D values back to back, followed by work space
+  std::array<int, para_dim> n_values{};
+  std::array<int, para_dim> offsets{};
+  int n_total_values{}, n_work{}, n_total_basis{1};
+  for (int i{}; i < para_dim; ++i) {
+    const int degree = static_cast<int>(degrees[i]);
+    n_values[i] = degree + 1;
+    offsets[i] = n_total_values;
+    n_total_values += n_values[i];
+    n_work = std::max(n_work, BSplineBasis1DWorkSize(degree));
+    n_total_basis *= n_values[i];
+  }
+  splinepy::utils::ScratchScope scratch;
+  double* values = scratch.Allocate<double>(n_total_values + n_work);
+  double* work = values + n_total_values;
+
+  for (int i{}; i < para_dim; ++i) {
+    const auto& knots = knot_vectors[i]->GetKnots();
+    BSplineBasis1D(knots.data(),
+                   static_cast<int>(knots.size()),
+                   static_cast<int>(degrees[i]),
+                   static_cast<double>(para_coord[i]),
+                   (order) ? static_cast<int>(order[i]) : 0,
+                   values + offsets[i],
+                   work);
+  }
+
+  std::array<int, para_dim> ids{};
+  for (int i{}; i < n_total_basis; ++i) {
+    double value{1.};
+    for (int j{}; j < para_dim; ++j) {
+      value *= values[offsets[j] + ids[j]];
+    }
+    basis[i] = static_cast<BasisType>(value);
+
+    // increment multi index
+    for (int j{}; j < para_dim; ++j) {
+      if (++ids[j] < n_values[j]) {
+        break;
+      }
+      ids[j] = 0;
+    }
+  }
+}
+
 /// BSpline Basis functions per dimension
 template<typename SplineType, typename QueryType, typename ContainerType>
 constexpr inline std::array<ContainerType, SplineType::kParaDim>
@@ -85,10 +301,12 @@ BSplineBasisPerParametricDimension(const SplineType& spline,
   return parameter_space.EvaluateBasisValuesPerDimension(para_coord);
 }
 
-/// BSpline Basis support
-template<typename SplineType, typename QueryType>
-inline std::vector<int> BSplineSupport(const SplineType& spline,
-                                       const QueryType* para_coord) {
+/// BSpline Basis support. Writes directly into out_support, which should
+/// have space for spline.SplinepyNumberOfSupports() entries.
+template<typename SplineType, typename QueryType, typename SupportType>
+inline void BSplineSupport(const SplineType& spline,
+                           const QueryType* para_coord,
+                           SupportType* out_support) {
   static_assert(SplineType::kHasKnotVectors,
                 "BSplineBasis is only for bspline families.");
 
@@ -105,82 +323,79 @@ inline std::vector<int> BSplineSupport(const SplineType& spline,
                       typename decltype(n_basis_per_dim)::value_type{1},
                       std::multiplies{});
 
-  // prepare return
-  std::vector<int> supports;
-  supports.reserve(n_total_basis);
-
   // fill supports.
   for (int i{}; i < n_total_basis; ++i) {
-    supports.push_back(
+    out_support[i] = static_cast<SupportType>(
         (support_start + support_offset.GetIndex()).GetIndex1d());
     ++support_offset;
   }
-  return supports;
 }
 
-template<typename SplineType, typename QueryType, typename SupportType>
-inline void BSplineSupport(const SplineType& spline,
-                           const QueryType* para_coord,
-                           SupportType* out_support) {
-  const auto support = BSplineSupport(spline, para_coord);
-  std::copy(support.begin(), support.end(), out_support);
+/// BSpline Basis support as vector. Allocates - prefer the overload with
+/// output buffer in loops.
+template<typename SplineType, typename QueryType>
+inline std::vector<int> BSplineSupport(const SplineType& spline,
+                                       const QueryType* para_coord) {
+  std::vector<int> supports(spline.SplinepyNumberOfSupports());
+  BSplineSupport(spline, para_coord, supports.data());
+  return supports;
 }
 
 /// pure bspline basis. We recommend using BSplineBasis() instead of this
-template<typename SplineType, typename QueryType>
-constexpr inline auto NonRationalBSplineBasis(const SplineType& spline,
-                                              const QueryType* para_coord) {
-
-  static_assert(SplineType::kHasKnotVectors,
-                "BSplineBasis is only for bspline families.");
-
-  // prepare unique evals
-  const auto& parameter_space = spline.GetParameterSpace();
-
-  return parameter_space.EvaluateBasisValues(para_coord);
+template<typename SplineType, typename QueryType, typename BasisType>
+inline void NonRationalBSplineBasis(const SplineType& spline,
+                                    const QueryType* para_coord,
+                                    BasisType* basis) {
+  TensorProductBSplineBasis(spline,
+                            para_coord,
+                            static_cast<const int*>(nullptr),
+                            basis);
 }
 
-/// nurbs basis. We recommend using BSplineBasis() instead of this
-template<typename SplineType, typename QueryType, typename SupportType>
-constexpr inline std::vector<QueryType>
-RationalBSplineBasis(const SplineType& spline,
-                     const QueryType* para_coord,
-                     const SupportType& support) {
+/// nurbs basis with known support. Writes directly into rational_basis,
+/// which should have the size of support. We recommend using BSplineBasis()
+/// or BSplineBasisAndSupport() instead of this
+template<typename SplineType,
+         typename QueryType,
+         typename SupportType,
+         typename BasisType>
+inline void RationalBSplineBasis(const SplineType& spline,
+                                 const QueryType* para_coord,
+                                 const SupportType* support,
+                                 BasisType* rational_basis) {
   static_assert(SplineType::kIsRational && SplineType::kHasKnotVectors,
                 "RationalBSplineBasis is only applicable to NURBS.");
-  const auto bspline_basis = NonRationalBSplineBasis(spline, para_coord);
+  NonRationalBSplineBasis(spline, para_coord, rational_basis);
   const auto& homogeneous_coords = spline.GetCoordinates();
-  const auto n_basis = support.size();
+  const int n_basis = spline.SplinepyNumberOfSupports();
   const int dim = spline.SplinepyDim();
-  // prepare output
-  std::vector<QueryType> rational_basis;
-  rational_basis.reserve(n_basis);
 
   double W{0.};
-  for (std::size_t i{}; i < n_basis; ++i) {
+  for (int i{}; i < n_basis; ++i) {
     // get weight
     const auto& w = homogeneous_coords(support[i], dim);
-    const auto N_times_w = bspline_basis[i] * w;
+    const auto N_times_w = rational_basis[i] * w;
 
     W += N_times_w;
-    rational_basis.push_back(N_times_w);
+    rational_basis[i] = N_times_w;
   }
 
   const auto W_inv = 1 / W;
-  for (auto& rb : rational_basis) {
-    rb *= W_inv;
+  for (int i{}; i < n_basis; ++i) {
+    rational_basis[i] *= W_inv;
   }
-
-  return rational_basis;
 }
 
-/// nurbs basis. We recommend using BSplineBasis() instead of this
-template<typename SplineType, typename QueryType>
-constexpr inline std::vector<QueryType>
-RationalBSplineBasis(const SplineType& spline, const QueryType* para_coord) {
-  return RationalBSplineBasis(spline,
-                              para_coord,
-                              BSplineSupport(spline, para_coord));
+/// nurbs basis. Support is computed into the scratch arena. We recommend
+/// using BSplineBasis() instead of this
+template<typename SplineType, typename QueryType, typename BasisType>
+inline void RationalBSplineBasis(const SplineType& spline,
+                                 const QueryType* para_coord,
+                                 BasisType* rational_basis) {
+  splinepy::utils::ScratchScope scratch;
+  int* support = scratch.Allocate<int>(spline.SplinepyNumberOfSupports());
+  BSplineSupport(spline, para_coord, support);
+  RationalBSplineBasis(spline, para_coord, support, rational_basis);
 }
 
 /// BSpline Basis functions
@@ -190,11 +405,27 @@ constexpr inline void BSplineBasis(const SplineType& spline,
                                    BasisType* basis) {
 
   if constexpr (SplineType::kIsRational) {
-    const auto r_basis = RationalBSplineBasis(spline, para_coord);
-    std::copy(r_basis.begin(), r_basis.end(), basis);
+    RationalBSplineBasis(spline, para_coord, basis);
+  } else {
+    NonRationalBSplineBasis(spline, para_coord, basis);
+  }
+}
+
+/// BSpline Basis functions and their support. For NURBS, support is only
+/// computed once.
+template<typename SplineType,
+         typename QueryType,
+         typename BasisType,
+         typename SupportType>
+constexpr inline void BSplineBasisAndSupport(const SplineType& spline,
+                                             const QueryType* para_coord,
+                                             BasisType* basis,
+                                             SupportType* support) {
+  BSplineSupport(spline, para_coord, support);
+  if constexpr (SplineType::kIsRational) {
+    RationalBSplineBasis(spline, para_coord, support, basis);
   } else {
-    const auto nr_basis = NonRationalBSplineBasis(spline, para_coord);
-    std::copy(nr_basis.begin(), nr_basis.end(), basis);
+    NonRationalBSplineBasis(spline, para_coord, basis);
   }
 }
 
@@ -215,27 +446,30 @@ BSplineBasisDerivativePerParametricDimension(const SplineType& spline,
 }
 
 /// BSpline Basis functions der
-template<typename SplineType, typename QueryType, typename OrderType>
-inline bsplinelib::parameter_spaces::BasisValues
-NonRationalBSplineBasisDerivative(const SplineType& spline,
-                                  const QueryType* para_coord,
-                                  const OrderType* order) {
-  static_assert(SplineType::kHasKnotVectors,
-                "BSplineBasisDerivative is only for bspline families.");
-  // prepare unique eval buckets
-  const auto& parameter_space = spline.GetParameterSpace();
-
-  return parameter_space.EvaluateBasisDerivativeValues(para_coord, order);
+template<typename SplineType,
+         typename QueryType,
+         typename OrderType,
+         typename BasisType>
+inline void NonRationalBSplineBasisDerivative(const SplineType& spline,
+                                              const QueryType* para_coord,
+                                              const OrderType* order,
+                                              BasisType* basis_der) {
+  TensorProductBSplineBasis(spline, para_coord, order, basis_der);
 }
 
-/// adapted from bezman
-template<typename SplineType, typename QueryType, typename OrderType>
-inline bsplinelib::parameter_spaces::BasisValues
-RationalBSplineBasisDerivative(const SplineType& spline,
-                               const QueryType* para_coord,
-                               const OrderType* order) {
-  using BasisValues = bsplinelib::parameter_spaces::BasisValues;
-
+/// adapted from bezman. Intermediate derivatives are kept in a thread local
+/// buffer, which only grows.
+/// @param supports support of para_coord, see BSplineSupport()
+template<typename SplineType,
+         typename QueryType,
+         typename OrderType,
+         typename SupportType,
+         typename BasisType>
+inline void RationalBSplineBasisDerivative(const SplineType& spline,
+                                           const QueryType* para_coord,
+                                           const OrderType* order,
+                                           const SupportType* supports,
+                                           BasisType* basis_der) {
   // we will do everything with OrderType
   constexpr auto para_dim = static_cast<OrderType>(SplineType::kParaDim);
 
@@ -287,25 +521,30 @@ RationalBSplineBasisDerivative(const SplineType& spline,
     return false;
   };
 
-  // Prepare supports
-  const auto supports = BSplineSupport(spline, para_coord);
-  // Initialize return type
+  // Initialize buffers. i_deriv-th derivative starts at i_deriv * n_basis
   const OrderType number_of_derivs{global_ids_(order) + 1};
   const OrderType n_basis_functions{spline.SplinepyNumberOfSupports()};
+  const int n_values = number_of_derivs * n_basis_functions;
+  splinepy::utils::ScratchScope scratch;
   // Please remember that the first derivative is not used
-  std::vector<BasisValues> derivatives(number_of_derivs);
-  std::vector<BasisValues> A_derivatives(number_of_derivs);
-  BasisValues w_derivatives(number_of_derivs);
-  w_derivatives.Fill(0.);
+  double* derivatives_begin =
+      scratch.Allocate<double>(2 * n_values + number_of_derivs);
+  double* A_derivatives_begin = derivatives_begin + n_values;
+  double* w_derivatives = A_derivatives_begin + n_values;
+  std::fill_n(w_derivatives, number_of_derivs, 0.);
+  auto derivatives = [&](const OrderType i_deriv) {
+    return derivatives_begin + i_deriv * n_basis_functions;
+  };
 
   // Fill all polynomial spline derivatives (and values for id=0)
   for (OrderType i_deriv{}; i_deriv < number_of_derivs; ++i_deriv) {
     const auto req_derivs = local_ids_(i_deriv);
-    auto& A_derivatives_i = A_derivatives[i_deriv];
-    A_derivatives_i =
-        std::move(NonRationalBSplineBasisDerivative(spline,
-                                                    para_coord,
-                                                    req_derivs.data()));
+    double* A_derivatives_i =
+        A_derivatives_begin + i_deriv * n_basis_functions;
+    NonRationalBSplineBasisDerivative(spline,
+                                      para_coord,
+                                      req_derivs.data(),
+                                      A_derivatives_i);
     auto& w_derivatives_i = w_derivatives[i_deriv];
     for (OrderType i_basis{}; i_basis < n_basis_functions; ++i_basis) {
       const QueryType weight = homogeneous_coords(supports[i_basis], dim);
@@ -323,7 +562,9 @@ RationalBSplineBasisDerivative(const SplineType& spline,
     // Retrieve index-wise order of the derivative for current ID
     const auto derivative_order_indexwise_LHS = local_ids_(i_deriv);
     // Assign derivative of Numerator-function
-    derivatives[i_deriv].OwnCopy(A_derivatives[i_deriv]);
+    std::copy_n(A_derivatives_begin + i_deriv * n_basis_functions,
+                n_basis_functions,
+                derivatives(i_deriv));
     // Subtract all weighted lower-order functions
     for (OrderType j_deriv{1}; j_deriv <= i_deriv; ++j_deriv) {
       // Retrieve order of current index
@@ -344,19 +585,41 @@ RationalBSplineBasisDerivative(const SplineType& spline,
       }
       const QueryType binom = static_cast<QueryType>(binom_fact);
       // Subtract low-order function
+      const double* lower = derivatives(i_deriv - j_deriv);
+      double* current = derivatives(i_deriv);
       for (OrderType i_basis{}; i_basis < n_basis_functions; ++i_basis) {
-        derivatives[i_deriv][i_basis] -=
-            binom * w_derivatives[j_deriv]
-            * derivatives[i_deriv - j_deriv][i_basis];
+        current[i_basis] -= binom * w_derivatives[j_deriv] * lower[i_basis];
       }
     }
     // Finalize
+    double* current = derivatives(i_deriv);
     for (OrderType i_basis{}; i_basis < n_basis_functions; ++i_basis) {
-      derivatives[i_deriv][i_basis] *= inv_w_fact;
+      current[i_basis] *= inv_w_fact;
     }
   }
-  // Return last value - this version needs an explicit move call to move.
-  return std::move(derivatives[number_of_derivs - 1]);
+  // Copy last value
+  std::copy_n(derivatives(number_of_derivs - 1),
+              n_basis_functions,
+              basis_der);
+}
+
+/// Support is computed into the scratch arena.
+template<typename SplineType,
+         typename QueryType,
+         typename OrderType,
+         typename BasisType>
+inline void RationalBSplineBasisDerivative(const SplineType& spline,
+                                           const QueryType* para_coord,
+                                           const OrderType* order,
+                                           BasisType* basis_der) {
+  splinepy::utils::ScratchScope scratch;
+  int* supports = scratch.Allocate<int>(spline.SplinepyNumberOfSupports());
+  BSplineSupport(spline, para_coord, supports);
+  RationalBSplineBasisDerivative(spline,
+                                 para_coord,
+                                 order,
+                                 supports,
+                                 basis_der);
 }
 
 template<typename SplineType,
@@ -368,16 +631,34 @@ constexpr inline void BSplineBasisDerivative(const SplineType& spline,
                                              const OrderType* order,
                                              BasisType* basis_der) {
   if constexpr (SplineType::kIsRational) {
-    const auto r_basis =
-        RationalBSplineBasisDerivative(spline, para_coord, order);
-    std::copy(r_basis.begin(), r_basis.end(), basis_der);
+    RationalBSplineBasisDerivative(spline, para_coord, order, basis_der);
   } else {
-    const auto nr_basis =
-        NonRationalBSplineBasisDerivative(spline, para_coord, order);
-    std::copy(nr_basis.begin(), nr_basis.end(), basis_der);
+    NonRationalBSplineBasisDerivative(spline, para_coord, order, basis_der);
   }
 }
 
-/// Nurbs Basis Functions der
+/// BSpline Basis function derivatives and their support. For NURBS, support
+/// is only computed once.
+template<typename SplineType,
+         typename QueryType,
+         typename OrderType,
+         typename BasisType,
+         typename SupportType>
+inline void BSplineBasisDerivativeAndSupport(const SplineType& spline,
+                                             const QueryType* para_coord,
+                                             const OrderType* order,
+                                             BasisType* basis_der,
+                                             SupportType* support) {
+  BSplineSupport(spline, para_coord, support);
+  if constexpr (SplineType::kIsRational) {
+    RationalBSplineBasisDerivative(spline,
+                                   para_coord,
+                                   order,
+                                   support,
+                                   basis_der);
+  } else {
+    NonRationalBSplineBasisDerivative(spline, para_coord, order, basis_der);
+  }
+}
 
 } // namespace splinepy::splines::helpers
@@ -8,6 +8,7 @@
 #include "splinepy/utils/arrays.hpp"
 #include "splinepy/utils/grid_points.hpp"
 #include "splinepy/utils/print.hpp"
+#include "splinepy/utils/scratch_arena.hpp"
 
 namespace splinepy::splines::helpers {
 
@@ -207,9 +208,9 @@ std::vector<std::shared_ptr<splinepy::splines::SplinepyBase>>
 ExtractBezierPatches(const SplineType& spline) {
   static_assert(SplineType::kHasKnotVectors,
                 "Invalid type for ExtractBezierPatches");
-  // make copy of input spline
-  auto input_ptr = spline.SplinepyDeepCopy();
-  SplineType& input = *(std::dynamic_pointer_cast<SplineType>(input_ptr));
+  // make own copy of input spline, as knots are inserted below. spline's
+  // spaces stay unshared
+  SplineType input(spline, typename SplineType::DeepCopyTag_{});
 
   // Start by identifying types
   constexpr int para_dim = SplineType::kParaDim;
@@ -264,12 +265,12 @@ ExtractBezierPatches(const SplineType& spline) {
   const auto& bspline_cps = input.GetCoordinates();
 
   // prepare temporary space to copy control point values
-  splinepy::utils::Array<double, 2> extracted_cps(n_ctps_per_patch, dim);
-  splinepy::utils::Array<double> extracted_weights;
-  double* extracted_weights_data{nullptr};
+  splinepy::utils::ScratchScope scratch;
+  splinepy::utils::Array<double, 2> extracted_cps =
+      scratch.MakeArray<double>(n_ctps_per_patch, dim);
+  double* extracted_weights{nullptr};
   if constexpr (is_rational) {
-    extracted_weights.Reallocate(n_ctps_per_patch);
-    extracted_weights_data = extracted_weights.data();
+    extracted_weights = scratch.Allocate<double>(n_ctps_per_patch);
   }
 
   // Loop over the individual patches
@@ -311,7 +312,7 @@ ExtractBezierPatches(const SplineType& spline) {
         degrees.data(),
         nullptr,
         extracted_cps.data(),
-        extracted_weights_data));
+        extracted_weights));
   }
 
   return bezier_list;
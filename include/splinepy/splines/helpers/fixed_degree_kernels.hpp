@@ -0,0 +1,587 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace splinepy::splines::helpers {
+
+/// @brief Highest degree with a compile-time kernel
+constexpr int kMaxFixedDegree = 3;
+/// @brief Highest parametric dimension with a compile-time kernel
+constexpr std::size_t kMaxFixedParaDim = 3;
+
+/// @brief Switch to compare fixed degree kernels against the generic path.
+/// Enabled by default. Defined in splinepy, so that separately loaded
+/// libraries share it.
+std::atomic<bool>& FixedDegreeKernelsEnabled();
+
+/// @brief Degree of compile-time kernels for given degrees. Kernels exist
+/// for equal degrees up to kMaxFixedDegree and para_dim up to
+/// kMaxFixedParaDim.
+/// @param degrees (para_dim)
+/// @return -1 if there's no kernel or kernels are disabled
+template<std::size_t para_dim, typename DegreesType>
+inline int FixedDegree(const DegreesType& degrees) {
+  if (para_dim > kMaxFixedParaDim
+      || !FixedDegreeKernelsEnabled().load(std::memory_order_relaxed)) {
+    return -1;
+  }
+  const int degree = static_cast<int>(degrees[0]);
+  if (degree > kMaxFixedDegree) {
+    return -1;
+  }
+  for (std::size_t i{1}; i < para_dim; ++i) {
+    if (static_cast<int>(degrees[i]) != degree) {
+      return -1;
+    }
+  }
+  return degree;
+}
+
+/// @brief Number of supports of a bezier with degree in all directions
+template<std::size_t para_dim, int degree>
+constexpr int FixedDegreeNumberOfSupports() {
+  int n{1};
+  for (std::size_t i{}; i < para_dim; ++i) {
+    n *= degree + 1;
+  }
+  return n;
+}
+
+/// @brief Bernstein basis of given degree with triangular recurrence. Loops
+/// have compile-time bounds and are expected to be unrolled.
+/// @param[in] t
+/// @param[out] values (degree + 1)
+template<int degree>
+inline void BernsteinBasis(const double t, double* values) {
+  const double one_minus_t = 1. - t;
+  values[0] = 1.;
+  for (int j{1}; j <= degree; ++j) {
+    double saved{};
+    for (int r{}; r < j; ++r) {
+      const double tmp = values[r];
+      values[r] = saved + one_minus_t * tmp;
+      saved = t * tmp;
+    }
+    values[j] = saved;
+  }
+}
+
+/// @brief Derivative of Bernstein basis, using
+/// d/dt B_{i,p} = p (B_{i-1,p-1} - B_{i,p-1}). Orders larger than degree give
+/// zeros.
+/// @param[in] t
+/// @param[in] order
+/// @param[out] values (degree + 1)
+template<int degree>
+inline void BernsteinBasisDerivative(const double t,
+                                     const int order,
+                                     double* values) {
+  if (order == 0) {
+    BernsteinBasis<degree>(t, values);
+    return;
+  }
+  if constexpr (degree == 0) {
+    values[0] = 0.;
+  } else {
+    BernsteinBasisDerivative<degree - 1>(t, order - 1, values);
+    values[degree] = degree * values[degree - 1];
+    for (int i{degree - 1}; i > 0; --i) {
+      values[i] = degree * (values[i - 1] - values[i]);
+    }
+    values[0] *= -degree;
+  }
+}
+
+/// @brief Tensor product of 1D values. First parametric dimension runs
+/// fastest, same as control points.
+template<std::size_t para_dim, int degree>
+inline void FixedDegreeTensorProduct(
+    const std::array<std::array<double, degree + 1>, para_dim>& values,
+    double* basis) {
+  constexpr int n = degree + 1;
+  static_assert(para_dim > 0 && para_dim <= kMaxFixedParaDim,
+                "No fixed degree kernel for this parametric dimension.");
+
+  if constexpr (para_dim == 1) {
+    for (int i{}; i < n; ++i) {
+      basis[i] = values[0][i];
+    }
+  } else if constexpr (para_dim == 2) {
+    for (int j{}; j < n; ++j) {
+      for (int i{}; i < n; ++i) {
+        basis[j * n + i] = values[0][i] * values[1][j];
+      }
+    }
+  } else {
+    for (int k{}; k < n; ++k) {
+      for (int j{}; j < n; ++j) {
+        const double jk = values[1][j] * values[2][k];
+        for (int i{}; i < n; ++i) {
+          basis[(k * n + j) * n + i] = values[0][i] * jk;
+        }
+      }
+    }
+  }
+}
+
+/// @brief Bezier basis with compile-time degree
+/// @param[in] para_coord (para_dim)
+/// @param[out] basis ((degree + 1)^para_dim)
+template<std::size_t para_dim, int degree>
+inline void FixedDegreeBezierBasis(const double* para_coord, double* basis) {
+  std::array<std::array<double, degree + 1>, para_dim> values;
+  for (std::size_t i{}; i < para_dim; ++i) {
+    BernsteinBasis<degree>(para_coord[i], values[i].data());
+  }
+  FixedDegreeTensorProduct<para_dim, degree>(values, basis);
+}
+
+/// @brief Bezier basis derivative with compile-time degree
+/// @param[in] para_coord (para_dim)
+/// @param[in] orders (para_dim)
+/// @param[out] basis_der ((degree + 1)^para_dim)
+template<std::size_t para_dim, int degree>
+inline void FixedDegreeBezierBasisDerivative(const double* para_coord,
+                                             const int* orders,
+                                             double* basis_der) {
+  std::array<std::array<double, degree + 1>, para_dim> values;
+  for (std::size_t i{}; i < para_dim; ++i) {
+    BernsteinBasisDerivative<degree>(para_coord[i],
+                                     orders[i],
+                                     values[i].data());
+  }
+  FixedDegreeTensorProduct<para_dim, degree>(values, basis_der);
+}
+
+/// @brief Contracts basis with control points. Coordinate is either a
+/// scalar or indexable with dim entries.
+template<std::size_t dim, int n_supports, typename CoordinateType>
+inline void FixedSupportContract(const double* basis,
+                                 const CoordinateType* control_points,
+                                 double* output) {
+  std::array<double, dim> sum{};
+  for (int i{}; i < n_supports; ++i) {
+    if constexpr (dim > 1) {
+      for (std::size_t j{}; j < dim; ++j) {
+        sum[j] += basis[i] * control_points[i][j];
+      }
+    } else {
+      sum[0] += basis[i] * control_points[i];
+    }
+  }
+  for (std::size_t j{}; j < dim; ++j) {
+    output[j] = sum[j];
+  }
+}
+
+/// @brief Bezier evaluation with compile-time degree
+template<std::size_t para_dim,
+         std::size_t dim,
+         int degree,
+         typename CoordinateType>
+inline void FixedDegreeBezierEvaluate(const double* para_coord,
+                                      const CoordinateType* control_points,
+                                      double* evaluated) {
+  constexpr int n_supports = FixedDegreeNumberOfSupports<para_dim, degree>();
+  std::array<double, n_supports> basis;
+  FixedDegreeBezierBasis<para_dim, degree>(para_coord, basis.data());
+  FixedSupportContract<dim, n_supports>(basis.data(),
+                                        control_points,
+                                        evaluated);
+}
+
+/// @brief Bezier derivative with compile-time degree
+template<std::size_t para_dim,
+         std::size_t dim,
+         int degree,
+         typename CoordinateType>
+inline void FixedDegreeBezierDerivative(const double* para_coord,
+                                        const int* orders,
+                                        const CoordinateType* control_points,
+                                        double* derived) {
+  constexpr int n_supports = FixedDegreeNumberOfSupports<para_dim, degree>();
+  std::array<double, n_supports> basis_der;
+  FixedDegreeBezierBasisDerivative<para_dim, degree>(para_coord,
+                                                     orders,
+                                                     basis_der.data());
+  FixedSupportContract<dim, n_supports>(basis_der.data(),
+                                        control_points,
+                                        derived);
+}
+
+/// @brief Registry of compile-time degree kernels for a (para_dim, dim)
+/// bezier. Kernels exist for equal degrees up to kMaxFixedDegree and
+/// para_dim up to kMaxFixedParaDim. Find() returns empty kernels otherwise,
+/// which means that caller should use the generic path.
+template<std::size_t para_dim, std::size_t dim, typename CoordinateType>
+struct FixedDegreeBezierKernels {
+  using Basis_ = void (*)(const double*, double*);
+  using BasisDerivative_ = void (*)(const double*, const int*, double*);
+  using Evaluate_ = void (*)(const double*, const CoordinateType*, double*);
+  using Derivative_ = void (*)(const double*,
+                               const int*,
+                               const CoordinateType*,
+                               double*);
+
+  Basis_ basis{};
+  BasisDerivative_ basis_derivative{};
+  Evaluate_ evaluate{};
+  Derivative_ derivative{};
+
+  /// @brief True iff kernels exist
+  explicit operator bool() const { return basis != nullptr; }
+
+  /// @brief Kernels of given degree
+  template<int degree>
+  static constexpr FixedDegreeBezierKernels Make() {
+    return {&FixedDegreeBezierBasis<para_dim, degree>,
+            &FixedDegreeBezierBasisDerivative<para_dim, degree>,
+            &FixedDegreeBezierEvaluate<para_dim, dim, degree, CoordinateType>,
+            &FixedDegreeBezierDerivative<para_dim,
+                                         dim,
+                                         degree,
+                                         CoordinateType>};
+  }
+
+  /// @brief Looks up kernels for degrees. This is a table lookup and cheap
+  /// enough to be called per query.
+  /// @param degrees (para_dim)
+  template<typename DegreesType>
+  static FixedDegreeBezierKernels Find(const DegreesType& degrees) {
+    if constexpr (para_dim > kMaxFixedParaDim) {
+      return {};
+    } else {
+      static constexpr std::array<FixedDegreeBezierKernels,
+                                  kMaxFixedDegree + 1>
+          kTable{Make<0>(), Make<1>(), Make<2>(), Make<3>()};
+
+      const int degree = FixedDegree<para_dim>(degrees);
+      return (degree < 0) ? FixedDegreeBezierKernels{} : kTable[degree];
+    }
+  }
+};
+
+/// @brief Rational bezier basis with compile-time degree
+/// @param[in] para_coord (para_dim)
+/// @param[in] weights (n_supports)
+/// @param[out] basis ((degree + 1)^para_dim)
+template<std::size_t para_dim, int degree>
+inline void FixedDegreeRationalBezierBasis(const double* para_coord,
+                                           const double* weights,
+                                           double* basis) {
+  constexpr int n_supports = FixedDegreeNumberOfSupports<para_dim, degree>();
+  FixedDegreeBezierBasis<para_dim, degree>(para_coord, basis);
+  double weight_sum{};
+  for (int i{}; i < n_supports; ++i) {
+    basis[i] *= weights[i];
+    weight_sum += basis[i];
+  }
+  const double inv_weight_sum = 1. / weight_sum;
+  for (int i{}; i < n_supports; ++i) {
+    basis[i] *= inv_weight_sum;
+  }
+}
+
+/// @brief Rational bezier evaluation with compile-time degree
+/// @param[in] para_coord (para_dim)
+/// @param[in] weighted_control_points (n_supports)
+/// @param[in] weights (n_supports)
+/// @param[out] evaluated (dim)
+template<std::size_t para_dim,
+         std::size_t dim,
+         int degree,
+         typename CoordinateType>
+inline void
+FixedDegreeRationalBezierEvaluate(const double* para_coord,
+                                  const CoordinateType* weighted_control_points,
+                                  const double* weights,
+                                  double* evaluated) {
+  constexpr int n_supports = FixedDegreeNumberOfSupports<para_dim, degree>();
+  std::array<double, n_supports> basis;
+  FixedDegreeBezierBasis<para_dim, degree>(para_coord, basis.data());
+  double weight_sum{};
+  for (int i{}; i < n_supports; ++i) {
+    weight_sum += basis[i] * weights[i];
+  }
+  FixedSupportContract<dim, n_supports>(basis.data(),
+                                        weighted_control_points,
+                                        evaluated);
+  const double inv_weight_sum = 1. / weight_sum;
+  for (std::size_t j{}; j < dim; ++j) {
+    evaluated[j] *= inv_weight_sum;
+  }
+}
+
+/// @brief Registry of compile-time degree kernels for a (para_dim, dim)
+/// rational bezier. Derivatives keep the generic path. See
+/// FixedDegreeBezierKernels.
+template<std::size_t para_dim, std::size_t dim, typename CoordinateType>
+struct FixedDegreeRationalBezierKernels {
+  using Basis_ = void (*)(const double*, const double*, double*);
+  using Evaluate_ = void (*)(const double*,
+                             const CoordinateType*,
+                             const double*,
+                             double*);
+
+  Basis_ basis{};
+  Evaluate_ evaluate{};
+
+  /// @brief True iff kernels exist
+  explicit operator bool() const { return basis != nullptr; }
+
+  /// @brief Kernels of given degree
+  template<int degree>
+  static constexpr FixedDegreeRationalBezierKernels Make() {
+    return {&FixedDegreeRationalBezierBasis<para_dim, degree>,
+            &FixedDegreeRationalBezierEvaluate<para_dim,
+                                               dim,
+                                               degree,
+                                               CoordinateType>};
+  }
+
+  /// @brief Looks up kernels for degrees, see FixedDegreeBezierKernels
+  /// @param degrees (para_dim)
+  template<typename DegreesType>
+  static FixedDegreeRationalBezierKernels Find(const DegreesType& degrees) {
+    if constexpr (para_dim > kMaxFixedParaDim) {
+      return {};
+    } else {
+      static constexpr std::array<FixedDegreeRationalBezierKernels,
+                                  kMaxFixedDegree + 1>
+          kTable{Make<0>(), Make<1>(), Make<2>(), Make<3>()};
+
+      const int degree = FixedDegree<para_dim>(degrees);
+      return (degree < 0) ? FixedDegreeRationalBezierKernels{}
+                          : kTable[degree];
+    }
+  }
+};
+
+/// @brief Knot spans of a query and the knot vectors they refer to. Callers
+/// find spans with FindKnotSpan(), so that B-spline kernels only evaluate.
+template<std::size_t para_dim>
+struct KnotSpans {
+  /// knot vectors
+  std::array<const double*, para_dim> knots;
+  /// knots[i][spans[i]] <= query[i] < knots[i][spans[i] + 1]
+  std::array<int, para_dim> spans;
+  /// number of control points per parametric dimension
+  std::array<int, para_dim> control_mesh_resolutions;
+};
+
+/// @brief B-spline basis or its derivative in one direction with
+/// compile-time degree. Values follow algorithm A2.2 of "The NURBS Book".
+/// Derivatives use d/du N_{i,p} = p (N_{i,p-1} / (u_{i+p} - u_i) -
+/// N_{i+1,p-1} / (u_{i+p+1} - u_{i+1})) on the same span. Orders larger than
+/// degree give zeros.
+/// @param[in] knots
+/// @param[in] span
+/// @param[in] u
+/// @param[in] order
+/// @param[out] values (degree + 1), of N_{span - degree}, ..., N_{span}
+template<int degree>
+inline void FixedDegreeBSplineBasis1D(const double* knots,
+                                      const int span,
+                                      const double u,
+                                      const int order,
+                                      double* values) {
+  if (order == 0) {
+    std::array<double, degree + 1> left, right;
+    values[0] = 1.;
+    for (int j{1}; j <= degree; ++j) {
+      left[j] = u - knots[span + 1 - j];
+      right[j] = knots[span + j] - u;
+      double saved{};
+      for (int r{}; r < j; ++r) {
+        const double tmp = values[r] / (right[r + 1] + left[j - r]);
+        values[r] = saved + right[r + 1] * tmp;
+        saved = left[j - r] * tmp;
+      }
+      values[j] = saved;
+    }
+    return;
+  }
+  if constexpr (degree == 0) {
+    values[0] = 0.;
+  } else {
+    // one degree lower has one non-zero function less on this span. Going
+    // backwards, values[r] is the last one to need lower values[r].
+    FixedDegreeBSplineBasis1D<degree - 1>(knots, span, u, order - 1, values);
+    const int first = span - degree;
+    values[degree] = degree * values[degree - 1]
+                     / (knots[span + degree] - knots[span]);
+    for (int r{degree - 1}; r > 0; --r) {
+      const int i = first + r;
+      values[r] =
+          degree
+          * (values[r - 1] / (knots[i + degree] - knots[i])
+             - values[r] / (knots[i + degree + 1] - knots[i + 1]));
+    }
+    values[0] *= -degree / (knots[span + 1] - knots[first + 1]);
+  }
+}
+
+/// @brief Tensor product B-spline basis or its derivative with compile-time
+/// degree. First parametric dimension runs fastest, same as support.
+/// @param[in] spans
+/// @param[in] para_coord (para_dim)
+/// @param[in] orders (para_dim), nullptr for basis values
+/// @param[out] basis ((degree + 1)^para_dim)
+template<std::size_t para_dim, int degree>
+inline void FixedDegreeBSplineBasis(const KnotSpans<para_dim>& spans,
+                                    const double* para_coord,
+                                    const int* orders,
+                                    double* basis) {
+  std::array<std::array<double, degree + 1>, para_dim> values;
+  for (std::size_t i{}; i < para_dim; ++i) {
+    FixedDegreeBSplineBasis1D<degree>(spans.knots[i],
+                                      spans.spans[i],
+                                      para_coord[i],
+                                      (orders) ? orders[i] : 0,
+                                      values[i].data());
+  }
+  FixedDegreeTensorProduct<para_dim, degree>(values, basis);
+}
+
+/// @brief B-spline support with compile-time degree, in the order of
+/// FixedDegreeBSplineBasis()
+/// @param[in] spans
+/// @param[out] support ((degree + 1)^para_dim)
+template<std::size_t para_dim, int degree>
+inline void FixedDegreeBSplineSupport(const KnotSpans<para_dim>& spans,
+                                      int* support) {
+  constexpr int n = degree + 1;
+  static_assert(para_dim > 0 && para_dim <= kMaxFixedParaDim,
+                "No fixed degree kernel for this parametric dimension.");
+
+  // id of first non-zero basis function per direction, scaled by strides
+  std::array<int, para_dim> firsts;
+  std::array<int, para_dim> strides;
+  int stride{1};
+  for (std::size_t i{}; i < para_dim; ++i) {
+    strides[i] = stride;
+    firsts[i] = (spans.spans[i] - degree) * stride;
+    stride *= spans.control_mesh_resolutions[i];
+  }
+
+  if constexpr (para_dim == 1) {
+    for (int i{}; i < n; ++i) {
+      support[i] = firsts[0] + i;
+    }
+  } else if constexpr (para_dim == 2) {
+    for (int j{}; j < n; ++j) {
+      const int offset = firsts[0] + firsts[1] + j * strides[1];
+      for (int i{}; i < n; ++i) {
+        support[j * n + i] = offset + i;
+      }
+    }
+  } else {
+    for (int k{}; k < n; ++k) {
+      for (int j{}; j < n; ++j) {
+        const int offset = firsts[0] + firsts[1] + firsts[2] + j * strides[1]
+                           + k * strides[2];
+        for (int i{}; i < n; ++i) {
+          support[(k * n + j) * n + i] = offset + i;
+        }
+      }
+    }
+  }
+}
+
+/// @brief B-spline evaluation with compile-time degree. Non-rational
+/// splines also evaluate derivatives. Rational splines save weighted
+/// coordinates with weight as last entry and only evaluate.
+/// @param[in] spans
+/// @param[in] para_coord (para_dim)
+/// @param[in] orders (para_dim), nullptr for evaluation
+/// @param[in] coordinates (n_control_points, dim + is_rational)
+/// @param[in] dim
+/// @param[out] evaluated (dim)
+template<std::size_t para_dim, int degree, bool is_rational>
+inline void FixedDegreeBSplineEvaluate(const KnotSpans<para_dim>& spans,
+                                       const double* para_coord,
+                                       const int* orders,
+                                       const double* coordinates,
+                                       const int dim,
+                                       double* evaluated) {
+  constexpr int n_supports = FixedDegreeNumberOfSupports<para_dim, degree>();
+  std::array<double, n_supports> basis;
+  std::array<int, n_supports> support;
+  FixedDegreeBSplineBasis<para_dim, degree>(spans,
+                                            para_coord,
+                                            orders,
+                                            basis.data());
+  FixedDegreeBSplineSupport<para_dim, degree>(spans, support.data());
+
+  const int stride = dim + static_cast<int>(is_rational);
+  std::fill_n(evaluated, dim, 0.);
+  double weight_sum{};
+  for (int i{}; i < n_supports; ++i) {
+    const double* coordinate = &coordinates[support[i] * stride];
+    for (int j{}; j < dim; ++j) {
+      evaluated[j] += basis[i] * coordinate[j];
+    }
+    if constexpr (is_rational) {
+      weight_sum += basis[i] * coordinate[dim];
+    }
+  }
+  if constexpr (is_rational) {
+    const double inv_weight_sum = 1. / weight_sum;
+    for (int j{}; j < dim; ++j) {
+      evaluated[j] *= inv_weight_sum;
+    }
+  }
+}
+
+/// @brief Registry of compile-time degree kernels for (rational) B-splines
+/// of given para_dim. Physical dimension is a runtime value, as in
+/// BSplineLib. The basis kernel evaluates non-rational basis and its
+/// derivatives, the evaluate kernel (rational) splines and, for non-rational
+/// ones, their derivatives. See FixedDegreeBezierKernels.
+template<std::size_t para_dim, bool is_rational>
+struct FixedDegreeBSplineKernels {
+  using Basis_ = void (*)(const KnotSpans<para_dim>&,
+                          const double*,
+                          const int*,
+                          double*);
+  using Evaluate_ = void (*)(const KnotSpans<para_dim>&,
+                             const double*,
+                             const int*,
+                             const double*,
+                             const int,
+                             double*);
+
+  Basis_ basis{};
+  Evaluate_ evaluate{};
+
+  /// @brief True iff kernels exist
+  explicit operator bool() const { return basis != nullptr; }
+
+  /// @brief Kernels of given degree
+  template<int degree>
+  static constexpr FixedDegreeBSplineKernels Make() {
+    return {&FixedDegreeBSplineBasis<para_dim, degree>,
+            &FixedDegreeBSplineEvaluate<para_dim, degree, is_rational>};
+  }
+
+  /// @brief Looks up kernels for degrees, see FixedDegreeBezierKernels
+  /// @param degrees (para_dim)
+  template<typename DegreesType>
+  static FixedDegreeBSplineKernels Find(const DegreesType& degrees) {
+    if constexpr (para_dim > kMaxFixedParaDim) {
+      return {};
+    } else {
+      static constexpr std::array<FixedDegreeBSplineKernels,
+                                  kMaxFixedDegree + 1>
+          kTable{Make<0>(), Make<1>(), Make<2>(), Make<3>()};
+
+      const int degree = FixedDegree<para_dim>(degrees);
+      return (degree < 0) ? FixedDegreeBSplineKernels{} : kTable[degree];
+    }
+  }
+};
+
+} // namespace splinepy::splines::helpers
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace splinepy::splines::helpers {
+
+/// @brief Switch for parameter space interning. Spaces that are already
+/// shared stay shared, only new splines are affected. Defined in splinepy, so
+/// that separately loaded libraries share it.
+std::atomic<bool>& ParameterSpaceInterningEnabled();
+
+/// @brief Hash-consing cache of parameter spaces keyed on degrees and knots.
+///
+/// Multipatch geometries and their fields often consist of many splines with
+/// identical degrees and knot vectors. Interned splines share one parameter
+/// space, including everything it precomputes. The cache only holds weak
+/// references, so spaces are freed with the last spline that uses them.
+///
+/// Shared spaces must never be modified. Splines have to replace an interned
+/// space with their own copy before knot insertion, degree elevation and
+/// before handing it out for writing, see BSpline::DetachParameterSpace.
+/// Reading through the const accessors keeps it shared.
+/// Knots are compared exactly.
+/// @tparam ParameterSpaceType
+template<typename ParameterSpaceType>
+class ParameterSpaceCache {
+public:
+  using KnotVectors_ = std::vector<std::vector<double>>;
+
+protected:
+  struct Entry {
+    std::vector<int> degrees_;
+    KnotVectors_ knot_vectors_;
+    std::weak_ptr<ParameterSpaceType> parameter_space_;
+  };
+
+  std::mutex mutex_;
+  std::unordered_multimap<std::size_t, Entry> entries_;
+  // number of entries after last removal of expired ones
+  std::size_t n_entries_after_sweep_{};
+
+  static std::size_t Hash(const int para_dim,
+                          const int* degrees,
+                          const KnotVectors_& knot_vectors) {
+    std::size_t seed{};
+    auto combine = [&seed](const std::size_t value) {
+      seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    };
+    const std::hash<double> knot_hash{};
+    for (int i{}; i < para_dim; ++i) {
+      combine(static_cast<std::size_t>(degrees[i]));
+      combine(knot_vectors[i].size());
+      for (const double knot : knot_vectors[i]) {
+        combine(knot_hash(knot));
+      }
+    }
+    return seed;
+  }
+
+  static bool Matches(const Entry& entry,
+                      const int para_dim,
+                      const int* degrees,
+                      const KnotVectors_& knot_vectors) {
+    for (int i{}; i < para_dim; ++i) {
+      if (entry.degrees_[i] != degrees[i]
+          || entry.knot_vectors_[i] != knot_vectors[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// @brief Removes expired entries, once the cache doubled since last time.
+  void SweepIfGrown() {
+    if (entries_.size() < 2 * n_entries_after_sweep_ + 64) {
+      return;
+    }
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->second.parameter_space_.expired()) {
+        it = entries_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    n_entries_after_sweep_ = entries_.size();
+  }
+
+public:
+  /// @brief Process wide cache for this parameter space type. Each type is
+  /// instantiated in one library only, also with SPLINEPY_LAZY_MORE, where
+  /// splinepy_more has parametric dimensions above 3.
+  static ParameterSpaceCache& Instance() {
+    static ParameterSpaceCache cache;
+    return cache;
+  }
+
+  /// @brief Returns the interned space with given degrees and knots. If
+  /// there's none, creates and interns it. Thread safe.
+  /// @param para_dim
+  /// @param degrees (para_dim)
+  /// @param knot_vectors (para_dim, n_knots)
+  /// @param create callable returning a new std::shared_ptr of the space
+  template<typename CreateFunction>
+  std::shared_ptr<ParameterSpaceType>
+  Intern(const int para_dim,
+         const int* degrees,
+         const KnotVectors_& knot_vectors,
+         const CreateFunction& create) {
+    const std::size_t key = Hash(para_dim, degrees, knot_vectors);
+
+    // look up existing
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      auto [begin, end] = entries_.equal_range(key);
+      for (auto it = begin; it != end; ++it) {
+        if (Matches(it->second, para_dim, degrees, knot_vectors)) {
+          if (auto existing = it->second.parameter_space_.lock()) {
+            return existing;
+          }
+        }
+      }
+    }
+
+    // construction may be expensive - do it without holding the lock
+    std::shared_ptr<ParameterSpaceType> created = create();
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto [begin, end] = entries_.equal_range(key);
+    for (auto it = begin; it != end; ++it) {
+      if (Matches(it->second, para_dim, degrees, knot_vectors)) {
+        // another thread may have been faster
+        if (auto existing = it->second.parameter_space_.lock()) {
+          return existing;
+        }
+        it->second.parameter_space_ = created;
+        return created;
+      }
+    }
+    SweepIfGrown();
+    entries_.emplace(
+        key,
+        Entry{std::vector<int>(degrees, degrees + para_dim),
+              KnotVectors_(knot_vectors.begin(),
+                           knot_vectors.begin() + para_dim),
+              created});
+    return created;
+  }
+};
+
+} // namespace splinepy::splines::helpers
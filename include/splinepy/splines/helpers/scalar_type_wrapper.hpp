@@ -5,6 +5,7 @@
 
 #include <splinepy/utils/arrays.hpp>
 #include <splinepy/utils/default_initialization_allocator.hpp>
+#include <splinepy/utils/scratch_arena.hpp>
 
 namespace splinepy::splines::helpers {
 /// bezman spline evaluation (single query).
@@ -41,15 +42,13 @@ void ScalarTypeEvaluate(const SplineType& spline,
 /// @param output should have size of 2 * para_dim * para_dim
 template<typename SplineType, typename OutputType>
 void ScalarTypeBoundaryCenters(const SplineType& spline, OutputType* output) {
-  using DoubleVector = splinepy::utils::DefaultInitializationVector<double>;
-
   // Prepare inputs
   const int para_dim = spline.SplinepyParaDim();
 
   // get parametric bounds
   // They are given back in the order [min_0, min_1,...,max_0, max_1...]
-  DoubleVector bounds_vector(2 * para_dim);
-  double* bounds = bounds_vector.data();
+  splinepy::utils::ScratchScope scratch;
+  double* bounds = scratch.Allocate<double>(2 * para_dim);
   spline.SplinepyParametricBounds(bounds);
 
   // Set parametric coordinate queries
@@ -72,16 +71,13 @@ void ScalarTypeBoundaryCenters(const SplineType& spline, OutputType* output) {
 template<typename SplineType, typename OutputType>
 void ScalarTypeEvaluateBoundaryCenters(const SplineType& spline,
                                        OutputType* output) {
-
-  using DoubleVector = splinepy::utils::DefaultInitializationVector<double>;
-
   // Prepare inputs
   const int para_dim = spline.SplinepyParaDim();
   const int dim = spline.SplinepyDim();
   const int n_faces = 2 * para_dim;
 
-  DoubleVector queries_vector(n_faces * para_dim);
-  double* queries = queries_vector.data();
+  splinepy::utils::ScratchScope scratch;
+  double* queries = scratch.Allocate<double>(n_faces * para_dim);
 
   // compute queries
   ScalarTypeBoundaryCenters(spline, queries);
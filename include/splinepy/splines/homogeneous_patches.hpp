@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "splinepy/splines/splinepy_base.hpp"
+#include "splinepy/utils/default_initialization_allocator.hpp"
+
+namespace splinepy::splines {
+
+/*!
+ * Shared basis evaluation of homogeneous patches.
+ *
+ * Homogeneous patches are non-rational splines of the same type with
+ * identical degrees, control mesh resolutions and knot vectors. Then, all
+ * patches share the same basis functions and only differ in their control
+ * points. Evaluation computes basis functions of each query once and
+ * contracts them with control points of all patches.
+ *
+ * Control points of all patches are copied into one contiguous array. Each
+ * patch's copy is refreshed once control points were set through the
+ * patch's control point pointers, see ControlPointPointers::version_. As
+ * patches may be refined or elevated in place, they should be checked with
+ * `SharesBasis()` before evaluation. Evaluations lock the array, so instances
+ * can be shared between multipatches and threads.
+ */
+class HomogeneousPatches {
+public:
+  using Patches_ = std::vector<std::shared_ptr<SplinepyBase>>;
+  using IntVector_ = splinepy::utils::DefaultInitializationVector<int>;
+  using DoubleVector_ = splinepy::utils::DefaultInitializationVector<double>;
+  using KnotVectors_ = std::vector<std::vector<double>>;
+  using ControlPointPointers_ = SplinepyBase::ControlPointPointers_;
+  using ParameterSpace_ = bsplinelib::parameter_spaces::ParameterSpaceBase;
+
+protected:
+  // recorded basis
+  std::string name_;
+  IntVector_ degrees_;
+  KnotVectors_ knot_vectors_;
+  bool has_knot_vectors_;
+
+  int n_patches_;
+  int n_control_points_;
+  int n_supports_;
+  int para_dim_;
+  int dim_;
+
+  // contiguous control points, (n_patches, n_control_points, dim)
+  mutable DoubleVector_ control_points_;
+  // control point pointers of each patch and their version at the time of
+  // copy. Holding them ensures that a new one never reuses the address
+  mutable std::vector<std::shared_ptr<const ControlPointPointers_>>
+      copied_pointers_;
+  mutable std::vector<std::size_t> copied_versions_;
+  mutable std::mutex control_points_mutex_;
+
+  /// @brief Checks if parameter space has recorded degrees and knot vectors.
+  /// Compares in place without copying knot vectors.
+  /// @param parameter_space
+  bool HasRecordedBasis(const ParameterSpace_& parameter_space) const;
+
+  /// @brief Copies control points of patches, whose control points were set
+  /// since the last copy
+  /// @param patches
+  /// @param n_thread
+  void UpdateControlPoints(const Patches_& patches, const int n_thread) const;
+
+public:
+  /// @brief Checks if given patches share the same basis. Name, degrees and
+  /// control mesh resolutions should be checked beforehand (see
+  /// `RaiseMismatch()`), this only checks for null splines, rational splines
+  /// and knot vectors.
+  /// @param patches
+  /// @param n_thread
+  static bool HaveSameBasis(const Patches_& patches, const int n_thread = 1);
+
+  /// @brief Records basis of the first patch and copies control points of all
+  /// patches. Patches should be homogeneous.
+  /// @param patches
+  /// @param n_thread
+  HomogeneousPatches(const Patches_& patches, const int n_thread = 1);
+
+  /// @brief Checks if patches still have the recorded basis, i.e., same
+  /// number of patches, type, degrees, number of control points and knot
+  /// vectors. Patches usually share their parameter space, which is then
+  /// compared only once. Nothing is copied.
+  /// @param patches
+  /// @param n_thread
+  bool SharesBasis(const Patches_& patches, const int n_thread = 1) const;
+
+  /// @brief Number of patches
+  int NumberOfPatches() const { return n_patches_; }
+
+  /// @brief Evaluates all patches at all queries. Patches should share the
+  /// recorded basis, see SharesBasis(). Refreshes outdated control points
+  /// first.
+  /// @param[in] patches
+  /// @param[in] queries (n_queries, para_dim)
+  /// @param[in] n_queries
+  /// @param[in] n_thread
+  /// @param[out] evaluated (n_patches, n_queries, dim)
+  void Evaluate(const Patches_& patches,
+                const double* queries,
+                const int n_queries,
+                const int n_thread,
+                double* evaluated) const;
+};
+
+} // namespace splinepy::splines
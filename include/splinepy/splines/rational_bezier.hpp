@@ -8,6 +8,7 @@
 #include <bezman/src/rational_bezier_spline.hpp>
 
 #include <splinepy/proximity/proximity.hpp>
+#include <splinepy/splines/helpers/fixed_degree_kernels.hpp>
 #include <splinepy/splines/splinepy_base.hpp>
 
 namespace splinepy::splines {
@@ -57,6 +58,12 @@ public:
   using Dimension_ = std::size_t;
   // advanced use
   using Proximity_ = splinepy::proximity::Proximity;
+  /// @brief Compile-time degree kernels. Looked up per call, as degrees can
+  /// change in place.
+  using FixedDegreeKernels_ =
+      splinepy::splines::helpers::FixedDegreeRationalBezierKernels<para_dim,
+                                                                   dim,
+                                                                   Coordinate_>;
 
   /// @brief Create base
   /// @param degrees
@@ -280,6 +287,9 @@ public:
   /// @brief Get proximity
   constexpr const Proximity_& GetProximity() const { return *proximity_; }
 
+  /// @brief Get proximity through base interface
+  virtual Proximity_* SplinepyProximity() { return proximity_.get(); }
+
   /// Deep copy of current spline
   virtual std::shared_ptr<SplinepyBase> SplinepyDeepCopy() const {
     return std::make_shared<RationalBezier>(*this);
@@ -186,6 +186,13 @@ void RationalBezier<para_dim, dim>::SplinepyGrevilleAbscissae(
 template<std::size_t para_dim, std::size_t dim>
 void RationalBezier<para_dim, dim>::SplinepyEvaluate(const double* para_coord,
                                                      double* evaluated) const {
+  if (const auto kernels = FixedDegreeKernels_::Find(Base_::GetDegrees())) {
+    kernels.evaluate(para_coord,
+                     Base_::GetWeightedControlPoints().data(),
+                     Base_::GetWeights().data(),
+                     evaluated);
+    return;
+  }
   splinepy::splines::helpers::ScalarTypeEvaluate(*this, para_coord, evaluated);
 }
 template<std::size_t para_dim, std::size_t dim>
@@ -212,6 +219,10 @@ void RationalBezier<para_dim, dim>::SplinepyElevateDegree(const int& p_dim) {
 template<std::size_t para_dim, std::size_t dim>
 void RationalBezier<para_dim, dim>::SplinepyBasis(const double* para_coord,
                                                   double* basis) const {
+  if (const auto kernels = FixedDegreeKernels_::Find(Base_::GetDegrees())) {
+    kernels.basis(para_coord, Base_::GetWeights().data(), basis);
+    return;
+  }
   splinepy::splines::helpers::BezierBasis(*this, para_coord, basis);
 }
 
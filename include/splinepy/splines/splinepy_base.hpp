@@ -10,6 +10,10 @@ class KnotVector;
 class ParameterSpaceBase;
 } // namespace bsplinelib::parameter_spaces
 
+namespace splinepy::proximity {
+class Proximity;
+} // namespace splinepy::proximity
+
 namespace splinepy::splines {
 
 /// Spline base to enable dynamic use of template splines.
@@ -59,6 +63,17 @@ public:
                        const int* degrees,
                        const double* control_points);
 
+  /// Creation of a non-rational bezier that views control_points instead of
+  /// copying them. They have to outlive the spline. Views support queries and
+  /// coordinate pointers. To modify them, create a bezier from their current
+  /// properties, which takes over their pointers, see
+  /// SplinepyTakeOverControlPointPointers.
+  static std::shared_ptr<SplinepyBase>
+  SplinepyCreateBezierView(const int para_dim,
+                           const int dim,
+                           const int* degrees,
+                           double* control_points);
+
   /// Dynamic creation of templated rational bezier
   static std::shared_ptr<SplinepyBase>
   SplinepyCreateRationalBezier(const int para_dim,
@@ -132,15 +147,36 @@ public:
                             double* control_points,
                             double* weights) const = 0;
 
+  /// @brief Parameter space for writing. Stops sharing it with other splines.
   virtual std::shared_ptr<bsplinelib::parameter_spaces::ParameterSpaceBase>
   SplinepyParameterSpace();
+  /// @brief Parameter space for reading. May be shared with other splines.
+  virtual std::shared_ptr<
+      const bsplinelib::parameter_spaces::ParameterSpaceBase>
+  SplinepyParameterSpace() const;
+  /// @brief Knot vector for writing. Stops sharing it with other splines.
   virtual std::shared_ptr<bsplinelib::parameter_spaces::KnotVector>
   SplinepyKnotVector(const int p_dim);
+  /// @brief Knot vector for reading. May be shared with other splines.
+  virtual std::shared_ptr<const bsplinelib::parameter_spaces::KnotVector>
+  SplinepyKnotVector(const int p_dim) const;
 
   virtual std::shared_ptr<ControlPointPointers_> SplinepyControlPointPointers();
   virtual std::shared_ptr<WeightedControlPointPointers_>
   SplinepyWeightedControlPointPointers();
   virtual std::shared_ptr<WeightPointers_> SplinepyWeightPointers();
+  /// @brief Control point pointers, if they were created before. Unlike
+  /// SplinepyControlPointPointers(), this neither creates them nor allows
+  /// writing. Their version_ tells if control points were set through them.
+  std::shared_ptr<const ControlPointPointers_>
+  SplinepyExistingControlPointPointers() const {
+    return control_point_pointers_;
+  }
+  /// @brief Takes over control point pointers of other, which this spline
+  /// replaces, and points them to this spline's control points. Pointers
+  /// handed out by other keep working. Only for non-rational splines with
+  /// the same number of control points.
+  void SplinepyTakeOverControlPointPointers(SplinepyBase& other);
 
   /// @brief Parameter space AABB
   /// @param para_bounds
@@ -231,6 +267,10 @@ public:
                                         double* first_derivatives,
                                         double* second_derivatives) const;
 
+  /// Proximity helper of this spline. Gives access to statistics and
+  /// extended queries.
+  virtual splinepy::proximity::Proximity* SplinepyProximity();
+
   /// Spline degree elevation
   virtual void SplinepyElevateDegree(const int& para_dims);
 
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <cmath>
 #include <numeric>
 #include <type_traits>
@@ -526,6 +527,15 @@ public:
     ResetRowOrder();
   }
 
+  /// @brief ctor with external row order memory, e.g., from ScratchArena
+  /// @param array
+  /// @param row_order_buffer should have space for number of rows
+  Matrix(DataArray_& array, IndexType* row_order_buffer) : array_(array) {
+    row_order_.SetData(row_order_buffer);
+    row_order_.SetShape(array.Shape()[0]);
+    ResetRowOrder();
+  }
+
   constexpr void ResetRowOrder() {
     std::iota(row_order_.begin(), row_order_.end(), 0);
   }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cassert>
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -42,6 +43,10 @@ struct ControlPointPointers {
   ///
   bool invalid_{false};
 
+  /// Number of writes through these pointers (and weight_pointers_). Copies
+  /// of control points compare it to tell if they are outdated.
+  std::size_t version_{};
+
   /// Returns Number of control points
   int Len() const;
 
@@ -106,6 +111,7 @@ void ControlPointPointers::SetRows(const int* ids,
   if (invalid_) {
     return;
   }
+  ++version_;
   const auto dim = Dim();
 
   if (for_rational_) {
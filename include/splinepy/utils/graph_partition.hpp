@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+
+#include "splinepy/utils/default_initialization_allocator.hpp"
+
+namespace splinepy::utils {
+
+/// @brief Undirected graph in compressed sparse row format. Neighbors of
+/// vertex i are neighbors[offsets[i]:offsets[i + 1]] with corresponding edge
+/// weights.
+struct CsrGraph {
+  using IntVector_ = DefaultInitializationVector<int>;
+
+  int n_vertices{};
+  IntVector_ offsets;
+  IntVector_ neighbors;
+  IntVector_ edge_weights;
+};
+
+/// @brief Builds a graph from undirected edges. Duplicate edges are merged
+/// and their count is used as edge weight. Self loops are ignored.
+/// @param n_vertices
+/// @param edges (n_edges, 2)
+/// @param n_edges
+/// @param[out] graph
+void GraphFromEdges(const int n_vertices,
+                    const int* edges,
+                    const int n_edges,
+                    CsrGraph& graph);
+
+/// @brief Partitions graph into n_parts with recursive bisection. Each
+/// bisection grows a region from a pseudo-peripheral vertex, preferring
+/// vertices that are strongly connected to the region, until it reaches its
+/// target weight. Afterwards, boundary vertices are moved greedily as long as
+/// this reduces the edge cut without violating balance.
+/// @param[in] graph
+/// @param[in] vertex_weights (n_vertices), nullptr for unit weights
+/// @param[in] n_parts
+/// @param[out] parts (n_vertices) part id of each vertex
+/// @return summed weight of cut edges
+int RecursiveBisection(const CsrGraph& graph,
+                       const double* vertex_weights,
+                       const int n_parts,
+                       int* parts);
+
+/// @brief Numbering of vertices, where vertices are sorted by part and in
+/// breadth first order within each part, so that neighbors are close.
+/// @param[in] graph
+/// @param[in] parts (n_vertices)
+/// @param[in] n_parts
+/// @param[out] order (n_vertices) order[new_id] = old_id
+void PartitionOrder(const CsrGraph& graph,
+                    const int* parts,
+                    const int n_parts,
+                    int* order);
+
+} // namespace splinepy::utils
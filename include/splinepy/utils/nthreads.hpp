@@ -1,15 +1,29 @@
 #pragma once
 
 #include <cstdlib>
+#include <exception>
 #include <thread>
+#include <vector>
+
+#include "splinepy/utils/scratch_arena.hpp"
 
 namespace splinepy::utils {
 /// N-Thread execution. Queries will be split into chunks and each thread
-/// will execute those.
+/// will execute those. Each chunk runs in a ScratchScope, so scratch memory
+/// drawn from the thread's arena is released after the chunk. Threads use
+/// arenas from ScratchArenaPool, which keep their memory between calls.
+/// Exceptions thrown by func are rethrown on the calling thread once all
+/// threads joined. If more than one thread throws, the one with the lowest
+/// thread id wins.
 template<typename Func, typename IndexType>
-void NThreadExecution(const Func& f,
+void NThreadExecution(const Func& func,
                       const IndexType& total,
                       IndexType nthread /* copy */) {
+  auto f = [&func](const IndexType begin, const IndexType end, const int i) {
+    ScratchScope scope;
+    func(begin, end, i);
+  };
+
   // For any negative value, std::thread::hardware_concurrency() will be taken
   // If you are not satisfied with returned value, use positive value.
   // For more info:
@@ -20,35 +34,59 @@ void NThreadExecution(const Func& f,
     nthread = std::thread::hardware_concurrency();
   }
 
+  // we don't want nthread to exceed total
+  nthread = std::min(total, nthread);
+
   // 0 or 1, don't create a thread.
   if (nthread <= 1) {
     f(0, total, 0);
     return;
   }
 
-  // we don't want nthread to exceed total
-  nthread = std::min(total, nthread);
+  // get chunk size - make sure it rounds up. Rounding up may leave
+  // threads without work, e.g., total=5, nthread=4 gives chunks of 2, so
+  // only spawn as many threads as there are chunks. Then every chunk lies
+  // within [0, total).
+  const IndexType chunk_size = std::div((total + nthread - 1), nthread).quot;
+  nthread = std::div((total + chunk_size - 1), chunk_size).quot;
+
+  // exceptions can't leave a std::thread - keep them for the caller
+  std::vector<std::exception_ptr> exceptions(nthread);
+  // threads are new for each call - their scratch memory is kept in the pool
+  ScratchArenaPool::Lease arenas(static_cast<std::size_t>(nthread));
+  auto f_caught = [&f, &exceptions, &arenas](const IndexType begin,
+                                             const IndexType end,
+                                             const int i) {
+    ScratchArena::Binding binding(arenas[static_cast<std::size_t>(i)]);
+    try {
+      f(begin, end, i);
+    } catch (...) {
+      exceptions[i] = std::current_exception();
+    }
+  };
 
   // reserve thread pool
   std::vector<std::thread> thread_pool;
   thread_pool.reserve(nthread);
 
-  // get chunk size and prepare threads
-  // make sure it rounds up
-  const IndexType chunk_size = std::div((total + nthread - 1), nthread).quot;
-
   for (int i{}; i < (nthread - 1); i++) {
     thread_pool.emplace_back(
-        std::thread{f, i * chunk_size, (i + 1) * chunk_size, i});
+        std::thread{f_caught, i * chunk_size, (i + 1) * chunk_size, i});
   }
 
   // last one
   thread_pool.emplace_back(
-      std::thread{f, (nthread - 1) * chunk_size, total, nthread - 1});
+      std::thread{f_caught, (nthread - 1) * chunk_size, total, nthread - 1});
 
   for (auto& t : thread_pool) {
     t.join();
   }
+
+  for (const auto& exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
 }
 } // namespace splinepy::utils
 /* namespace splinepy::utils */
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "splinepy/utils/arrays.hpp"
+
+namespace splinepy::utils {
+
+/*!
+ * Bump allocator for short lived temporaries of core algorithms.
+ *
+ * Memory is taken from blocks that are kept for the lifetime of the arena.
+ * Allocations are released in LIFO order by rolling back to a marker, which
+ * is what ScratchScope does. Once the blocks are large enough for a routine,
+ * repeated calls don't touch the heap anymore. Each thread has its own
+ * arena, see ThreadLocal(), so no synchronization is needed. Short lived
+ * threads, like the ones of NThreadExecution, bind an arena from
+ * ScratchArenaPool instead, so that blocks outlive the thread.
+ *
+ * Only for trivially destructible types. Allocated values are default
+ * initialized, i.e., not initialized for fundamental types.
+ */
+class ScratchArena {
+public:
+  /// @brief Position in arena to roll back to
+  struct Marker {
+    std::size_t block_;
+    std::size_t offset_;
+  };
+
+protected:
+  struct Block {
+    std::unique_ptr<std::byte[]> data_;
+    std::size_t size_;
+  };
+
+  static constexpr std::size_t kMinBlockSize = 1 << 14;
+
+  std::vector<Block> blocks_;
+  std::size_t current_block_{};
+  std::size_t offset_{};
+
+  /// @brief Arena bound to current thread, if any
+  static ScratchArena*& Bound() {
+    thread_local ScratchArena* bound{};
+    return bound;
+  }
+
+public:
+  ScratchArena() = default;
+  ScratchArena(const ScratchArena&) = delete;
+  ScratchArena& operator=(const ScratchArena&) = delete;
+
+  /// @brief Arena of current thread. This is the arena of the innermost
+  /// Binding, or the thread's own arena if there is none.
+  static ScratchArena& ThreadLocal() {
+    if (ScratchArena* bound = Bound()) {
+      return *bound;
+    }
+    thread_local ScratchArena arena;
+    return arena;
+  }
+
+  /// @brief Makes an arena the one of current thread, until the end of the
+  /// scope.
+  class Binding {
+  protected:
+    ScratchArena* previous_;
+
+  public:
+    explicit Binding(ScratchArena& arena) : previous_(Bound()) {
+      Bound() = &arena;
+    }
+    Binding(const Binding&) = delete;
+    Binding& operator=(const Binding&) = delete;
+    ~Binding() { Bound() = previous_; }
+  };
+
+  /// @brief Current position
+  Marker GetMarker() const { return {current_block_, offset_}; }
+
+  /// @brief Releases everything allocated after marker
+  void Release(const Marker& marker) {
+    current_block_ = marker.block_;
+    offset_ = marker.offset_;
+  }
+
+  /// @brief Releases everything. Memory is kept.
+  void Reset() { Release(Marker{}); }
+
+  /// @brief Total bytes held by this arena
+  std::size_t Capacity() const {
+    std::size_t capacity{};
+    for (const auto& block : blocks_) {
+      capacity += block.size_;
+    }
+    return capacity;
+  }
+
+  /// @brief Allocates n default initialized values
+  template<typename DataType>
+  DataType* Allocate(const std::size_t n) {
+    static_assert(std::is_trivially_destructible_v<DataType>,
+                  "ScratchArena never calls destructors.");
+    constexpr std::size_t alignment = alignof(DataType);
+    const std::size_t n_bytes = n * sizeof(DataType);
+
+    for (;; ++current_block_, offset_ = 0) {
+      if (current_block_ == blocks_.size()) {
+        // new block at least doubles the capacity
+        const std::size_t size =
+            std::max({n_bytes + alignment,
+                      kMinBlockSize,
+                      (blocks_.empty()) ? 0 : 2 * blocks_.back().size_});
+        blocks_.push_back(Block{std::make_unique<std::byte[]>(size), size});
+      }
+
+      Block& block = blocks_[current_block_];
+      const std::size_t begin = (offset_ + alignment - 1) / alignment
+                                * alignment;
+      if (begin + n_bytes <= block.size_) {
+        offset_ = begin + n_bytes;
+        DataType* data =
+            reinterpret_cast<DataType*>(block.data_.get() + begin);
+        std::uninitialized_default_construct_n(data, n);
+        return data;
+      }
+    }
+  }
+};
+
+/// @brief Arenas that are kept between calls of NThreadExecution. Its
+/// threads are new for each call and their own arenas would allocate blocks
+/// again each time. Arenas are lent out, so concurrent calls never share
+/// one.
+class ScratchArenaPool {
+public:
+  using Arenas_ = std::vector<std::unique_ptr<ScratchArena>>;
+
+  /// @brief Takes n arenas from the pool. Creates missing ones.
+  static Arenas_ Take(const std::size_t n);
+
+  /// @brief Puts arenas back into the pool
+  static void Give(Arenas_&& arenas);
+
+  /// @brief Arenas taken from the pool for the lifetime of this object
+  class Lease {
+  protected:
+    Arenas_ arenas_;
+
+  public:
+    explicit Lease(const std::size_t n) : arenas_(Take(n)) {}
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+    ~Lease() { Give(std::move(arenas_)); }
+
+    ScratchArena& operator[](const std::size_t i) { return *arenas_[i]; }
+  };
+};
+
+/// @brief Scope on an arena. Everything allocated through this scope, as
+/// well as everything allocated in the arena after the scope was opened, is
+/// released at the end of the scope.
+class ScratchScope {
+protected:
+  ScratchArena& arena_;
+  ScratchArena::Marker marker_;
+
+public:
+  /// @brief Opens scope on the arena of current thread
+  ScratchScope() : ScratchScope(ScratchArena::ThreadLocal()) {}
+
+  explicit ScratchScope(ScratchArena& arena)
+      : arena_(arena),
+        marker_(arena.GetMarker()) {}
+
+  ScratchScope(const ScratchScope&) = delete;
+  ScratchScope& operator=(const ScratchScope&) = delete;
+
+  ~ScratchScope() { arena_.Release(marker_); }
+
+  /// @brief Allocates n default initialized values
+  template<typename DataType>
+  DataType* Allocate(const int n) {
+    return arena_.Allocate<DataType>(static_cast<std::size_t>(n));
+  }
+
+  /// @brief Non-owning Array view on arena memory. Dimension of the array is
+  /// the number of given shape entries.
+  template<typename DataType, typename... Ts>
+  Array<DataType, sizeof...(Ts)> MakeArray(const Ts&... shape) {
+    const int size = (static_cast<int>(shape) * ...);
+    return Array<DataType, sizeof...(Ts)>(Allocate<DataType>(size), shape...);
+  }
+};
+
+} // namespace splinepy::utils
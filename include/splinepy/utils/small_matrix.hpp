@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace splinepy::utils {
+
+/// @brief Fixed size vector on the stack
+/// @tparam DataType
+/// @tparam size
+template<typename DataType, int size>
+using SmallVector = std::array<DataType, size>;
+
+/// @brief Fixed size, row-major matrix on the stack. Meant for para_dim and
+/// dim sized linear algebra, where Array and Matrix are too heavy.
+/// @tparam DataType
+/// @tparam n_rows
+/// @tparam n_cols
+template<typename DataType, int n_rows, int n_cols = n_rows>
+class SmallMatrix {
+  static_assert(n_rows > 0 && n_cols > 0, "SmallMatrix can't be empty.");
+
+public:
+  static constexpr int kRows = n_rows;
+  static constexpr int kCols = n_cols;
+
+  using DataType_ = DataType;
+  /// @brief Vector with n_cols entries
+  using ColumnVector_ = SmallVector<DataType, n_cols>;
+  /// @brief Vector with n_rows entries
+  using RowVector_ = SmallVector<DataType, n_rows>;
+
+protected:
+  std::array<DataType, n_rows * n_cols> data_{};
+
+public:
+  constexpr DataType* data() { return data_.data(); }
+  constexpr const DataType* data() const { return data_.data(); }
+
+  constexpr DataType& operator()(const int i, const int j) {
+    return data_[i * n_cols + j];
+  }
+  constexpr const DataType& operator()(const int i, const int j) const {
+    return data_[i * n_cols + j];
+  }
+
+  /// @brief Copies row-major values
+  constexpr void CopyFrom(const DataType* values) {
+    for (int i{}; i < n_rows * n_cols; ++i) {
+      data_[i] = values[i];
+    }
+  }
+
+  /// @brief y = this * x
+  constexpr RowVector_ Multiply(const ColumnVector_& x) const {
+    RowVector_ y{};
+    for (int i{}; i < n_rows; ++i) {
+      for (int j{}; j < n_cols; ++j) {
+        y[i] += (*this)(i, j) * x[j];
+      }
+    }
+    return y;
+  }
+
+  /// @brief Transposed copy
+  constexpr SmallMatrix<DataType, n_cols, n_rows> Transposed() const {
+    SmallMatrix<DataType, n_cols, n_rows> transposed;
+    for (int i{}; i < n_rows; ++i) {
+      for (int j{}; j < n_cols; ++j) {
+        transposed(j, i) = (*this)(i, j);
+      }
+    }
+    return transposed;
+  }
+};
+
+/// @brief Closed form determinant for 1 to 3 dimensions
+template<typename DataType, int n>
+constexpr DataType Determinant(const SmallMatrix<DataType, n, n>& a) {
+  static_assert(n > 0 && n < 4,
+                "Closed form determinant is only available up to 3x3.");
+  if constexpr (n == 1) {
+    return a(0, 0);
+  } else if constexpr (n == 2) {
+    return a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0);
+  } else {
+    return a(0, 0) * (a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1))
+           - a(0, 1) * (a(1, 0) * a(2, 2) - a(1, 2) * a(2, 0))
+           + a(0, 2) * (a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0));
+  }
+}
+
+/// @brief Maximum absolute row sum
+template<typename DataType, int n_rows, int n_cols>
+constexpr DataType
+InfinityNorm(const SmallMatrix<DataType, n_rows, n_cols>& a) {
+  DataType norm{};
+  for (int i{}; i < n_rows; ++i) {
+    DataType row_sum{};
+    for (int j{}; j < n_cols; ++j) {
+      row_sum += std::abs(a(i, j));
+    }
+    norm = std::max(norm, row_sum);
+  }
+  return norm;
+}
+
+/// @brief Determinants relative to ||a||^n below this are treated as
+/// singular. Adjugate over determinant loses about as many digits as a is
+/// ill-conditioned, so callers should fall back to a pivoting solver then.
+template<typename DataType>
+constexpr DataType kSingularRelativeTolerance =
+    DataType{128} * std::numeric_limits<DataType>::epsilon();
+
+/// @brief True iff a is singular or too close to singular for closed form
+/// inversion, i.e., |det(a)| <= tolerance * ||a||_inf^n, or not finite.
+template<typename DataType, int n>
+inline bool IsNearlySingular(
+    const SmallMatrix<DataType, n, n>& a,
+    const DataType det,
+    const DataType relative_tolerance =
+        kSingularRelativeTolerance<DataType>) {
+  if (!std::isfinite(det)) {
+    return true;
+  }
+  const DataType norm = InfinityNorm(a);
+  DataType norm_n{1};
+  for (int i{}; i < n; ++i) {
+    norm_n *= norm;
+  }
+  return std::abs(det) <= relative_tolerance * norm_n;
+}
+
+/// @brief Closed form inverse for 1 to 3 dimensions, computed as adjugate
+/// over determinant.
+/// @param[in] a
+/// @param[out] inverse
+/// @return false if a is (nearly) singular or not finite, see
+/// IsNearlySingular(). inverse is not set then.
+template<typename DataType, int n>
+inline bool Inverse(const SmallMatrix<DataType, n, n>& a,
+                    SmallMatrix<DataType, n, n>& inverse) {
+  const DataType det = Determinant(a);
+  if (IsNearlySingular(a, det)) {
+    return false;
+  }
+  const DataType inv_det = DataType{1} / det;
+
+  if constexpr (n == 1) {
+    inverse(0, 0) = inv_det;
+  } else if constexpr (n == 2) {
+    inverse(0, 0) = a(1, 1) * inv_det;
+    inverse(0, 1) = -a(0, 1) * inv_det;
+    inverse(1, 0) = -a(1, 0) * inv_det;
+    inverse(1, 1) = a(0, 0) * inv_det;
+  } else {
+    inverse(0, 0) = (a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1)) * inv_det;
+    inverse(0, 1) = (a(0, 2) * a(2, 1) - a(0, 1) * a(2, 2)) * inv_det;
+    inverse(0, 2) = (a(0, 1) * a(1, 2) - a(0, 2) * a(1, 1)) * inv_det;
+    inverse(1, 0) = (a(1, 2) * a(2, 0) - a(1, 0) * a(2, 2)) * inv_det;
+    inverse(1, 1) = (a(0, 0) * a(2, 2) - a(0, 2) * a(2, 0)) * inv_det;
+    inverse(1, 2) = (a(0, 2) * a(1, 0) - a(0, 0) * a(1, 2)) * inv_det;
+    inverse(2, 0) = (a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0)) * inv_det;
+    inverse(2, 1) = (a(0, 1) * a(2, 0) - a(0, 0) * a(2, 1)) * inv_det;
+    inverse(2, 2) = (a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0)) * inv_det;
+  }
+  return true;
+}
+
+/// @brief Solves a x = b in closed form for 1 to 3 dimensions
+/// @param[in] a
+/// @param[in] b
+/// @param[out] x
+/// @return false if a is (nearly) singular or not finite. x is not set then.
+/// Use a pivoting solver, e.g., Matrix::Solve, in that case.
+template<typename DataType, int n>
+inline bool Solve(const SmallMatrix<DataType, n, n>& a,
+                  const typename SmallMatrix<DataType, n, n>::ColumnVector_& b,
+                  typename SmallMatrix<DataType, n, n>::ColumnVector_& x) {
+  SmallMatrix<DataType, n, n> inverse;
+  if (!Inverse(a, inverse)) {
+    return false;
+  }
+  x = inverse.Multiply(b);
+  return true;
+}
+
+} // namespace splinepy::utils
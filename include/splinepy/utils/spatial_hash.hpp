@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "splinepy/utils/default_initialization_allocator.hpp"
+
+namespace splinepy::utils {
+
+/// @brief Uniform grid spatial hash for fixed radius neighbor search.
+///
+/// Points are bucketed by their cell index, which is hashed into a single key.
+/// As long as the cell size is not smaller than the search radius, all
+/// neighbors are within the adjacent cells. Key collisions only add
+/// candidates, as distances are always checked. Insertion is serial and
+/// appends ids, searches are read-only and can be called concurrently.
+class SpatialHash {
+public:
+  using IntVector_ = DefaultInitializationVector<int>;
+  using DoubleVector_ = DefaultInitializationVector<double>;
+  using Key_ = std::uint64_t;
+
+protected:
+  int dim_;
+  double cell_size_;
+  DoubleVector_ points_;
+  std::unordered_map<Key_, IntVector_> cells_;
+
+  /// @brief Cell index of a point
+  void CellIndex(const double* point, long long* cell_index) const;
+
+  /// @brief Hash of a cell index
+  Key_ CellKey(const long long* cell_index) const;
+
+public:
+  /// @brief ctor
+  /// @param dim
+  /// @param cell_size should be at least as large as search radius
+  SpatialHash(const int dim, const double cell_size);
+
+  /// @brief Number of inserted points
+  int Size() const { return static_cast<int>(points_.size()) / dim_; }
+
+  /// @brief Dimension of points
+  int Dim() const { return dim_; }
+
+  /// @brief Cell size
+  double CellSize() const { return cell_size_; }
+
+  /// @brief Inserted point
+  /// @param id
+  const double* Point(const int id) const { return &points_[id * dim_]; }
+
+  /// @brief Appends points. Ids continue from current size.
+  /// @param points (n_points, dim)
+  /// @param n_points
+  void Insert(const double* points, const int n_points);
+
+  /// @brief Finds all points within radius. Ids are sorted and unique.
+  /// @param[in] query (dim)
+  /// @param[in] radius should not be larger than cell size
+  /// @param[out] ids cleared and filled
+  void RadiusSearch(const double* query,
+                    const double radius,
+                    IntVector_& ids) const;
+};
+
+} // namespace splinepy::utils
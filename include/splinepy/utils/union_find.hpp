@@ -0,0 +1,78 @@
+#pragma once
+
+#include <numeric>
+#include <utility>
+
+#include <splinepy/utils/default_initialization_allocator.hpp>
+
+namespace splinepy::utils {
+
+/// @brief Disjoint set forest with path halving and union by size.
+///
+/// Not thread safe. Typical use is to collect pairs in parallel and to union
+/// them afterwards.
+class UnionFind {
+public:
+  using IntVector_ = DefaultInitializationVector<int>;
+
+protected:
+  IntVector_ parents_;
+  IntVector_ sizes_;
+
+public:
+  UnionFind() = default;
+  UnionFind(const int n) { Resize(n); }
+
+  /// @brief Resets to n singletons
+  void Resize(const int n) {
+    parents_.resize(n);
+    std::iota(parents_.begin(), parents_.end(), 0);
+    sizes_.assign(n, 1);
+  }
+
+  /// @brief Number of elements
+  int Size() const { return static_cast<int>(parents_.size()); }
+
+  /// @brief Root of the set that contains id
+  int Find(int id) {
+    while (parents_[id] != id) {
+      parents_[id] = parents_[parents_[id]];
+      id = parents_[id];
+    }
+    return id;
+  }
+
+  /// @brief Merges sets of a and b. Returns false if they were already merged
+  bool Union(const int a, const int b) {
+    int root_a = Find(a);
+    int root_b = Find(b);
+    if (root_a == root_b) {
+      return false;
+    }
+    if (sizes_[root_a] < sizes_[root_b]) {
+      std::swap(root_a, root_b);
+    }
+    parents_[root_b] = root_a;
+    sizes_[root_a] += sizes_[root_b];
+    return true;
+  }
+
+  /// @brief Numbers sets contiguously in the order of their first element.
+  /// @param[out] set_ids (Size())
+  /// @return number of sets
+  int SetIds(int* set_ids) {
+    const int n = Size();
+    IntVector_ root_ids(n, -1);
+    int n_sets{};
+    for (int i{}; i < n; ++i) {
+      int& root_id = root_ids[Find(i)];
+      if (root_id < 0) {
+        root_id = n_sets++;
+      }
+      set_ids[i] = root_id;
+    }
+    return n_sets;
+  }
+};
+
+} // namespace splinepy::utils
@@ -1001,6 +1001,74 @@ def pyramid(width, length, height):
     return p
 
 
+def many(
+    degrees,
+    control_points,
+    knot_vectors=None,
+    knot_vector_offsets=None,
+    weights=None,
+    as_multipatch=False,
+    nthreads=None,
+):
+    """Creates many splines of the same parametric and physical dimension at
+    once from stacked arrays. Validation and creation run in parallel without
+    per spline keyword parsing. Spline types follow from the presence of
+    knot vectors and weights.
+
+    Parameters
+    ----------
+    degrees: (n_splines, para_dim) array-like
+    control_points: (n_control_points, dim) array-like
+      Control points of all splines, stacked in spline order
+    knot_vectors: (n_knots,) array-like or list
+      Either all knots stacked in spline and parametric dimension order with
+      `knot_vector_offsets`, or a list of knot vectors per spline. Default is
+      None, which creates Bezier types
+    knot_vector_offsets: (n_splines * para_dim + 1,) array-like
+    weights: (n_control_points,) array-like
+      Default is None, which creates non-rational types
+    as_multipatch: bool
+      If True, returns a Multipatch instead of a list
+    nthreads: int
+
+    Returns
+    -------
+    splines: list or Multipatch
+    """
+    from splinepy.splinepy_core import create_many
+
+    degrees = _np.ascontiguousarray(degrees, dtype="int32")
+    if degrees.ndim == 1:
+        degrees = degrees.reshape(1, -1)
+
+    if knot_vectors is not None and knot_vector_offsets is None:
+        flat_knot_vectors = [
+            kv for spline_kvs in knot_vectors for kv in spline_kvs
+        ]
+        knot_vector_offsets = _np.cumsum(
+            [0] + [len(kv) for kv in flat_knot_vectors]
+        )
+        knot_vectors = _np.concatenate(flat_knot_vectors)
+
+    if knot_vectors is not None:
+        knot_vectors = _np.ascontiguousarray(knot_vectors, dtype="float64")
+        knot_vector_offsets = _np.ascontiguousarray(
+            knot_vector_offsets, dtype="int32"
+        )
+    if weights is not None:
+        weights = _np.ascontiguousarray(weights, dtype="float64").ravel()
+
+    return create_many(
+        degrees=degrees,
+        control_points=_np.ascontiguousarray(control_points, dtype="float64"),
+        knot_vectors=knot_vectors,
+        knot_vector_offsets=knot_vector_offsets,
+        weights=weights,
+        as_multipatch=as_multipatch,
+        nthreads=nthreads if nthreads is not None else _settings.NTHREADS,
+    )
+
+
 class Creator:
     """Helper class to build new splines from existing geometries.
 
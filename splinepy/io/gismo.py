@@ -259,7 +259,6 @@ def export(
     from splinepy.settings import NTHREADS as _NTHREADS
     from splinepy.settings import TOLERANCE as _TOLERANCE
     from splinepy.spline import Spline as _Spline
-    from splinepy.splinepy_core import orientations as _orientations
 
     # First transform spline-data into a multipatch-data if required
     if issubclass(type(multipatch), _Spline):
@@ -308,43 +307,22 @@ def export(
 
     interface_data = _ET.SubElement(multipatch_element, "interfaces")
 
-    # Retrieve all interfaces (negative numbers refer to boundaries)
-    global_interface_id = _np.where(multipatch.interfaces.ravel() >= 0)[0]
-    number_of_element_faces = multipatch.interfaces.shape[1]
+    # Retrieve all interfaces with their orientation. Each interface is
+    # listed once, starting from the lower global face id
+    (
+        patch_id_start,
+        face_id_start,
+        patch_id_end,
+        face_id_end,
+        axis_mapping,
+        axis_orientation,
+    ) = multipatch.interface_orientations(
+        tolerance=_TOLERANCE, nthreads=_NTHREADS
+    )
 
-    if global_interface_id.size == 0:
+    if patch_id_start.size == 0:
         _warning("No inter-face connections were found.")
     else:
-        # First we identify all interfaces between patches
-        is_lower_id = (
-            multipatch.interfaces.flat[global_interface_id]
-            > global_interface_id
-        )
-
-        # The interfaces refer to the global face ids so now we can extract the
-        # element ID and face ID
-        patch_id_start, face_id_start = _np.divmod(
-            global_interface_id[is_lower_id], number_of_element_faces
-        )
-        patch_id_end, face_id_end = _np.divmod(
-            multipatch.interfaces[patch_id_start, face_id_start],
-            number_of_element_faces,
-        )
-
-        # Identify Orientation
-        (
-            axis_mapping,
-            axis_orientation,
-        ) = _orientations(
-            multipatch.patches,
-            patch_id_start,
-            face_id_start,
-            patch_id_end,
-            face_id_end,
-            _TOLERANCE,
-            _NTHREADS,
-        )
-
         # write to file
         # Reminder: Face enumeration starts at 1 in gismo (i.e. requires an
         # offset of 1)
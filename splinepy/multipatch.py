@@ -5,6 +5,7 @@ Multipatch Spline Configuration
 import numpy as _np
 
 from splinepy import settings as _settings
+from splinepy import utils as _utils
 from splinepy._base import SplinepyBase as _SplinepyBase
 from splinepy.helpme import visualize as _visualize
 from splinepy.helpme.extract import Extractor as _Extractor
@@ -315,6 +316,43 @@ class Multipatch(_SplinepyBase, _PyMultipatch):
 
         return interfaces
 
+    @property
+    def non_manifold_faces(self):
+        """
+        Global face ids of non-manifold contacts, i.e., faces where more than
+        two face centers coincide. Found during interface determination and
+        treated as boundaries.
+
+        Parameters
+        ----------
+        None
+
+        Returns
+        -------
+        non_manifold_faces : (n,) np.ndarray
+        """
+        return super().non_manifold_faces()
+
+    def append_patches(self, patches, nthreads=None):
+        """
+        Appends patches. If interfaces are already determined, only faces of
+        the new patches are matched and interfaces are updated incrementally.
+        Boundary information of existing faces is kept.
+
+        Parameters
+        ----------
+        patches : list
+        nthreads : int
+
+        Returns
+        -------
+        None
+        """
+        super().append_patches(
+            list(patches),
+            nthreads=_default_if_none(nthreads, _settings.NTHREADS),
+        )
+
     def boundary_from_function(
         self,
         function,
@@ -601,27 +639,588 @@ class Multipatch(_SplinepyBase, _PyMultipatch):
             same_parametric_bounds=False,
         )
 
-    def evaluate(self, queries, nthreads=None):
+    def sample_resolutions(
+        self, spacing, min_resolution=2, max_resolution=100, nthreads=None
+    ):
+        """
+        Per patch sample resolutions, so that samples are roughly `spacing`
+        apart. Lengths along each parametric axis are estimated with the
+        longest control polygon line, which also grows with curvature.
+
+        Parameters
+        -----------
+        spacing: float
+        min_resolution: int
+          At least 2
+        max_resolution: int
+        nthreads: int
+
+        Returns
+        --------
+        resolutions: (n_patches, para_dim) np.ndarray
+        """
+        return super().sample_resolutions(
+            spacing=spacing,
+            min_resolution=min_resolution,
+            max_resolution=max_resolution,
+            nthreads=_default_if_none(nthreads, _settings.NTHREADS),
+        )
+
+    def sample_patches(
+        self,
+        resolutions=None,
+        spacing=None,
+        min_resolution=2,
+        max_resolution=100,
+        nthreads=None,
+    ):
+        """
+        Uniformly samples each patch with its own resolutions, given
+        explicitly or derived from `spacing` (see `sample_resolutions()`).
+        Samples are packed contiguously, patch i is
+        `sampled[offsets[i]:offsets[i + 1]]`.
+
+        Parameters
+        -----------
+        resolutions: (n_patches,) or (n_patches, para_dim) array-like
+          At least 2 in each direction
+        spacing: float
+          Used if resolutions is None
+        min_resolution: int
+        max_resolution: int
+        nthreads: int
+
+        Returns
+        --------
+        sampled: (offsets[-1], dim) np.ndarray
+        offsets: (n_patches + 1,) np.ndarray
+        """
+        nthreads = _default_if_none(nthreads, _settings.NTHREADS)
+        if resolutions is None:
+            if spacing is None:
+                raise ValueError("Either resolutions or spacing is required.")
+            resolutions = self.sample_resolutions(
+                spacing, min_resolution, max_resolution, nthreads
+            )
+
+        return super().sample_patches(
+            _np.ascontiguousarray(resolutions, dtype="int32"),
+            nthreads=nthreads,
+        )
+
+    def sample_watertight(
+        self,
+        resolutions,
+        tolerance=None,
+        angle_tolerance=None,
+        nthreads=None,
+    ):
+        """
+        Uniformly samples all patches, where vertices on interfaces are
+        only created once. Matching sample points are found using interface
+        orientations and merged if they coincide within tolerance. Interfaces
+        are determined if needed. Each vertex is evaluated once.
+
+        Parameters
+        -----------
+        resolutions: int
+        tolerance: float
+          Distance tolerance of merged sample points
+        angle_tolerance: float
+          Tolerance of interface orientations, see `interface_orientations()`
+        nthreads: int
+
+        Returns
+        --------
+        vertices: (n_vertices, dim) np.ndarray
+        connectivity: (n_patches * (resolutions - 1) ** para_dim,
+          2 ** para_dim) np.ndarray
+          Lines, quads or hexahedra in VTK ordering
+        """
+        if not isinstance(resolutions, int) and hasattr(
+            resolutions, "__getitem__"
+        ):
+            self._logd(
+                "sample_watertight() only supports uniform sample. Taking "
+                "first entry."
+            )
+            resolutions = int(resolutions[0])
+
+        return super().sample_watertight(
+            resolutions,
+            tolerance=_default_if_none(tolerance, _settings.TOLERANCE),
+            angle_tolerance=_default_if_none(
+                angle_tolerance, _settings.TOLERANCE
+            ),
+            nthreads=_default_if_none(nthreads, _settings.NTHREADS),
+        )
+
+    def _queries_and_patch_ids(self, queries, patch_ids):
+        """
+        Contiguous queries and patch ids for patch targeted queries. If
+        `patch_ids` is None, all queries are repeated for each patch, which
+        gives the same output layout as `evaluate()` without patch ids.
+
+        Parameters
+        -----------
+        queries: (n, para_dim) array-like
+        patch_ids: (n,) array-like or None
+
+        Returns
+        --------
+        queries: (n, para_dim) or (n_patches * n, para_dim) np.ndarray
+        patch_ids: (n,) or (n_patches * n,) np.ndarray
+        """
+        queries = _np.ascontiguousarray(queries, dtype="float64")
+        if patch_ids is not None:
+            return queries, _np.ascontiguousarray(patch_ids, dtype="int32")
+
+        n_patches = len(self.patches)
+        return (
+            _np.ascontiguousarray(_np.tile(queries, (n_patches, 1))),
+            _np.repeat(
+                _np.arange(n_patches, dtype="int32"), queries.shape[0]
+            ),
+        )
+
+    def evaluate(self, queries, nthreads=None, patch_ids=None):
         """
         Evaluate each individual spline at specific parametric positions. To be
         used with caution, as there is no check if the queries are within the
         parametric bounds if settings.CHECK_BOUNDS is set to false.
 
+        If `patch_ids` is given, each query is only evaluated at its own patch.
+
         Parameters
         -----------
         queries: (n, para_dim) array-like
         nthreads: int
+        patch_ids: (n,) array-like
+          Default is None, which evaluates all queries at all patches
 
         Returns
         --------
-        results: (math.product(resolutions), dim) np.ndarray
+        results: (n_patches * n, dim) or (n, dim) np.ndarray
         """
+        if patch_ids is not None:
+            return super().evaluate_patches(
+                _np.ascontiguousarray(queries, dtype="float64"),
+                patch_ids=_np.ascontiguousarray(patch_ids, dtype="int32"),
+                nthreads=_default_if_none(nthreads, _settings.NTHREADS),
+            )
 
         return super().evaluate(
             queries,
             nthreads=_default_if_none(nthreads, _settings.NTHREADS),
         )
 
+    def evaluate_with_fields(self, queries, nthreads=None, patch_ids=None):
+        """
+        Evaluates geometry and all fields at once. Basis functions are
+        computed once per query and patch and shared with all fields that
+        have the same basis as the geometry patch. Other fields are evaluated
+        directly and null splines yield zeros.
+
+        Parameters
+        -----------
+        queries: (n, para_dim) array-like
+        nthreads: int
+        patch_ids: (n,) array-like
+          Default is None, which evaluates all queries at all patches
+
+        Returns
+        --------
+        geometry: (n_patches * n, dim) or (n, dim) np.ndarray
+        fields: list
+          (n_patches * n, field_dim) or (n, field_dim) np.ndarray per field
+        """
+        if patch_ids is not None:
+            patch_ids = _np.ascontiguousarray(patch_ids, dtype="int32")
+
+        evaluated = super().evaluate_with_fields(
+            _np.ascontiguousarray(queries, dtype="float64"),
+            patch_ids=patch_ids,
+            nthreads=_default_if_none(nthreads, _settings.NTHREADS),
+        )
+
+        return evaluated[0], list(evaluated[1:])
+
+    def derivative(self, queries, orders, nthreads=None, patch_ids=None):
+        """
+        Evaluates derivatives of each individual spline. If `patch_ids` is
+        given, each query is only evaluated at its own patch.
+
+        Parameters
+        -----------
+        queries: (n, para_dim) array-like
+        orders: (para_dim,) or (m, para_dim) array-like
+        nthreads: int
+        patch_ids: (n,) array-like
+          Default is None, which evaluates all queries at all patches
+
+        Returns
+        --------
+        results: (n_patches * n, dim) or (n_patches * n, m, dim) or
+          (n, dim) or (n, m, dim) np.ndarray
+        """
+        queries, patch_ids = self._queries_and_patch_ids(queries, patch_ids)
+        return super().derivative_patches(
+            queries,
+            patch_ids=patch_ids,
+            orders=_np.ascontiguousarray(orders, dtype="int32"),
+            nthreads=_default_if_none(nthreads, _settings.NTHREADS),
+        )
+
+    def jacobian(self, queries, nthreads=None, patch_ids=None):
+        """
+        Evaluates jacobians of each individual spline. If `patch_ids` is
+        given, each query is only evaluated at its own patch.
+
+        Parameters
+        -----------
+        queries: (n, para_dim) array-like
+        nthreads: int
+        patch_ids: (n,) array-like
+          Default is None, which evaluates all queries at all patches
+
+        Returns
+        --------
+        jacobians: (n_patches * n, dim, para_dim) or (n, dim, para_dim)
+          np.ndarray
+        """
+        queries, patch_ids = self._queries_and_patch_ids(queries, patch_ids)
+        return super().jacobian_patches(
+            queries,
+            patch_ids=patch_ids,
+            nthreads=_default_if_none(nthreads, _settings.NTHREADS),
+        )
+
+    def basis_and_support(self, queries, nthreads=None, patch_ids=None):
+        """
+        Evaluates basis functions and their support of each individual
+        spline. If `patch_ids` is given, each query is only evaluated at its
+        own patch. Support ids are local to each patch. All queried patches
+        should have the same number of supports.
+
+        Parameters
+        -----------
+        queries: (n, para_dim) array-like
+        nthreads: int
+        patch_ids: (n,) array-like
+          Default is None, which evaluates all queries at all patches
+
+        Returns
+        --------
+        basis: (n_patches * n, n_support) or (n, n_support) np.ndarray
+        support: (n_patches * n, n_support) or (n, n_support) np.ndarray
+        """
+        queries, patch_ids = self._queries_and_patch_ids(queries, patch_ids)
+        return super().basis_and_support_patches(
+            queries,
+            patch_ids=patch_ids,
+            nthreads=_default_if_none(nthreads, _settings.NTHREADS),
+        )
+
+    def interface_orientations(self, tolerance=None, nthreads=None):
+        """
+        Orientations of all interfaces, e.g., for gismo export. Each interface
+        is listed once, starting from the face with the lower global face id.
+        Jacobians are evaluated once per face and shared between interfaces.
+        Interfaces are determined if needed.
+
+        Parameters
+        ----------
+        tolerance : float
+        nthreads : int
+
+        Returns
+        -------
+        base_ids : (n,) np.ndarray
+        base_face_ids : (n,) np.ndarray
+        neighbor_ids : (n,) np.ndarray
+        neighbor_face_ids : (n,) np.ndarray
+        axis_mappings : (n, para_dim) np.ndarray
+        axis_orientations : (n, para_dim) np.ndarray
+        """
+        return super().interface_orientations(
+            tolerance=_default_if_none(tolerance, _settings.TOLERANCE),
+            nthreads=_default_if_none(nthreads, _settings.NTHREADS),
+        )
+
+    def partition(
+        self, n_parts, weights="control_points", renumber=False, nthreads=None
+    ):
+        """
+        Partitions patches for parallel processing using recursive bisection
+        of the patch adjacency graph. Each part gets roughly the same weight,
+        while the number of interfaces between parts is kept small.
+        Interfaces are determined if needed.
+
+        Parameters
+        ----------
+        n_parts : int
+        weights : str or (n_patches,) array-like
+          "uniform", "control_points" (default), "elements" or custom patch
+          weights
+        renumber : bool
+          If True, also returns a patch order that groups patches by part and
+          keeps neighbors close, i.e., `[patches[i] for i in order]`
+        nthreads : int
+
+        Returns
+        -------
+        parts : (n_patches,) np.ndarray
+          Part id of each patch
+        order : (n_patches,) np.ndarray
+          Only if `renumber` is True
+        """
+        if not isinstance(weights, str):
+            weights = _np.ascontiguousarray(weights, dtype="float64")
+
+        return super().partition(
+            n_parts=n_parts,
+            weights=weights,
+            renumber=renumber,
+            nthreads=_default_if_none(nthreads, _settings.NTHREADS),
+        )
+
+    def global_control_point_ids(self, tolerance=None, nthreads=None):
+        """
+        Global numbering of control points, where coincident control points
+        on interfaces share the same id, e.g., for assembly or watertight
+        export. Face control points are mapped using interface orientations.
+        For non-conforming interfaces, coincident control points are searched
+        within tolerance. Interfaces are determined if needed.
+
+        Parameters
+        ----------
+        tolerance : float
+        nthreads : int
+
+        Returns
+        -------
+        local_to_global : (n_control_points,) np.ndarray
+          Global id of each control point, stacked in patch order
+        n_unique : int
+          Number of unique control points
+        """
+        return super().global_control_point_ids(
+            tolerance=_default_if_none(tolerance, _settings.TOLERANCE),
+            nthreads=_default_if_none(nthreads, _settings.NTHREADS),
+        )
+
+    def basis_matrix(
+        self,
+        queries,
+        patch_ids,
+        orders=None,
+        merge=False,
+        tolerance=None,
+        as_array=False,
+        nthreads=None,
+    ):
+        """
+        Global basis (or basis derivative) matrix. Row i contains basis
+        functions of query i evaluated at its patch `patch_ids[i]`. Columns
+        refer to stacked control points (see `control_point_offsets()`) or, if
+        `merge` is set, to unique control points (see
+        `global_control_point_ids()`). Then,
+        `basis_matrix(q, p) @ control_points` evaluates each query at its
+        patch.
+
+        Parameters
+        ----------
+        queries : (n, para_dim) array-like
+        patch_ids : (n,) array-like
+        orders : (para_dim,) array-like
+          Default is None, which returns basis functions
+        merge : bool
+        tolerance : float
+          Tolerance for merging
+        as_array : bool
+          Returns dense numpy array
+        nthreads : int
+
+        Returns
+        -------
+        matrix : scipy.sparse.csr_array / np.ndarray
+          (n, n_control_points) or (n, n_unique) if merged
+        """
+        data, indices, indptr, n_columns = super().basis_matrix(
+            _np.ascontiguousarray(queries, dtype="float64"),
+            patch_ids=_np.ascontiguousarray(patch_ids, dtype="int32"),
+            orders=(
+                None
+                if orders is None
+                else _np.ascontiguousarray(orders, dtype="int32")
+            ),
+            merge=merge,
+            tolerance=_default_if_none(tolerance, _settings.TOLERANCE),
+            nthreads=_default_if_none(nthreads, _settings.NTHREADS),
+        )
+        shape = (len(indptr) - 1, n_columns)
+
+        if _utils.data.has_scipy and not as_array:
+            return _utils.data._scipy.sparse.csr_array(
+                (data, indices, indptr), shape=shape
+            )
+
+        matrix = _np.zeros(shape)
+        rows = _np.repeat(_np.arange(shape[0]), _np.diff(indptr))
+        _np.add.at(matrix, (rows, indices), data)
+        return matrix
+
+    def set_control_points(self, control_points, nthreads=None):
+        """
+        Sets control points of all patches at once. Control points are
+        stacked in patch order, where each patch starts at its entry of
+        `control_point_offsets()`. Number of control points of each patch
+        stays the same.
+
+        Parameters
+        -----------
+        control_points: (n, dim) array-like
+        nthreads: int
+
+        Returns
+        --------
+        None
+        """
+        super().set_control_points(
+            _np.ascontiguousarray(control_points, dtype="float64"),
+            nthreads=_default_if_none(nthreads, _settings.NTHREADS),
+        )
+
+    def signed_distance_field(
+        self,
+        bounds,
+        resolutions,
+        band_width=None,
+        sparse=False,
+        sample_resolution=None,
+        n_candidates=8,
+        tolerance=None,
+        max_iterations=-1,
+        nthreads=None,
+    ):
+        """
+        Samples signed distance to the boundary of this multipatch on a
+        regular grid. For volumetric multipatches (para_dim == dim), boundary
+        patches are extracted and distance is positive outside. If
+        para_dim == dim - 1, patches are taken as boundary and distance is
+        positive in the direction of their normals.
+
+        Boundaries are sampled once to plant a single kd-tree. Grid points
+        within `band_width` are refined with newton iterations, warm started
+        from the previous grid point along the first axis. Remaining grid
+        points keep the kd-tree distance.
+
+        Parameters
+        -----------
+        bounds: (2, dim) array-like
+          Lower and upper corners of the grid
+        resolutions: (dim,) array-like
+          Number of grid points in each dimension
+        band_width: float
+          Default is None, which refines every grid point
+        sparse: bool
+          If True, only returns grid points within the band. Requires
+          band_width
+        sample_resolution: int
+          Boundary sampling resolution per parametric dimension.
+          Default is 2 * max(resolutions).
+        n_candidates: int
+          Number of nearest samples to collect candidate boundaries from
+        tolerance: float
+        max_iterations: int
+          Default is (para_dim * 20)
+        nthreads: int
+
+        Returns
+        --------
+        distances: (math.product(resolutions),) np.ndarray
+          (only if not sparse) first dimension varies fastest
+        grid_ids: (n,) np.ndarray
+          (only if sparse) ids of grid points within the band
+        distances: (n,) np.ndarray
+          (only if sparse) respective signed distances
+        """
+        bounds = _np.ascontiguousarray(bounds, dtype="float64")
+        resolutions = _np.ascontiguousarray(resolutions, dtype="int32")
+
+        if sparse and band_width is None:
+            raise ValueError("sparse signed distance field needs band_width")
+
+        return super().signed_distance_field(
+            grid_bounds=bounds,
+            grid_resolutions=resolutions,
+            sample_resolution=_default_if_none(
+                sample_resolution, int(2 * resolutions.max())
+            ),
+            band_width=_default_if_none(band_width, -1.0),
+            n_candidates=n_candidates,
+            tolerance=_default_if_none(tolerance, _settings.TOLERANCE),
+            max_iterations=max_iterations,
+            sparse=sparse,
+            nthreads=_default_if_none(nthreads, _settings.NTHREADS),
+        )
+
+    def locate_points(
+        self,
+        queries,
+        sample_resolution=None,
+        tolerance=None,
+        newton_tolerance=None,
+        max_iterations=-1,
+        nthreads=None,
+    ):
+        """
+        Finds the patch that contains each physical query point and the
+        respective parametric coordinate. Only for volumetric multipatches
+        (para_dim == dim).
+
+        Candidate patches are found with control point bounding boxes and
+        checked with inverse mapping (see `Spline.proximities()`). Points on
+        interfaces are assigned to the patch with the lowest id. Bounding
+        boxes and kd-trees are kept for following calls with the same
+        `sample_resolution` and `tolerance`. If control points of individual
+        patches are modified in place, set patches again to rebuild them.
+
+        Parameters
+        -----------
+        queries: (n, dim) array-like
+        sample_resolution: int
+          Sampling resolution per parametric dimension to plant kd-trees for
+          initial guesses. Default is 2 * control_mesh_resolutions
+        tolerance: float
+          Distance tolerance to be considered inside
+        newton_tolerance: float
+          Convergence tolerance of inverse mapping. Default is
+          settings.TOLERANCE
+        max_iterations: int
+          Default is (para_dim * 20)
+        nthreads: int
+
+        Returns
+        --------
+        patch_ids: (n,) np.ndarray
+          -1 if point is not inside of any patch
+        para_coords: (n, para_dim) np.ndarray
+          NaN if point is not inside of any patch
+        """
+        queries = _np.ascontiguousarray(queries, dtype="float64")
+
+        return super().locate_points(
+            queries=queries,
+            sample_resolution=_default_if_none(sample_resolution, -1),
+            tolerance=_default_if_none(tolerance, _settings.TOLERANCE),
+            newton_tolerance=_default_if_none(
+                newton_tolerance, _settings.TOLERANCE
+            ),
+            max_iterations=max_iterations,
+            nthreads=_default_if_none(nthreads, _settings.NTHREADS),
+        )
+
     @property
     def extract(self):
         """Return Extractor object to provide extract functionality for
@@ -44,3 +44,11 @@ CHECK_BOUNDS = True
 Bool to check bounds of queries if requested. Can be set to false to
 accelerate process
 """
+
+VIEW_BEZIER_CONTROL_POINTS = False
+"""
+Bool to let non-rational beziers reference the control point array saved in
+their `_data` instead of copying it into the core, as bsplines do. This
+saves a copy per spline. The core copies them on first use beyond queries,
+for example degree elevation.
+"""
@@ -704,10 +704,15 @@ class Spline(_SplinepyBase, _core.PySpline):
                 for kv in kvs
             ]
 
+        # opt-in, core only views control points of non-rational beziers
+        view = {}
+        if _settings.VIEW_BEZIER_CONTROL_POINTS:
+            view["view_control_points"] = True
+
         # Spline, you do whatever
         if type(self).__qualname__ == "Spline":
             # maybe minimal set check?
-            super()._new_core(**kwargs)
+            super()._new_core(**kwargs, **view)
 
         # specified ones needs specific sets of kwargs
         # in case of an incomplete set of kwargs, nothing will happen
@@ -718,7 +723,7 @@ class Spline(_SplinepyBase, _core.PySpline):
                 if k in rp:
                     rp_dict[k] = v
 
-            super()._new_core(**rp_dict)
+            super()._new_core(**rp_dict, **view)
 
         elif raise_:
             raise RuntimeError(
@@ -736,14 +741,19 @@ class Spline(_SplinepyBase, _core.PySpline):
         # clear saved data
         if not keep_properties:
             # BSpline supports viewing-control-points for contiguous arrays
-            # such as np.ndarray, so we need to keep it alive.
-            if self.name.startswith("BSpline"):
+            # such as np.ndarray, so we need to keep it alive. So do bezier
+            # views.
+            if (
+                self.name.startswith("BSpline")
+                or self._views_control_points
+            ):
                 saved_cps = self._data.get("control_points", None)
                 self._data = {}
                 if saved_cps is not None:
                     self._logw(
                         "_new_core(keep_properties=False) -",
-                        "BSplines need to keep control_points.",
+                        "BSplines and bezier views need to keep",
+                        "control_points.",
                         "Properties excluding control_points will be cleared.",
                     )
                     self._data["control_points"] = saved_cps
@@ -1398,6 +1408,7 @@ class Spline(_SplinepyBase, _core.PySpline):
         aggressive_search_bounds=False,
         nthreads=None,
         return_verbose=False,
+        return_statistics=False,
     ):
         """
         Given physical coordinate, finds a parametric coordinate that maps to
@@ -1431,6 +1442,12 @@ class Spline(_SplinepyBase, _core.PySpline):
         nthreads: int
         return_verbose : bool
           If False, returns only parametric coords
+        return_statistics : bool
+          If True, additionally returns a dict with kd-tree and newton
+          statistics of this query, e.g., number of iterations per query,
+          bound hits and timings in seconds. Counters are kept per spline
+          and reset at each call, so concurrent calls on the same spline
+          share them.
 
         Returns
         --------
@@ -1448,6 +1465,8 @@ class Spline(_SplinepyBase, _core.PySpline):
           (only if return_verbose) Convergence information
         second_derivatives: (n, para_dim, para_dim, dim) np.ndarray
           (only if return_verbose) Convergence information
+        statistics: dict
+          (only if return_statistics) Query statistics
         """
         self._logd("Searching for nearest parametric coord")
 
@@ -1467,8 +1486,16 @@ class Spline(_SplinepyBase, _core.PySpline):
             max_iterations=max_iterations,
             aggressive_search_bounds=aggressive_search_bounds,
             nthreads=_default_if_none(nthreads, _settings.NTHREADS),
+            return_statistics=return_statistics,
         )
 
+        if return_statistics:
+            statistics = verbose_info[-1]
+            verbose_info = verbose_info[:-1]
+            if return_verbose:
+                return verbose_info, statistics
+            return verbose_info[0], statistics
+
         if return_verbose:
             return verbose_info
         else:
@@ -1643,7 +1670,9 @@ class Spline(_SplinepyBase, _core.PySpline):
 
     def copy(self, saved_data=True):
         """
-        Returns deepcopy of stored data and newly initialized self.
+        Returns deepcopy of stored data and newly initialized self. The new
+        core shares knot vectors and control points with this spline's core
+        until one of them modifies them.
 
         Parameters
         -----------
@@ -1655,10 +1684,9 @@ class Spline(_SplinepyBase, _core.PySpline):
         --------
         new_spline: type(self)
         """
-        new = type(self)(**self.current_core_properties())
+        new = type(self)(spline=self._copy_core())
 
-        # new's _data is populated with current_core_properties(), which they
-        # own. So we will add to that
+        # required properties are prepared from new's own core on access
         if saved_data:
             required_properties = self.required_properties
             for k, v in self._data.items():
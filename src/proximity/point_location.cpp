@@ -0,0 +1,278 @@
+#include "splinepy/proximity/point_location.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "splinepy/utils/nthreads.hpp"
+#include "splinepy/utils/print.hpp"
+
+namespace splinepy::proximity {
+
+PointLocation::PointLocation(const Patches_& patches,
+                             const int sample_resolution,
+                             const double tolerance,
+                             const int n_thread)
+    : patches_(patches),
+      sample_resolution_(sample_resolution),
+      tolerance_(tolerance) {
+  const int n_patches = static_cast<int>(patches_.size());
+  if (n_patches < 1) {
+    splinepy::utils::PrintAndThrowError(
+        "PointLocation requires at least one patch.");
+  }
+
+  para_dim_ = patches_[0]->SplinepyParaDim();
+  dim_ = patches_[0]->SplinepyDim();
+
+  for (int i{}; i < n_patches; ++i) {
+    if (patches_[i]->SplinepyParaDim() != dim_
+        || patches_[i]->SplinepyDim() != dim_) {
+      splinepy::utils::PrintAndThrowError(
+          "PointLocation requires volumetric patches with para_dim == dim ==",
+          dim_,
+          ". Patch (",
+          i,
+          ") does not match.");
+    }
+  }
+
+  // bounding boxes and kdtrees
+  patch_bounds_.resize(n_patches * 2 * dim_);
+  proximities_.resize(n_patches);
+
+  auto prepare_patches = [&](const int begin, const int end, int) {
+    DoubleVector_ control_points;
+    IntVector_ resolutions(para_dim_);
+
+    for (int i{begin}; i < end; ++i) {
+      const auto& patch = *patches_[i];
+
+      // control points bound the patch - convex hull property
+      const int n_cps = patch.SplinepyNumberOfControlPoints();
+      control_points.resize(n_cps * dim_);
+      patch.SplinepyCurrentProperties(nullptr,
+                                      nullptr,
+                                      control_points.data(),
+                                      nullptr);
+
+      double* lower = &patch_bounds_[i * 2 * dim_];
+      double* upper = lower + dim_;
+      std::copy_n(control_points.data(), dim_, lower);
+      std::copy_n(control_points.data(), dim_, upper);
+      for (int j{1}; j < n_cps; ++j) {
+        for (int k{}; k < dim_; ++k) {
+          const double& c = control_points[j * dim_ + k];
+          lower[k] = std::min(lower[k], c);
+          upper[k] = std::max(upper[k], c);
+        }
+      }
+
+      // kdtree for initial guess
+      if (sample_resolution > 0) {
+        std::fill(resolutions.begin(), resolutions.end(), sample_resolution);
+      } else {
+        patch.SplinepyControlMeshResolutions(resolutions.data());
+        for (auto& r : resolutions) {
+          r = std::max(2, 2 * r);
+        }
+      }
+      proximities_[i] = std::make_unique<Proximity>(patch);
+      proximities_[i]->PlantNewKdTree(resolutions.data(), 1);
+    }
+  };
+  splinepy::utils::NThreadExecution(prepare_patches, n_patches, n_thread);
+
+  // cell grid over all bounding boxes
+  grid_bounds_.resize(2 * dim_);
+  grid_resolutions_.resize(dim_);
+  cell_sizes_.resize(dim_);
+  std::copy_n(patch_bounds_.data(), 2 * dim_, grid_bounds_.data());
+  for (int i{1}; i < n_patches; ++i) {
+    const double* patch_bounds = &patch_bounds_[i * 2 * dim_];
+    for (int k{}; k < dim_; ++k) {
+      grid_bounds_[k] = std::min(grid_bounds_[k], patch_bounds[k]);
+      grid_bounds_[dim_ + k] =
+          std::max(grid_bounds_[dim_ + k], patch_bounds[dim_ + k]);
+    }
+  }
+
+  // roughly one patch per cell
+  const int resolution = std::max(
+      1,
+      static_cast<int>(std::ceil(
+          std::pow(static_cast<double>(n_patches), 1. / dim_))));
+  int n_cells{1};
+  for (int k{}; k < dim_; ++k) {
+    const double length = grid_bounds_[dim_ + k] - grid_bounds_[k];
+    if (length > 0.) {
+      grid_resolutions_[k] = resolution;
+      cell_sizes_[k] = length / resolution;
+    } else {
+      grid_resolutions_[k] = 1;
+      cell_sizes_[k] = 1.;
+    }
+    n_cells *= grid_resolutions_[k];
+  }
+
+  // register patches to each cell they overlap. Cell ranges are computed in
+  // parallel, filling is serial to keep ascending patch ids per cell
+  IntVector_ cell_ranges(n_patches * 2 * dim_);
+  auto compute_cell_ranges = [&](const int begin, const int end, int) {
+    for (int i{begin}; i < end; ++i) {
+      const double* patch_bounds = &patch_bounds_[i * 2 * dim_];
+      int* ranges = &cell_ranges[i * 2 * dim_];
+      for (int k{}; k < dim_; ++k) {
+        const auto to_cell = [&](const double x) {
+          const int c = static_cast<int>(
+              std::floor((x - grid_bounds_[k]) / cell_sizes_[k]));
+          return std::clamp(c, 0, grid_resolutions_[k] - 1);
+        };
+        ranges[k] = to_cell(patch_bounds[k] - tolerance_);
+        ranges[dim_ + k] = to_cell(patch_bounds[dim_ + k] + tolerance_);
+      }
+    }
+  };
+  splinepy::utils::NThreadExecution(compute_cell_ranges, n_patches, n_thread);
+
+  std::vector<IntVector_> cell_patches(n_cells);
+  IntVector_ cell_index(dim_);
+  for (int i{}; i < n_patches; ++i) {
+    const int* ranges = &cell_ranges[i * 2 * dim_];
+    std::copy_n(ranges, dim_, cell_index.data());
+
+    // iterate all cells within ranges
+    bool done{false};
+    while (!done) {
+      int cell_id{}, stride{1};
+      for (int k{}; k < dim_; ++k) {
+        cell_id += cell_index[k] * stride;
+        stride *= grid_resolutions_[k];
+      }
+      cell_patches[cell_id].push_back(i);
+
+      // increment multi index
+      done = true;
+      for (int k{}; k < dim_; ++k) {
+        if (cell_index[k] < ranges[dim_ + k]) {
+          ++cell_index[k];
+          done = false;
+          break;
+        }
+        cell_index[k] = ranges[k];
+      }
+    }
+  }
+
+  // compress
+  cell_offsets_.resize(n_cells + 1);
+  cell_offsets_[0] = 0;
+  for (int i{}; i < n_cells; ++i) {
+    cell_offsets_[i + 1] =
+        cell_offsets_[i] + static_cast<int>(cell_patches[i].size());
+  }
+  cell_patch_ids_.resize(cell_offsets_[n_cells]);
+  for (int i{}; i < n_cells; ++i) {
+    std::copy(cell_patches[i].begin(),
+              cell_patches[i].end(),
+              cell_patch_ids_.begin() + cell_offsets_[i]);
+  }
+}
+
+int PointLocation::CellId(const double* point) const {
+  int cell_id{}, stride{1};
+  for (int k{}; k < dim_; ++k) {
+    const double& lower = grid_bounds_[k];
+    const double& upper = grid_bounds_[dim_ + k];
+    if (point[k] < lower - tolerance_ || point[k] > upper + tolerance_) {
+      return -1;
+    }
+    const int cell_index = std::clamp(
+        static_cast<int>(std::floor((point[k] - lower) / cell_sizes_[k])),
+        0,
+        grid_resolutions_[k] - 1);
+    cell_id += cell_index * stride;
+    stride *= grid_resolutions_[k];
+  }
+  return cell_id;
+}
+
+int PointLocation::Locate(const double* query,
+                          const double newton_tolerance,
+                          const int max_iterations,
+                          Workspace& workspace,
+                          double* para_coord) const {
+  const int cell_id = CellId(query);
+  if (cell_id < 0) {
+    return -1;
+  }
+
+  for (int i{cell_offsets_[cell_id]}; i < cell_offsets_[cell_id + 1]; ++i) {
+    const int patch_id = cell_patch_ids_[i];
+
+    // bounding box check
+    const double* lower = &patch_bounds_[patch_id * 2 * dim_];
+    const double* upper = lower + dim_;
+    bool in_box{true};
+    for (int k{}; k < dim_; ++k) {
+      if (query[k] < lower[k] - tolerance_
+          || query[k] > upper[k] + tolerance_) {
+        in_box = false;
+        break;
+      }
+    }
+    if (!in_box) {
+      continue;
+    }
+
+    // inverse mapping
+    double distance, convergence_norm;
+    proximities_[patch_id]->VerboseQuery(
+        query,
+        newton_tolerance,
+        max_iterations,
+        false,
+        workspace.guess.data(),
+        workspace.nearest.data(),
+        workspace.difference.data(),
+        distance,
+        convergence_norm,
+        workspace.first_derivatives.data(),
+        workspace.second_derivatives.data());
+
+    if (distance < tolerance_) {
+      std::copy_n(workspace.guess.data(), para_dim_, para_coord);
+      return patch_id;
+    }
+  }
+
+  return -1;
+}
+
+void PointLocation::LocateMany(const double* queries,
+                               const int n_queries,
+                               const double newton_tolerance,
+                               const int max_iterations,
+                               const int n_thread,
+                               int* patch_ids,
+                               double* para_coords) const {
+  auto locate = [&](const int begin, const int end, int) {
+    Workspace workspace(para_dim_, dim_);
+    for (int i{begin}; i < end; ++i) {
+      double* para_coord = &para_coords[i * para_dim_];
+      patch_ids[i] = Locate(&queries[i * dim_],
+                            newton_tolerance,
+                            max_iterations,
+                            workspace,
+                            para_coord);
+      if (patch_ids[i] < 0) {
+        std::fill_n(para_coord,
+                    para_dim_,
+                    std::numeric_limits<double>::quiet_NaN());
+      }
+    }
+  };
+  splinepy::utils::NThreadExecution(locate, n_queries, n_thread);
+}
+
+} // namespace splinepy::proximity
@@ -1,11 +1,78 @@
 #include "splinepy/proximity/proximity.hpp"
+
+#include <chrono>
+
 #include "splinepy/splines/helpers/properties.hpp"
 #include "splinepy/utils/nthreads.hpp"
 #include "splinepy/utils/print.hpp"
+#include "splinepy/utils/scratch_arena.hpp"
+#include "splinepy/utils/small_matrix.hpp"
 
 namespace splinepy::proximity {
 
+namespace {
+using Clock_ = std::chrono::steady_clock;
+
+/// @brief elapsed nanoseconds since start
+long long ElapsedNanoseconds(const Clock_::time_point& start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock_::now()
+                                                              - start)
+      .count();
+}
+
+/// @brief Closed form solution of fixed size newton system
+template<int para_dim>
+bool SolveSmallSystem(const Proximity::RealArray2D_& lhs,
+                      const Proximity::RealArray_& rhs,
+                      Proximity::RealArray_& x) {
+  splinepy::utils::SmallMatrix<double, para_dim> small_lhs;
+  small_lhs.CopyFrom(lhs.data());
+  splinepy::utils::SmallVector<double, para_dim> small_rhs, small_x;
+  std::copy_n(rhs.data(), para_dim, small_rhs.begin());
+
+  if (!splinepy::utils::Solve(small_lhs, small_rhs, small_x)) {
+    return false;
+  }
+  std::copy_n(small_x.begin(), para_dim, x.data());
+  return true;
+}
+
+/// @brief Solves newton system in closed form for para_dim up to 3.
+/// @return false if para_dim is larger or the system is singular
+bool SolveSmallSystem(const int para_dim,
+                      const Proximity::RealArray2D_& lhs,
+                      const Proximity::RealArray_& rhs,
+                      Proximity::RealArray_& x) {
+  switch (para_dim) {
+  case 1:
+    return SolveSmallSystem<1>(lhs, rhs, x);
+  case 2:
+    return SolveSmallSystem<2>(lhs, rhs, x);
+  case 3:
+    return SolveSmallSystem<3>(lhs, rhs, x);
+  default:
+    return false;
+  }
+}
+} // namespace
+
+void Proximity::Statistics::Reset() {
+  n_kdtree_plantings = 0;
+  n_samples = 0;
+  sampling_time = 0;
+  kdtree_build_time = 0;
+  n_queries = 0;
+  n_iterations = 0;
+  n_max_iterations_reached = 0;
+  n_bound_hits = 0;
+  n_evaluations = 0;
+  n_derivative_evaluations = 0;
+  query_time = 0;
+}
+
 void Proximity::PlantNewKdTree(const int* resolutions, const int n_thread) {
+  const auto sampling_start = Clock_::now();
+
   const int para_dim = spline_.SplinepyParaDim();
   const int dim = spline_.SplinepyDim();
 
@@ -23,7 +90,8 @@ void Proximity::PlantNewKdTree(const int* resolutions, const int n_thread) {
 
   // lambda function to allow n-thread execution
   auto sample_coordinates = [&](const int begin, const int end, int) {
-    RealArray_ query(para_dim);
+    splinepy::utils::ScratchScope scratch;
+    RealArray_ query = scratch.MakeArray<double>(para_dim);
     double* query_data = query.data();
 
     for (int i{begin}; i < end; ++i) {
@@ -35,6 +103,8 @@ void Proximity::PlantNewKdTree(const int* resolutions, const int n_thread) {
   // n-thread execution for sampling
   splinepy::utils::NThreadExecution(sample_coordinates, n_queries, n_thread);
 
+  const auto build_start = Clock_::now();
+
   // nanoflann supports concurrent build
   nanoflann::KDTreeSingleIndexAdaptorParams params{};
   params.n_thread_build = static_cast<
@@ -46,6 +116,16 @@ void Proximity::PlantNewKdTree(const int* resolutions, const int n_thread) {
                                     sampled_spline_.size(),
                                     dim);
   kdtree_ = std::make_unique<Tree_>(dim, *cloud_, params);
+
+  if (record_statistics_) {
+    ++statistics_.n_kdtree_plantings;
+    statistics_.n_samples += n_queries;
+    statistics_.sampling_time +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(build_start
+                                                             - sampling_start)
+            .count();
+    statistics_.kdtree_build_time += ElapsedNanoseconds(build_start);
+  }
 }
 
 void Proximity::GuessMinusQuery(const RealArray_& guess,
@@ -88,7 +168,8 @@ void Proximity::FillSplineGradientAndRhs(const RealArray_& guess,
   const int para_dim = guess.size();
   const int dim = difference.size();
 
-  IndexArray_ derivative_query(para_dim);
+  splinepy::utils::ScratchScope scratch;
+  IndexArray_ derivative_query = scratch.MakeArray<int>(para_dim);
   derivative_query.Fill(0);
 
   // this is just to view and apply inner product
@@ -123,7 +204,8 @@ void Proximity::FillLhs(const RealArray_& guess,
   const int para_dim = guess.size();
   const int dim = difference.size();
 
-  IndexArray_ derivative_query(para_dim);
+  splinepy::utils::ScratchScope scratch;
+  IndexArray_ derivative_query = scratch.MakeArray<int>(para_dim);
   derivative_query.Fill(0);
 
   // derivative result is a view to the hessian array
@@ -176,7 +258,11 @@ void Proximity::VerboseQuery(
     double& distance,
     double& convergence_norm,
     double* first_derivatives /* spline jacobian */,
-    double* second_derivatives /* spline hessian */) const {
+    double* second_derivatives /* spline hessian */,
+    const bool warm_start,
+    int* n_iterations) const {
+  const auto query_start =
+      record_statistics_ ? Clock_::now() : Clock_::time_point{};
 
   const int para_dim = spline_.SplinepyParaDim();
   const int dim = spline_.SplinepyDim();
@@ -192,29 +278,34 @@ void Proximity::VerboseQuery(
   RealArray2D_ spline_gradient(first_derivatives, para_dim, dim);
   RealArray3D_ spline_hessian(second_derivatives, para_dim, para_dim, dim);
 
-  // allocate aux real arrays
-  RealArray2D_ lhs(para_dim, para_dim);
-  SystemMatrix system(lhs);
-  RealArray_ rhs(para_dim);
-  RealArray_ delta_guess(para_dim);
-  RealArray2D_ spline_gradient_AAt(para_dim, para_dim);
-  RealArray2D_ search_bounds(2, para_dim);
+  // aux arrays are views on the thread's scratch arena
+  splinepy::utils::ScratchScope scratch;
+  RealArray2D_ lhs = scratch.MakeArray<double>(para_dim, para_dim);
+  SystemMatrix system(lhs, scratch.Allocate<int>(para_dim));
+  RealArray_ rhs = scratch.MakeArray<double>(para_dim);
+  RealArray_ delta_guess = scratch.MakeArray<double>(para_dim);
+  RealArray2D_ spline_gradient_AAt =
+      scratch.MakeArray<double>(para_dim, para_dim);
+  RealArray2D_ search_bounds = scratch.MakeArray<double>(2, para_dim);
 
   // get pointers to beginning of each bound
   RealArray_ lower_bound(search_bounds.begin(), para_dim);
   RealArray_ upper_bound(search_bounds.begin() + para_dim, para_dim);
 
-  // allocate index arrays
-  IndexArray_ clipped(para_dim);
+  // index arrays
+  IndexArray_ clipped = scratch.MakeArray<int>(para_dim);
 
   // search_bounds is parametric bounds here
   spline_.SplinepyParametricBounds(search_bounds.data());
 
-  // initial guess
-  MakeInitialGuess(phys_query, current_guess);
+  // initial guess - warm start uses given final_guess as is
+  if (!warm_start) {
+    MakeInitialGuess(phys_query, current_guess);
+  }
 
   // Let's try aggressive search bounds
-  if (aggressive_bounds) {
+  // step size is only available once a kdtree is planted
+  if (aggressive_bounds && kdtree_) {
     // you need to be sure that you have sampled your spline fine enough
     for (int i{}; i < para_dim; ++i) {
       // adjust lower (0) and upper (1) bounds aggressively
@@ -242,20 +333,33 @@ void Proximity::VerboseQuery(
   // get maxiteration
   const int max_iter = max_iterations < 0 ? para_dim * 20 : max_iterations;
   // newton iterations
-  for (int i{}; i < max_iter; ++i) {
+  int i_iteration{};
+  bool hit_bound{false};
+  for (; i_iteration < max_iter; ++i_iteration) {
     // norm and distance check for convergence
     if (convergence_norm < norm_goal || distance < tolerance) {
       break;
     }
 
-    // solve systems using gauss elimination with partial pivoting
-    // this will alter lhs in place, but shouldn't reorder rows inplace
-    system.Solve(rhs, delta_guess);
+    // solve systems in closed form, if they are small enough. Otherwise,
+    // use gauss elimination with partial pivoting, which will alter lhs in
+    // place, but shouldn't reorder rows inplace
+    if (!SolveSmallSystem(para_dim, lhs, rhs, delta_guess)) {
+      system.Solve(rhs, delta_guess);
+    }
 
     // currently we just clip at the bounds
     // we need a more sophisticated update for stability
     current_guess.Add(delta_guess);
     current_guess.Clip(lower_bound, upper_bound, clipped);
+    if (record_statistics_ && !hit_bound) {
+      for (int j{}; j < para_dim; ++j) {
+        if (clipped[j] != 0) {
+          hit_bound = true;
+          break;
+        }
+      }
+    }
 
     // evaluate cost at current guess
     GuessMinusQuery(current_guess, phys_query, current_phys, difference);
@@ -280,6 +384,30 @@ void Proximity::VerboseQuery(
       std::copy_n(&spline_hessian(i, j, 0), dim, &spline_hessian(j, i, 0));
     }
   }
+
+  if (n_iterations) {
+    *n_iterations = i_iteration;
+  }
+
+  if (record_statistics_) {
+    // each assembly evaluates once, para_dim first derivatives and upper
+    // triangle of second derivatives
+    const long long n_assemblies = i_iteration + 1;
+    const long long n_derivatives = para_dim + para_dim * (para_dim + 1) / 2;
+
+    ++statistics_.n_queries;
+    statistics_.n_iterations += i_iteration;
+    if (i_iteration == max_iter
+        && !(convergence_norm < norm_goal || distance < tolerance)) {
+      ++statistics_.n_max_iterations_reached;
+    }
+    if (hit_bound) {
+      ++statistics_.n_bound_hits;
+    }
+    statistics_.n_evaluations += n_assemblies;
+    statistics_.n_derivative_evaluations += n_assemblies * n_derivatives;
+    statistics_.query_time += ElapsedNanoseconds(query_start);
+  }
 }
 
 } // namespace splinepy::proximity
@@ -0,0 +1,387 @@
+#include "splinepy/proximity/signed_distance.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+#include "splinepy/utils/nthreads.hpp"
+#include "splinepy/utils/print.hpp"
+
+namespace splinepy::proximity {
+
+namespace {
+
+/// @brief Resolves number of threads the same way NThreadExecution does, so
+/// that per-thread containers can be allocated. At least one.
+int ThreadContainerSize(const int n_thread) {
+  if (n_thread < 0) {
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+  return std::max(1, n_thread);
+}
+
+} // namespace
+
+SignedDistance::SignedDistance(const Boundaries_& boundaries,
+                               const double* normal_orientations,
+                               const int sample_resolution,
+                               const int n_thread)
+    : boundaries_(boundaries) {
+  const int n_boundaries = static_cast<int>(boundaries_.size());
+  if (n_boundaries < 1) {
+    splinepy::utils::PrintAndThrowError(
+        "SignedDistance requires at least one boundary spline.");
+  }
+
+  dim_ = boundaries_[0]->SplinepyDim();
+  para_dim_ = boundaries_[0]->SplinepyParaDim();
+
+  if (dim_ != 2 && dim_ != 3) {
+    splinepy::utils::PrintAndThrowError(
+        "SignedDistance is only supported for 2D and 3D boundaries.",
+        "Given dim:",
+        dim_);
+  }
+  for (int i{}; i < n_boundaries; ++i) {
+    const auto& boundary = boundaries_[i];
+    if (boundary->SplinepyParaDim() != dim_ - 1
+        || boundary->SplinepyDim() != dim_) {
+      splinepy::utils::PrintAndThrowError(
+          "Boundary spline (",
+          i,
+          ") should have para_dim of",
+          dim_ - 1,
+          "and dim of",
+          dim_,
+          ".");
+    }
+  }
+
+  // signs of normal vectors
+  normal_orientations_.resize(n_boundaries);
+  for (int i{}; i < n_boundaries; ++i) {
+    normal_orientations_[i] =
+        (normal_orientations == nullptr || !(normal_orientations[i] < 0.))
+            ? 1.
+            : -1.;
+  }
+
+  // proximity helpers and grid points for sampling
+  proximities_.resize(n_boundaries);
+  sample_grids_.resize(n_boundaries);
+  const IntVector_ resolutions(para_dim_, sample_resolution);
+
+  auto set_up = [&](const int begin, const int end, int) {
+    DoubleVector_ bounds(2 * para_dim_);
+    for (int i{begin}; i < end; ++i) {
+      proximities_[i] = std::make_unique<Proximity>(*boundaries_[i]);
+      boundaries_[i]->SplinepyParametricBounds(bounds.data());
+      sample_grids_[i].SetUp(para_dim_, bounds.data(), resolutions.data());
+    }
+  };
+  splinepy::utils::NThreadExecution(set_up, n_boundaries, n_thread);
+
+  // offsets of each boundary's samples
+  sample_offsets_.resize(n_boundaries + 1);
+  sample_offsets_[0] = 0;
+  for (int i{}; i < n_boundaries; ++i) {
+    sample_offsets_[i + 1] = sample_offsets_[i] + sample_grids_[i].Size();
+  }
+  const int n_samples = sample_offsets_[n_boundaries];
+
+  samples_.Reallocate(n_samples * dim_);
+  sample_normals_.Reallocate(n_samples * dim_);
+  sample_boundary_ids_.resize(n_samples);
+
+  // sample coordinates and normals
+  auto sample = [&](const int begin, const int end, int) {
+    DoubleVector_ para_coord(para_dim_), first_derivatives(para_dim_ * dim_);
+    IntVector_ derivative_query(para_dim_, 0);
+
+    for (int i{begin}; i < end; ++i) {
+      const auto& boundary = *boundaries_[i];
+      const auto& grid = sample_grids_[i];
+      const double orientation = normal_orientations_[i];
+
+      for (int j{sample_offsets_[i]}; j < sample_offsets_[i + 1]; ++j) {
+        grid.IdToGridPoint(j - sample_offsets_[i], para_coord.data());
+        boundary.SplinepyEvaluate(para_coord.data(), &samples_[j * dim_]);
+
+        // first derivatives - same layout as Proximity's spline_gradient
+        for (int k{}; k < para_dim_; ++k) {
+          derivative_query[k] = 1;
+          boundary.SplinepyDerivative(para_coord.data(),
+                                      derivative_query.data(),
+                                      &first_derivatives[k * dim_]);
+          derivative_query[k] = 0;
+        }
+
+        double* normal = &sample_normals_[j * dim_];
+        NormalFromFirstDerivatives(first_derivatives.data(), dim_, normal);
+        for (int k{}; k < dim_; ++k) {
+          normal[k] *= orientation;
+        }
+
+        sample_boundary_ids_[j] = i;
+      }
+    }
+  };
+  splinepy::utils::NThreadExecution(sample, n_boundaries, n_thread);
+
+  // plant a tree - same as Proximity::PlantNewKdTree
+  nanoflann::KDTreeSingleIndexAdaptorParams params{};
+  params.n_thread_build = static_cast<
+      decltype(nanoflann::KDTreeSingleIndexAdaptorParams::n_thread_build)>(
+      (n_thread < 0) ? 0 : n_thread);
+
+  cloud_ = std::make_unique<Cloud_>(samples_.data(), samples_.size(), dim_);
+  kdtree_ = std::make_unique<Tree_>(dim_, *cloud_, params);
+}
+
+void SignedDistance::NormalFromFirstDerivatives(
+    const double* first_derivatives,
+    const int dim,
+    double* normal) {
+  if (dim == 2) {
+    normal[0] = first_derivatives[1];
+    normal[1] = -first_derivatives[0];
+  } else {
+    const double* a = first_derivatives;
+    const double* b = &first_derivatives[3];
+    normal[0] = a[1] * b[2] - a[2] * b[1];
+    normal[1] = a[2] * b[0] - a[0] * b[2];
+    normal[2] = a[0] * b[1] - a[1] * b[0];
+  }
+}
+
+template<typename StoreFunc>
+void SignedDistance::SampleGridImpl(const double* grid_bounds,
+                                    const int* grid_resolutions,
+                                    const double band_width,
+                                    const int n_candidates,
+                                    const double tolerance,
+                                    const int max_iterations,
+                                    const int n_thread,
+                                    const StoreFunc& store) const {
+  const int n_boundaries = static_cast<int>(boundaries_.size());
+  const int n_neighbors =
+      std::max(1, std::min(n_candidates, NumberOfSamples()));
+  const bool refine_all = !(band_width > 0.);
+
+  // grid points - first dimension varies fastest, which is our grid line
+  splinepy::utils::GridPoints grid(dim_, grid_bounds, grid_resolutions);
+  const int line_length = grid_resolutions[0];
+  const int n_lines = grid.Size() / line_length;
+
+  auto sample_lines = [&](const int begin, const int end, const int i_thread) {
+    DoubleVector_ query(dim_);
+
+    // kdtree query results
+    IntVector_ knn_ids(n_neighbors);
+    DoubleVector_ knn_squared_distances(n_neighbors);
+
+    // candidate boundary ids and their closest sample ids
+    IntVector_ candidates, candidate_samples;
+    candidates.reserve(n_neighbors);
+    candidate_samples.reserve(n_neighbors);
+
+    // proximity outputs
+    DoubleVector_ nearest(dim_), difference(dim_),
+        first_derivatives(para_dim_ * dim_),
+        second_derivatives(para_dim_ * para_dim_ * dim_), normal(dim_);
+
+    // warm start - last closest parametric coordinate of each boundary and
+    // the grid line it was computed on
+    DoubleVector_ warm_guesses(n_boundaries * para_dim_);
+    IntVector_ warm_lines(n_boundaries, -1);
+
+    for (int i_line{begin}; i_line < end; ++i_line) {
+      for (int i_point{}; i_point < line_length; ++i_point) {
+        const int grid_id = i_line * line_length + i_point;
+        grid.IdToGridPoint(grid_id, query.data());
+
+        std::fill(knn_ids.begin(), knn_ids.end(), -1);
+        kdtree_->knnSearch(query.data(),
+                           n_neighbors,
+                           knn_ids.data(),
+                           knn_squared_distances.data());
+
+        const int closest = knn_ids[0];
+        const double kdtree_distance = std::sqrt(knn_squared_distances[0]);
+
+        // outside of the band - take kdtree distance and sign of the sample
+        if (!refine_all && kdtree_distance > band_width) {
+          const double* closest_sample = &samples_[closest * dim_];
+          const double* closest_normal = &sample_normals_[closest * dim_];
+          double dot{};
+          for (int k{}; k < dim_; ++k) {
+            dot += closest_normal[k] * (query[k] - closest_sample[k]);
+          }
+          store(i_thread,
+                grid_id,
+                (dot < 0.) ? -kdtree_distance : kdtree_distance,
+                false);
+          continue;
+        }
+
+        // unique candidate boundaries. knn results are sorted, so the first
+        // sample of each boundary is its closest one
+        candidates.clear();
+        candidate_samples.clear();
+        for (const int& sample_id : knn_ids) {
+          if (sample_id < 0) {
+            continue;
+          }
+          const int boundary_id = sample_boundary_ids_[sample_id];
+          if (std::find(candidates.begin(), candidates.end(), boundary_id)
+              == candidates.end()) {
+            candidates.push_back(boundary_id);
+            candidate_samples.push_back(sample_id);
+          }
+        }
+
+        // newton refinement on each candidate
+        double best_distance{std::numeric_limits<double>::max()};
+        double best_signed_distance{best_distance};
+        double best_alignment{-1.};
+        const int n_current_candidates = static_cast<int>(candidates.size());
+        for (int i_c{}; i_c < n_current_candidates; ++i_c) {
+          const int boundary_id = candidates[i_c];
+          double* guess = &warm_guesses[boundary_id * para_dim_];
+
+          // no warm start available - use sample's parametric coordinate
+          if (warm_lines[boundary_id] != i_line) {
+            sample_grids_[boundary_id].IdToGridPoint(
+                candidate_samples[i_c] - sample_offsets_[boundary_id],
+                guess);
+          }
+
+          double distance, convergence_norm;
+          proximities_[boundary_id]->VerboseQuery(query.data(),
+                                                  tolerance,
+                                                  max_iterations,
+                                                  false,
+                                                  guess,
+                                                  nearest.data(),
+                                                  difference.data(),
+                                                  distance,
+                                                  convergence_norm,
+                                                  first_derivatives.data(),
+                                                  second_derivatives.data(),
+                                                  true);
+          warm_lines[boundary_id] = i_line;
+
+          // sign from normal. difference is (nearest - query)
+          NormalFromFirstDerivatives(first_derivatives.data(),
+                                     dim_,
+                                     normal.data());
+          double dot{}, normal_norm{};
+          for (int k{}; k < dim_; ++k) {
+            dot -= normal[k] * difference[k];
+            normal_norm += normal[k] * normal[k];
+          }
+          dot *= normal_orientations_[boundary_id];
+
+          // alignment between normal and (query - nearest). At edges and
+          // corners, multiple boundaries share the closest point; the most
+          // aligned one gives the most reliable sign.
+          const double denominator = std::sqrt(normal_norm) * distance;
+          const double alignment =
+              (denominator > 0.) ? std::abs(dot) / denominator : 0.;
+
+          // distances within this range are considered a tie
+          const double tie = std::max(tolerance, 1e-10 * distance);
+          if ((distance < best_distance - tie)
+              || (distance < best_distance + tie
+                  && alignment > best_alignment)) {
+            best_distance = distance;
+            best_signed_distance = (dot < 0.) ? -distance : distance;
+            best_alignment = alignment;
+          }
+        }
+
+        store(i_thread, grid_id, best_signed_distance, true);
+      }
+    }
+  };
+
+  splinepy::utils::NThreadExecution(sample_lines, n_lines, n_thread);
+}
+
+void SignedDistance::SampleGrid(const double* grid_bounds,
+                                const int* grid_resolutions,
+                                const double band_width,
+                                const int n_candidates,
+                                const double tolerance,
+                                const int max_iterations,
+                                const int n_thread,
+                                double* distances) const {
+  SampleGridImpl(
+      grid_bounds,
+      grid_resolutions,
+      band_width,
+      n_candidates,
+      tolerance,
+      max_iterations,
+      n_thread,
+      [&](int, const int grid_id, const double value, bool) {
+        distances[grid_id] = value;
+      });
+}
+
+void SignedDistance::SampleGridSparse(const double* grid_bounds,
+                                      const int* grid_resolutions,
+                                      const double band_width,
+                                      const int n_candidates,
+                                      const double tolerance,
+                                      const int max_iterations,
+                                      const int n_thread,
+                                      IntVector_& grid_ids,
+                                      DoubleVector_& distances) const {
+  if (!(band_width > 0.)) {
+    splinepy::utils::PrintAndThrowError(
+        "Sparse signed distance sampling requires a positive band width.");
+  }
+
+  // each thread collects its own values. threads work on contiguous chunks
+  // of grid lines, so concatenating in thread order keeps grid ids sorted
+  const int n_containers = ThreadContainerSize(n_thread);
+  std::vector<IntVector_> thread_ids(n_containers);
+  std::vector<DoubleVector_> thread_distances(n_containers);
+
+  SampleGridImpl(grid_bounds,
+                 grid_resolutions,
+                 band_width,
+                 n_candidates,
+                 tolerance,
+                 max_iterations,
+                 n_thread,
+                 [&](const int i_thread,
+                     const int grid_id,
+                     const double value,
+                     const bool in_band) {
+                   if (in_band) {
+                     thread_ids[i_thread].push_back(grid_id);
+                     thread_distances[i_thread].push_back(value);
+                   }
+                 });
+
+  std::size_t n_total{};
+  for (const auto& ids : thread_ids) {
+    n_total += ids.size();
+  }
+
+  grid_ids.clear();
+  distances.clear();
+  grid_ids.reserve(n_total);
+  distances.reserve(n_total);
+  for (int i{}; i < n_containers; ++i) {
+    grid_ids.insert(grid_ids.end(), thread_ids[i].begin(), thread_ids[i].end());
+    distances.insert(distances.end(),
+                     thread_distances[i].begin(),
+                     thread_distances[i].end());
+  }
+}
+
+} // namespace splinepy::proximity
@@ -3,15 +3,34 @@
 
 #include <BSplineLib/ParameterSpaces/knot_vector.hpp>
 
+#include "splinepy/py/py_parameter_space.hpp"
 #include "splinepy/utils/print.hpp"
 
 namespace splinepy::py {
 
 namespace py = pybind11;
 
+/// @brief Binds const member function of KnotVector to PyKnotVector
+template<typename Return, typename... Args>
+auto ReadKnotVector(Return (bsplinelib::parameter_spaces::KnotVector::*method)(
+    Args...) const) {
+  return [method](const PyKnotVector& kv, Args... args) -> Return {
+    return ((*kv.Read()).*method)(args...);
+  };
+}
+
+/// @brief Binds member function of KnotVector, that may modify knots, to
+/// PyKnotVector
+template<typename Return, typename... Args>
+auto WriteKnotVector(
+    Return (bsplinelib::parameter_spaces::KnotVector::*method)(Args...)) {
+  return [method](const PyKnotVector& kv, Args... args) -> Return {
+    return ((*kv.Write()).*method)(args...);
+  };
+}
+
 void init_knot_vector(py::module_& m) {
   using KnotVector = bsplinelib::parameter_spaces::KnotVector;
-  using IterType = typename KnotVector::Knots_::iterator;
   using KnotType = typename KnotVector::Knots_::value_type;
   using DiffType = typename KnotVector::Knots_::difference_type;
   using SizeType = typename KnotVector::Knots_::size_type;
@@ -29,42 +48,47 @@ void init_knot_vector(py::module_& m) {
     return i;
   };
 
-  py::class_<KnotVector, std::shared_ptr<KnotVector>> klasse(m, "KnotVector");
+  py::class_<PyKnotVector> klasse(m, "KnotVector");
   klasse
       .def(
           "__len__",
-          [](const KnotVector& kv) { return kv.GetSize(); },
+          [](const PyKnotVector& kv) { return kv.Read()->GetSize(); },
           "Returns size if len(knot_vector) is called.")
       .def(
           "__iter__",
-          [](KnotVector& kv) {
-            return py::make_iterator<
-                py::return_value_policy::reference_internal,
-                IterType,
-                IterType,
-                KnotType&>(kv.GetKnots().begin(), kv.GetKnots().end());
+          [](const PyKnotVector& kv) {
+            // copies, as writes may replace a shared knot vector
+            const auto& knots = kv.Read()->GetKnots();
+            py::list items(knots.size());
+            for (SizeType i{}; i < knots.size(); ++i) {
+              items[i] = knots[i];
+            }
+            return py::iter(items);
           },
-          py::keep_alive<0, 1>(),
-          "Support iterations of element references.")
+          "Support iterations of knot values.")
       .def(
           "__getitem__",
-          [wrap_id](KnotVector& kv, DiffType i) -> KnotType& {
-            i = wrap_id(i, kv.GetKnots().size());
-            return kv.GetKnots()[static_cast<SizeType>(i)];
+          [wrap_id](const PyKnotVector& kv, DiffType i) -> KnotType {
+            const auto& knots = kv.Read()->GetKnots();
+            i = wrap_id(i, knots.size());
+            return knots[static_cast<SizeType>(i)];
           },
-          py::return_value_policy::reference_internal,
-          "int based __getitem__, which returns reference..")
+          "int based __getitem__, which returns knot value.")
       .def(
           "__getitem__",
-          [](const KnotVector& kv, const py::slice& slice) -> py::list {
+          [](const PyKnotVector& kv, const py::slice& slice) -> py::list {
+            const auto& knots = kv.Read()->GetKnots();
             std::size_t start{}, stop{}, step{}, slicelength{};
-            const auto kv_size = kv.GetKnots().size();
-            if (!slice.compute(kv_size, &start, &stop, &step, &slicelength)) {
+            if (!slice.compute(knots.size(),
+                               &start,
+                               &stop,
+                               &step,
+                               &slicelength)) {
               throw py::error_already_set();
             }
             py::list items{};
             for (std::size_t i{}; i < slicelength; ++i) {
-              items.append(kv[start]);
+              items.append(knots[start]);
               start += step;
             }
             return items;
@@ -73,16 +97,22 @@ void init_knot_vector(py::module_& m) {
           "support slice based __getitem__.")
       .def(
           "__setitem__",
-          [wrap_id](KnotVector& kv, DiffType i, const KnotType knot) {
-            i = wrap_id(i, kv.GetKnots().size());
-            kv.UpdateKnot(i, knot);
+          [wrap_id](const PyKnotVector& py_kv,
+                    DiffType i,
+                    const KnotType knot) {
+            auto kv = py_kv.Write();
+            i = wrap_id(i, kv->GetKnots().size());
+            kv->UpdateKnot(i, knot);
           },
           "Single knot assignment / modification.")
       .def(
           "__setitem__",
-          [](KnotVector& kv, const py::slice& slice, const py::list& value) {
+          [](const PyKnotVector& py_kv,
+             const py::slice& slice,
+             const py::list& value) {
+            auto kv = py_kv.Write();
             std::size_t start{}, stop{}, step{}, slicelength{};
-            const auto kv_size = kv.GetKnots().size();
+            const auto kv_size = kv->GetKnots().size();
             if (!slice.compute(kv_size, &start, &stop, &step, &slicelength)) {
               throw py::error_already_set();
             }
@@ -91,21 +121,22 @@ void init_knot_vector(py::module_& m) {
                   "Left and right hand size of slice assignment have "
                   "different sizes.");
             }
-            auto& knots = kv.GetKnots();
+            auto& knots = kv->GetKnots();
             for (std::size_t i{}; i < slicelength; ++i) {
               knots[start] = py::cast<KnotType>(value[i]);
               start += step;
             }
-            kv.ThrowIfTooSmallOrNotNonDecreasing();
+            kv->ThrowIfTooSmallOrNotNonDecreasing();
           },
           "Multiple slice based element assignment.")
       .def(
           "__setitem__",
-          [](KnotVector& kv,
+          [](const PyKnotVector& py_kv,
              const py::slice& slice,
              const py::array_t<double>& value) {
+            auto kv = py_kv.Write();
             std::size_t start{}, stop{}, step{}, slicelength{};
-            const auto kv_size = kv.GetKnots().size();
+            const auto kv_size = kv->GetKnots().size();
             if (!slice.compute(kv_size, &start, &stop, &step, &slicelength)) {
               throw py::error_already_set();
             }
@@ -114,43 +145,48 @@ void init_knot_vector(py::module_& m) {
                   "Left and right hand size of slice assignment have "
                   "different sizes.");
             }
-            auto& knots = kv.GetKnots();
+            auto& knots = kv->GetKnots();
             const double* v_ptr = static_cast<double*>(value.request().ptr);
             for (std::size_t i{}; i < slicelength; ++i) {
               knots[start] = v_ptr[i];
               start += step;
             }
-            kv.ThrowIfTooSmallOrNotNonDecreasing();
+            kv->ThrowIfTooSmallOrNotNonDecreasing();
           },
           "Multiple slice based element assignment.")
       .def("__repr__",
-           [](const KnotVector& kv) { return kv.StringRepresentation(); })
+           [](const PyKnotVector& kv) {
+             return kv.Read()->StringRepresentation();
+           })
       .def("scale",
-           &KnotVector::Scale,
+           WriteKnotVector(&KnotVector::Scale),
            py::arg("min"),
            py::arg("max"),
            "Scales knot vector with given [min, max].")
       .def("find_span",
-           &KnotVector::FindSpan_,
+           ReadKnotVector(&KnotVector::FindSpan_),
            "Finds knot span of given parametric coordinate.")
       .def(
           "numpy",
-          [](const KnotVector& kv) {
-            py::array_t<KnotType> arr(kv.GetSize());
+          [](const PyKnotVector& py_kv) {
+            auto kv = py_kv.Read();
+            py::array_t<KnotType> arr(kv->GetSize());
             KnotType* arr_ptr = static_cast<KnotType*>(arr.request().ptr);
-            for (int i{}; i < kv.GetSize(); ++i) {
-              arr_ptr[i] = kv[i];
+            for (int i{}; i < kv->GetSize(); ++i) {
+              arr_ptr[i] = (*kv)[i];
             }
             return arr;
           },
           "Returns copy of knot vectors as numpy array.")
       .def(
           "__array__",
-          [](const KnotVector& kv, [[maybe_unused]] py::args dtype_ignored) {
-            py::array_t<KnotType> arr(kv.GetSize());
+          [](const PyKnotVector& py_kv,
+             [[maybe_unused]] py::args dtype_ignored) {
+            auto kv = py_kv.Read();
+            py::array_t<KnotType> arr(kv->GetSize());
             KnotType* arr_ptr = static_cast<KnotType*>(arr.request().ptr);
-            for (int i{}; i < kv.GetSize(); ++i) {
-              arr_ptr[i] = kv[i];
+            for (int i{}; i < kv->GetSize(); ++i) {
+              arr_ptr[i] = (*kv)[i];
             }
             return arr;
           },
@@ -158,8 +194,8 @@ void init_knot_vector(py::module_& m) {
           "creation.")
       .def(
           "unique",
-          [](const KnotVector& kv) -> py::array_t<KnotType> {
-            const KnotVector::Knots_& uniques = kv.GetUniqueKnots();
+          [](const PyKnotVector& kv) -> py::array_t<KnotType> {
+            const KnotVector::Knots_& uniques = kv.Read()->GetUniqueKnots();
             py::array_t<KnotType> arr(uniques.size());
             KnotType* arr_ptr = static_cast<KnotType*>(arr.request().ptr);
             for (int i{}; i < static_cast<int>(uniques.size()); ++i) {
@@ -170,9 +206,9 @@ void init_knot_vector(py::module_& m) {
           "Returns multiplicities of unique knots")
       .def(
           "multiplicities",
-          [](const KnotVector& kv) -> py::array_t<int> {
+          [](const PyKnotVector& kv) -> py::array_t<int> {
             const bsplinelib::Vector<int> multiplicities =
-                kv.DetermineMultiplicities();
+                kv.Read()->DetermineMultiplicities();
             py::array_t<int> arr(multiplicities.size());
             int* arr_ptr = static_cast<int*>(arr.request().ptr);
             for (int i{}; i < static_cast<int>(multiplicities.size()); ++i) {
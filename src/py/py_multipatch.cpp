@@ -1,16 +1,22 @@
 #include "splinepy/py/py_multipatch.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <mutex>
+#include <numeric>
 #include <stdexcept>
 #include <unordered_map>
 
 // splinepy
+#include "splinepy/proximity/point_location.hpp"
+#include "splinepy/proximity/signed_distance.hpp"
 #include "splinepy/splines/helpers/scalar_type_wrapper.hpp"
 #include "splinepy/splines/null_spline.hpp"
+#include "splinepy/utils/graph_partition.hpp"
 #include "splinepy/utils/grid_points.hpp"
 #include "splinepy/utils/nthreads.hpp"
 #include "splinepy/utils/print.hpp"
+#include "splinepy/utils/scratch_arena.hpp"
 
 namespace splinepy::py {
 
@@ -76,23 +82,44 @@ py::list ToPySplineList(CoreSplineVector& splist) {
   return pyspline_list;
 }
 
-template<typename T>
-IntVector ArgSort(const std::vector<T>& v) {
-  IntVector idx(v.size());
-  std::iota(idx.begin(), idx.end(), 0);
-  std::stable_sort(idx.begin(), idx.end(), [&v](int const& i1, int const& i2) {
-    return v[i1] < v[i2];
-  });
-  return idx;
+void GroupQueriesByPatch(const int* patch_ids,
+                         const int n_queries,
+                         const int n_patches,
+                         IntVector& offsets,
+                         IntVector& order) {
+  // count
+  offsets.assign(n_patches + 1, 0);
+  for (int i{}; i < n_queries; ++i) {
+    const int& patch_id = patch_ids[i];
+    if (patch_id < 0 || patch_id >= n_patches) {
+      splinepy::utils::PrintAndThrowError("Invalid patch id (",
+                                          patch_id,
+                                          ") for query (",
+                                          i,
+                                          "). Number of patches:",
+                                          n_patches);
+    }
+    ++offsets[patch_id + 1];
+  }
+  for (int i{}; i < n_patches; ++i) {
+    offsets[i + 1] += offsets[i];
+  }
+
+  // place
+  IntVector positions(offsets.begin(), offsets.end() - 1);
+  order.resize(n_queries);
+  for (int i{}; i < n_queries; ++i) {
+    order[positions[patch_ids[i]]++] = i;
+  }
 }
 
-void RaiseMismatch(const CoreSplineVector& splist,
-                   const std::string name,
-                   const int para_dim,
-                   const int dim,
-                   const IntVector& degrees,
-                   const IntVector& control_mesh_resolutions,
-                   const int nthreads) {
+std::string FindMismatch(const CoreSplineVector& splist,
+                         const std::string name,
+                         const int para_dim,
+                         const int dim,
+                         const IntVector& degrees,
+                         const IntVector& control_mesh_resolutions,
+                         const int nthreads) {
   // for verbose output
   std::unordered_map<std::string, IntVectorVector> mismatches{};
 
@@ -214,7 +241,7 @@ void RaiseMismatch(const CoreSplineVector& splist,
 
   // everything matches
   if (!raise) {
-    return;
+    return {};
   }
 
   // form mismatch info
@@ -226,7 +253,26 @@ void RaiseMismatch(const CoreSplineVector& splist,
     }
   }
 
-  splinepy::utils::PrintAndThrowError("Found mismatches.", mismatch_info);
+  return mismatch_info;
+}
+
+void RaiseMismatch(const CoreSplineVector& splist,
+                   const std::string name,
+                   const int para_dim,
+                   const int dim,
+                   const IntVector& degrees,
+                   const IntVector& control_mesh_resolutions,
+                   const int nthreads) {
+  const std::string mismatch_info = FindMismatch(splist,
+                                                 name,
+                                                 para_dim,
+                                                 dim,
+                                                 degrees,
+                                                 control_mesh_resolutions,
+                                                 nthreads);
+  if (!mismatch_info.empty()) {
+    splinepy::utils::PrintAndThrowError("Found mismatches.", mismatch_info);
+  }
 }
 
 void RaiseMismatch(const CoreSplineVector& splist0,
@@ -369,200 +415,158 @@ void RaiseMismatch(const CoreSplineVector& splist0,
   splinepy::utils::PrintAndThrowError("Found mismatches.", mismatch_info);
 }
 
-py::array_t<int>
-FindConnectivityFromCenters(const py::array_t<double>& face_center_vertices,
-                            const int parametric_dimension,
-                            const py::array_t<double>& metric,
-                            const double tolerance) {
-
-  // -- Auxiliary data --
-  const int number_of_element_faces = parametric_dimension * 2;
-  const int number_of_patches =
-      face_center_vertices.shape(0) / number_of_element_faces;
-  const int physical_dimension = face_center_vertices.shape(1);
-  const int number_of_center_vertices{
-      static_cast<int>(face_center_vertices.shape(0))};
-  const double tolerance_squared{tolerance * tolerance};
-  const double* metric_ptr = static_cast<double*>(metric.request().ptr);
-  const double* face_center_vertices_ptr =
-      static_cast<double*>(face_center_vertices.request().ptr);
-
-  // Consistency check
-  if (!(face_center_vertices.shape(0) % number_of_element_faces == 0)) {
-    splinepy::utils::PrintAndThrowError(
-        "Number of corner vertices invalid. Must be a multiple of the number "
-        "of vertices per patch");
-  }
-  if (!(metric.size() == face_center_vertices.shape(1))) {
-    splinepy::utils::PrintAndThrowError(
-        "Incompatible size for metric. Must match physical dimension of face "
-        "center vertices");
+void ConnectFaceCenters(const splinepy::utils::SpatialHash& face_centers,
+                        const int first_query,
+                        const double tolerance,
+                        const int nthreads,
+                        int* interfaces,
+                        IntVector& non_manifold_faces) {
+  const int n_faces = face_centers.Size();
+  const int n_queries = n_faces - first_query;
+  if (n_queries < 1) {
+    return;
   }
-  if (!(number_of_center_vertices % number_of_element_faces == 0)) {
+  if (face_centers.CellSize() < tolerance) {
     splinepy::utils::PrintAndThrowError(
-        "Inconsistent number of Center vertices. Must be divisible by "
-        "parametric_dimension*2");
+        "Cell size of spatial hash (",
+        face_centers.CellSize(),
+        ") should not be smaller than tolerance (",
+        tolerance,
+        ").");
   }
 
-  // Init return type
-  py::array_t<int> connectivity(number_of_patches * number_of_element_faces);
-  int* connectivity_ptr = static_cast<int*>(connectivity.request().ptr);
-  // Init connectivity and metric value
-  // (-1 : boundary, -2 : untouched)
-  std::fill(connectivity_ptr,
-            connectivity_ptr + number_of_patches * number_of_element_faces,
-            -2);
-
-  // Assure Metric is normed and non-zero
-  const std::vector<double>& normed_metric = [&metric_ptr,
-                                              &physical_dimension]() {
-    double euclidian_norm = 0.;
-    for (int i_phys{}; i_phys < physical_dimension; i_phys++) {
-      euclidian_norm += metric_ptr[i_phys] * metric_ptr[i_phys];
-    }
-    std::vector<double> metric(physical_dimension, 1.);
-    euclidian_norm = std::sqrt(euclidian_norm);
-    if (euclidian_norm < 1e-20) {
-      return metric;
-    } else {
-      const double inv_euclidian_norm = 1 / euclidian_norm;
-      for (int i_phys{}; i_phys < physical_dimension; i_phys++) {
-        metric[i_phys] = metric_ptr[i_phys] * inv_euclidian_norm;
-      }
-    }
-    return metric;
-  }();
-
-  // Auxiliary function to determine distance between two points in face_center
-  auto squared_euclidian_distance =
-      [&face_center_vertices_ptr,
-       &physical_dimension](const int& i_start, const int& i_end) -> double {
-    double squared_euclidian_distance_{};
-    for (int i_phys{}; i_phys < physical_dimension; i_phys++) {
-      const double distance_c =
-          face_center_vertices_ptr[i_end * physical_dimension + i_phys]
-          - face_center_vertices_ptr[i_start * physical_dimension + i_phys];
-      squared_euclidian_distance_ += distance_c * distance_c;
-    }
-    return squared_euclidian_distance_;
-  };
-
-  std::vector<double> scalar_metric{};
-  scalar_metric.reserve(number_of_center_vertices);
-
-  // Check Metric Dimension and Vector Size
-  for (int i_vertex{}; i_vertex < number_of_center_vertices; i_vertex++) {
-    double metric_v = normed_metric[0]
-                      * face_center_vertices_ptr[i_vertex * physical_dimension];
-    for (int j_phys{1}; j_phys < physical_dimension; j_phys++) {
-      metric_v =
-          normed_metric[j_phys]
-          * face_center_vertices_ptr[i_vertex * physical_dimension + j_phys];
-    }
-    scalar_metric.push_back(metric_v);
-  }
-
-  // Sort Metric Vector
-  const auto metric_order_indices = ArgSort(scalar_metric);
-
-  // Loop over points
-  for (int lower_limit = 0; lower_limit < number_of_center_vertices - 1;
-       lower_limit++) {
-    // Loop over all points regardless of whether they have been touched or not,
-    // and then check the validity of the connection Point already processed
-    bool found_duplicate = false;
-    // Now check allowed range for duplicates
-    int upper_limit = lower_limit + 1;
-    while (upper_limit < number_of_center_vertices
-           && (scalar_metric[metric_order_indices[upper_limit]]
-               - scalar_metric[metric_order_indices[lower_limit]])
-                  < tolerance) {
-      // Check if the two points are duplicates
-      found_duplicate =
-          squared_euclidian_distance(metric_order_indices[lower_limit],
-                                     metric_order_indices[upper_limit])
-          < tolerance_squared;
-      if (found_duplicate) {
-        break;
-      } else {
-        upper_limit++;
+  // each thread collects its non-manifold faces and links to faces before
+  // first_query. Threads only write entries of queried faces, links to
+  // previous faces are resolved afterwards.
+  IntVectorVector thread_non_manifold(nthreads);
+  IntVectorVector thread_links(nthreads);
+  auto connect_step = [&](int, int, const int i_thread) {
+    IntVector neighbors;
+    for (int i{first_query + i_thread}; i < n_faces; i += nthreads) {
+      face_centers.RadiusSearch(face_centers.Point(i), tolerance, neighbors);
+
+      // neighbors include the face itself
+      const int n_neighbors = static_cast<int>(neighbors.size()) - 1;
+      if (n_neighbors == 1) {
+        const int partner = (neighbors[0] == i) ? neighbors[1] : neighbors[0];
+        interfaces[i] = partner;
+        if (partner < first_query) {
+          thread_links[i_thread].push_back(partner);
+          thread_links[i_thread].push_back(i);
+        }
+      } else if (n_neighbors > 1) {
+        auto& non_manifold = thread_non_manifold[i_thread];
+        non_manifold.insert(non_manifold.end(),
+                            neighbors.begin(),
+                            neighbors.end());
       }
     }
+  };
+  splinepy::utils::NThreadExecution(connect_step, n_queries, nthreads);
+
+  // serial back-links. A previous face is connected if it is linked by
+  // exactly one face and it was neither connected nor non-manifold before.
+  // Otherwise, all involved faces are non-manifold.
+  IntVector links;
+  for (const auto& thread_link : thread_links) {
+    links.insert(links.end(), thread_link.begin(), thread_link.end());
+  }
+  const int n_links = static_cast<int>(links.size()) / 2;
+  IntVector link_order(n_links);
+  std::iota(link_order.begin(), link_order.end(), 0);
+  std::sort(link_order.begin(),
+            link_order.end(),
+            [&](const int a, const int b) {
+              return links[2 * a] < links[2 * b];
+            });
+  IntVector conflicts;
+  for (int begin{}; begin < n_links;) {
+    const int previous_face = links[2 * link_order[begin]];
+    int end{begin + 1};
+    while (end < n_links && links[2 * link_order[end]] == previous_face) {
+      ++end;
+    }
 
-    // Now we have to check if the connection is valid
-    // 1. If another connection is found, that means, that the point it connects
-    //    to has a higher index in the metric tensor. If the current point does
-    //    already have a neighbor, that means that more than one point connect
-    //    -> Error
-    if (found_duplicate) {
-      if (connectivity_ptr[metric_order_indices[lower_limit]] != -2) {
-        splinepy::utils::PrintAndThrowError(
-            "Found conflicting interceptions, where more than two points are "
-            "in the same position. Expected -2 got",
-            connectivity_ptr[metric_order_indices[lower_limit]]);
-      }
-
-      // If both tests passed, update connectivity
-      connectivity_ptr[metric_order_indices[lower_limit]] =
-          static_cast<int>(metric_order_indices[upper_limit]);
-      connectivity_ptr[metric_order_indices[upper_limit]] =
-          static_cast<int>(metric_order_indices[lower_limit]);
+    const bool was_non_manifold = std::binary_search(non_manifold_faces.begin(),
+                                                     non_manifold_faces.end(),
+                                                     previous_face);
+    if (end - begin == 1 && interfaces[previous_face] < 0
+        && !was_non_manifold) {
+      interfaces[previous_face] = links[2 * link_order[begin] + 1];
     } else {
-      // set Boundary-ID
-      if (connectivity_ptr[metric_order_indices[lower_limit]] == -2) {
-        connectivity_ptr[metric_order_indices[lower_limit]] = -1;
+      conflicts.push_back(previous_face);
+      if (interfaces[previous_face] > -1) {
+        conflicts.push_back(interfaces[previous_face]);
+      }
+      for (int j{begin}; j < end; ++j) {
+        conflicts.push_back(links[2 * link_order[j] + 1]);
       }
     }
+    begin = end;
   }
+  thread_non_manifold.push_back(std::move(conflicts));
 
-  // Treat last remaining point in scalar metric vector
-  if (connectivity_ptr[metric_order_indices[number_of_center_vertices - 1]]
-      == -2) {
-    connectivity_ptr[metric_order_indices[number_of_center_vertices - 1]] = -1;
+  // treat non-manifold contacts as boundaries
+  const auto previous_size = non_manifold_faces.size();
+  for (const auto& non_manifold : thread_non_manifold) {
+    for (const int& face : non_manifold) {
+      interfaces[face] = -1;
+    }
+    non_manifold_faces.insert(non_manifold_faces.end(),
+                              non_manifold.begin(),
+                              non_manifold.end());
+  }
+  if (non_manifold_faces.size() != previous_size) {
+    std::sort(non_manifold_faces.begin(), non_manifold_faces.end());
+    non_manifold_faces.erase(
+        std::unique(non_manifold_faces.begin(), non_manifold_faces.end()),
+        non_manifold_faces.end());
   }
-
-  // Resize buffer
-  connectivity.resize({number_of_patches, number_of_element_faces});
-  return connectivity;
 }
 
 py::array_t<int>
 InterfacesFromBoundaryCenters(const py::array_t<double>& py_center_vertices,
                               const double& tolerance,
                               const int& parametric_dimension) {
-  // Determine Metric
   const int physical_dimension = py_center_vertices.shape(1);
-  const int number_of_corner_points = py_center_vertices.shape(0);
-  py::array_t<double> maxvertex(physical_dimension),
-      minvertex{physical_dimension};
-
-  // Get pointers
-  double* maxvertex_ptr = static_cast<double*>(maxvertex.request().ptr);
-  double* minvertex_ptr = static_cast<double*>(minvertex.request().ptr);
-  const double* py_center_vertices_ptr =
-      static_cast<double*>(py_center_vertices.request().ptr);
-
-  // Calculate limits of center vertices
-  for (int i_dim{}; i_dim < physical_dimension; i_dim++) {
-    minvertex_ptr[i_dim] = py_center_vertices_ptr[i_dim];
-    maxvertex_ptr[i_dim] = py_center_vertices_ptr[i_dim];
-  }
-  for (int i_c{1}; i_c < number_of_corner_points; i_c++) {
-    for (int i_dim{}; i_dim < physical_dimension; i_dim++) {
-      maxvertex_ptr[i_dim] =
-          std::max(py_center_vertices_ptr[i_c * physical_dimension + i_dim],
-                   maxvertex_ptr[i_dim]);
-      minvertex_ptr[i_dim] =
-          std::min(py_center_vertices_ptr[i_c * physical_dimension + i_dim],
-                   minvertex_ptr[i_dim]);
-    }
-  }
-
-  // Determine Interfaces
-  return FindConnectivityFromCenters(py_center_vertices,
-                                     parametric_dimension,
-                                     maxvertex - minvertex,
-                                     tolerance);
+  const int number_of_center_vertices = py_center_vertices.shape(0);
+  const int number_of_element_faces = parametric_dimension * 2;
+
+  // Consistency check
+  if (number_of_center_vertices % number_of_element_faces != 0) {
+    splinepy::utils::PrintAndThrowError(
+        "Inconsistent number of Center vertices. Must be divisible by "
+        "parametric_dimension*2");
+  }
+
+  // hash face centers
+  splinepy::utils::SpatialHash face_centers(physical_dimension,
+                                            2. * tolerance);
+  face_centers.Insert(static_cast<const double*>(py_center_vertices.data()),
+                      number_of_center_vertices);
+
+  // Determine Interfaces - everything is a boundary by default
+  py::array_t<int> connectivity(number_of_center_vertices);
+  int* connectivity_ptr = static_cast<int*>(connectivity.request().ptr);
+  std::fill_n(connectivity_ptr, number_of_center_vertices, -1);
+  IntVector non_manifold_faces;
+  ConnectFaceCenters(face_centers,
+                     0,
+                     tolerance,
+                     1,
+                     connectivity_ptr,
+                     non_manifold_faces);
+
+  if (!non_manifold_faces.empty()) {
+    splinepy::utils::PrintWarning(
+        "Found",
+        non_manifold_faces.size(),
+        "faces with non-manifold contacts. They are treated as boundaries.");
+  }
+
+  connectivity.resize({number_of_center_vertices / number_of_element_faces,
+                       number_of_element_faces});
+  return connectivity;
 }
 
 void GetBoundaryOrientation(
@@ -593,6 +597,54 @@ void GetBoundaryOrientation(
         "D.");
   }
 
+  // Calculate Jacobians at face centers
+  std::vector<double> jacobian_start(para_dim_ * dim_),
+      jacobian_end(para_dim_ * dim_);
+  FaceCenterJacobian(pyspline_start, boundary_start, jacobian_start.data());
+  FaceCenterJacobian(pyspline_end, boundary_end, jacobian_end.data());
+
+  OrientationFromJacobians(para_dim_,
+                           dim_,
+                           boundary_start,
+                           jacobian_start.data(),
+                           boundary_end,
+                           jacobian_end.data(),
+                           tolerance,
+                           int_mappings_ptr,
+                           bool_orientations_ptr);
+}
+
+void FaceCenterJacobian(
+    const std::shared_ptr<splinepy::splines::SplinepyBase>& spline,
+    const int face_id,
+    double* jacobian) {
+  const int para_dim = spline->SplinepyParaDim();
+  const int face_p_dim = face_id / 2;
+  const bool face_orientation = (face_id % 2) == 0;
+
+  // Determine face center position in parametric space
+  DoubleVector bounds(para_dim * 2), face_center(para_dim);
+  spline->SplinepyParametricBounds(bounds.data());
+  for (int i{}; i < para_dim; i++) {
+    if (i == face_p_dim) {
+      face_center[i] = face_orientation ? bounds[i] : bounds[i + para_dim];
+    } else {
+      face_center[i] = .5 * (bounds[i] + bounds[i + para_dim]);
+    }
+  }
+
+  spline->SplinepyJacobian(face_center.data(), jacobian);
+}
+
+void OrientationFromJacobians(const int para_dim_,
+                              const int dim_,
+                              const int boundary_start,
+                              const double* jacobian_start,
+                              const int boundary_end,
+                              const double* jacobian_end,
+                              const double tolerance,
+                              int* int_mappings_ptr,
+                              bool* bool_orientations_ptr) {
   // First Check the orientation of the first entry by comparing their ids
   const int boundary_start_p_dim = static_cast<int>(boundary_start / 2);
   const bool boundary_start_orientation = (boundary_start % 2) == 0;
@@ -606,41 +658,6 @@ void GetBoundaryOrientation(
   bool_orientations_ptr[boundary_start_p_dim] =
       (boundary_start_orientation ^ boundary_end_orientation);
 
-  /// Compare jacobians for remaining entries
-  // Calculate Parametric bounds
-  std::vector<double> bounds_start(para_dim_ * 2);
-  pyspline_start->SplinepyParametricBounds(bounds_start.data());
-  std::vector<double> bounds_end(para_dim_ * 2);
-  pyspline_end->SplinepyParametricBounds(bounds_end.data());
-  // Determine face center position in parametric space
-  std::vector<double> boundary_center_start(para_dim_),
-      boundary_center_end(para_dim_);
-
-  for (int i{}; i < para_dim_; i++) {
-    if (i == boundary_start_p_dim) {
-      boundary_center_start[i] = boundary_start_orientation
-                                     ? bounds_start[i]
-                                     : bounds_start[i + para_dim_];
-    } else {
-      boundary_center_start[i] =
-          .5 * (bounds_start[i] + bounds_start[i + para_dim_]);
-    }
-    if (i == boundary_end_p_dim) {
-      boundary_center_end[i] =
-          boundary_end_orientation ? bounds_end[i] : bounds_end[i + para_dim_];
-    } else {
-      boundary_center_end[i] = .5 * (bounds_end[i] + bounds_end[i + para_dim_]);
-    }
-  }
-
-  // Calculate Jacobians
-  std::vector<double> jacobian_start(para_dim_ * dim_),
-      jacobian_end(para_dim_ * dim_);
-  pyspline_start->SplinepyJacobian(boundary_center_start.data(),
-                                   jacobian_start.data());
-  pyspline_end->SplinepyJacobian(boundary_center_end.data(),
-                                 jacobian_end.data());
-
   // Check the angle between the jacobian entries
   for (int i_pd{}; i_pd < para_dim_; i_pd++) {
     if (i_pd == boundary_start_p_dim) {
@@ -662,7 +679,7 @@ void GetBoundaryOrientation(
       }
 
       // Check angle
-      const double cos_angle = abs(dot_p / std::sqrt(norm_s * norm_e));
+      const double cos_angle = std::abs(dot_p / std::sqrt(norm_s * norm_e));
       if (cos_angle > (1. - tolerance)) {
         int_mappings_ptr[i_pd] = j;
         bool_orientations_ptr[i_pd] = (dot_p > 0);
@@ -672,6 +689,276 @@ void GetBoundaryOrientation(
   }
 }
 
+void BoundaryOrientations(
+    const std::vector<std::shared_ptr<splinepy::splines::SplinepyBase>>&
+        splines,
+    const int n_connections,
+    const int* base_id_ptr,
+    const int* base_face_id_ptr,
+    const int* neighbor_id_ptr,
+    const int* neighbor_face_id_ptr,
+    const double tolerance,
+    const int n_threads,
+    int* int_mapping_ptr,
+    bool* bool_orientations_ptr) {
+  if (n_connections < 1) {
+    return;
+  }
+
+  const int n_splines = static_cast<int>(splines.size());
+  const int para_dim = splines[0]->SplinepyParaDim();
+  const int dim = splines[0]->SplinepyDim();
+  const int n_element_faces = 2 * para_dim;
+  const int jacobian_size = para_dim * dim;
+
+  // Each involved face gets a slot, so that faces shared by multiple
+  // connections are only evaluated once
+  IntVector face_slots(n_splines * n_element_faces, -1);
+  IntVector slot_faces;
+  auto slot_of = [&](const int spline_id, const int face_id) {
+    if (spline_id < 0 || spline_id >= n_splines || face_id < 0
+        || face_id >= n_element_faces) {
+      splinepy::utils::PrintAndThrowError("Invalid spline (",
+                                          spline_id,
+                                          ") or face (",
+                                          face_id,
+                                          ") id.");
+    }
+    if (splines[spline_id]->SplinepyParaDim() != para_dim
+        || splines[spline_id]->SplinepyDim() != dim) {
+      splinepy::utils::PrintAndThrowError(
+          "Spline Orientation can not be checked, as spline (",
+          spline_id,
+          ") has mismatching dimensionality.");
+    }
+    int& slot = face_slots[spline_id * n_element_faces + face_id];
+    if (slot < 0) {
+      slot = static_cast<int>(slot_faces.size());
+      slot_faces.push_back(spline_id * n_element_faces + face_id);
+    }
+    return slot;
+  };
+  IntVector connection_slots(2 * n_connections);
+  for (int i{}; i < n_connections; ++i) {
+    connection_slots[2 * i] = slot_of(base_id_ptr[i], base_face_id_ptr[i]);
+    connection_slots[2 * i + 1] =
+        slot_of(neighbor_id_ptr[i], neighbor_face_id_ptr[i]);
+  }
+
+  // Jacobians at face centers
+  const int n_slots = static_cast<int>(slot_faces.size());
+  DoubleVector jacobians(n_slots * jacobian_size);
+  auto face_jacobians = [&](const int start, const int end, int) {
+    for (int i{start}; i < end; ++i) {
+      FaceCenterJacobian(splines[slot_faces[i] / n_element_faces],
+                         slot_faces[i] % n_element_faces,
+                         &jacobians[i * jacobian_size]);
+    }
+  };
+  splinepy::utils::NThreadExecution(face_jacobians, n_slots, n_threads);
+
+  // Orientations
+  auto get_orientation = [&](const int start, const int end, int) {
+    for (int i{start}; i < end; ++i) {
+      OrientationFromJacobians(
+          para_dim,
+          dim,
+          base_face_id_ptr[i],
+          &jacobians[connection_slots[2 * i] * jacobian_size],
+          neighbor_face_id_ptr[i],
+          &jacobians[connection_slots[2 * i + 1] * jacobian_size],
+          tolerance,
+          &int_mapping_ptr[i * para_dim],
+          &bool_orientations_ptr[i * para_dim]);
+    }
+  };
+  splinepy::utils::NThreadExecution(get_orientation, n_connections, n_threads);
+}
+
+bool SharesBasis(const std::shared_ptr<splinepy::splines::SplinepyBase>& a,
+                 const std::shared_ptr<splinepy::splines::SplinepyBase>& b) {
+  if (a->SplinepyIsNull() || b->SplinepyIsNull()) {
+    return false;
+  }
+  if (a == b) {
+    return true;
+  }
+  if (a->SplinepySplineName() != b->SplinepySplineName()
+      || a->SplinepyParaDim() != b->SplinepyParaDim()
+      || a->SplinepyNumberOfControlPoints()
+             != b->SplinepyNumberOfControlPoints()) {
+    return false;
+  }
+
+  const int para_dim = a->SplinepyParaDim();
+  IntVector degrees_a(para_dim), degrees_b(para_dim);
+  std::vector<std::vector<double>> knot_vectors_a, knot_vectors_b;
+  const bool has_knot_vectors = a->SplinepyHasKnotVectors();
+  a->SplinepyCurrentProperties(degrees_a.data(),
+                               has_knot_vectors ? &knot_vectors_a : nullptr,
+                               nullptr,
+                               nullptr);
+  b->SplinepyCurrentProperties(degrees_b.data(),
+                               has_knot_vectors ? &knot_vectors_b : nullptr,
+                               nullptr,
+                               nullptr);
+  if (degrees_a != degrees_b || knot_vectors_a != knot_vectors_b) {
+    return false;
+  }
+
+  if (a->SplinepyIsRational()) {
+    const int n_weights = a->SplinepyNumberOfControlPoints();
+    DoubleVector weights_a(n_weights), weights_b(n_weights);
+    a->SplinepyCurrentProperties(nullptr, nullptr, nullptr, weights_a.data());
+    b->SplinepyCurrentProperties(nullptr, nullptr, nullptr, weights_b.data());
+    if (weights_a != weights_b) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void InterfaceControlPointPairs(
+    const std::shared_ptr<splinepy::splines::SplinepyBase>& spline_start,
+    const int boundary_start,
+    const double* control_points_start,
+    const std::shared_ptr<splinepy::splines::SplinepyBase>& spline_end,
+    const int boundary_end,
+    const double* control_points_end,
+    const double tolerance,
+    IntVector& pairs) {
+  const int para_dim = spline_start->SplinepyParaDim();
+  const int dim = spline_start->SplinepyDim();
+  const int axis_start = boundary_start / 2;
+  const int axis_end = boundary_end / 2;
+  const double tolerance_squared = tolerance * tolerance;
+  const auto previous_size = pairs.size();
+
+  IntVector cmr_start(para_dim), cmr_end(para_dim);
+  spline_start->SplinepyControlMeshResolutions(cmr_start.data());
+  spline_end->SplinepyControlMeshResolutions(cmr_end.data());
+
+  // plane index of each face
+  const int plane_start =
+      (boundary_start % 2 == 0) ? 0 : cmr_start[axis_start] - 1;
+  const int plane_end = (boundary_end % 2 == 0) ? 0 : cmr_end[axis_end] - 1;
+
+  // axis mapping
+  IntVector mapping(para_dim, -1);
+  std::unique_ptr<bool[]> orientations(new bool[para_dim]);
+  GetBoundaryOrientation(spline_start,
+                         boundary_start,
+                         spline_end,
+                         boundary_end,
+                         tolerance,
+                         mapping.data(),
+                         orientations.get());
+
+  // mapping is usable if it is a permutation between conforming axes
+  bool conforming{true};
+  IntVector mapped_axes(para_dim, 0);
+  for (int i{}; i < para_dim && conforming; ++i) {
+    if (mapping[i] < 0 || mapped_axes[mapping[i]]++ != 0) {
+      conforming = false;
+    } else if (i != axis_start && cmr_start[i] != cmr_end[mapping[i]]) {
+      conforming = false;
+    }
+  }
+
+  if (conforming) {
+    // iterate face control points of start spline as multi index
+    IntVector index_start(para_dim, 0), index_end(para_dim);
+    index_start[axis_start] = plane_start;
+    bool done{false};
+    while (!done) {
+      for (int i{}; i < para_dim; ++i) {
+        if (i == axis_start) {
+          continue;
+        }
+        index_end[mapping[i]] = orientations[i]
+                                    ? index_start[i]
+                                    : cmr_start[i] - 1 - index_start[i];
+      }
+      index_end[axis_end] = plane_end;
+
+      int id_start{}, id_end{}, stride_start{1}, stride_end{1};
+      for (int i{}; i < para_dim; ++i) {
+        id_start += index_start[i] * stride_start;
+        id_end += index_end[i] * stride_end;
+        stride_start *= cmr_start[i];
+        stride_end *= cmr_end[i];
+      }
+
+      // verify
+      double distance_squared{};
+      for (int k{}; k < dim; ++k) {
+        const double diff = control_points_start[id_start * dim + k]
+                            - control_points_end[id_end * dim + k];
+        distance_squared += diff * diff;
+      }
+      if (!(distance_squared < tolerance_squared)) {
+        conforming = false;
+        break;
+      }
+      pairs.push_back(id_start);
+      pairs.push_back(id_end);
+
+      // increment multi index
+      done = true;
+      for (int i{}; i < para_dim; ++i) {
+        if (i == axis_start) {
+          continue;
+        }
+        if (index_start[i] < cmr_start[i] - 1) {
+          ++index_start[i];
+          done = false;
+          break;
+        }
+        index_start[i] = 0;
+      }
+    }
+
+    if (conforming) {
+      return;
+    }
+    pairs.resize(previous_size);
+  }
+
+  // fallback - hash face control points of the end spline
+  const auto ids_start = splinepy::utils::GridPoints::IdsOnHyperPlane(
+      cmr_start.data(),
+      para_dim,
+      axis_start,
+      plane_start);
+  const auto ids_end = splinepy::utils::GridPoints::IdsOnHyperPlane(
+      cmr_end.data(),
+      para_dim,
+      axis_end,
+      plane_end);
+
+  DoubleVector face_control_points(ids_end.size() * dim);
+  for (std::size_t i{}; i < ids_end.size(); ++i) {
+    std::copy_n(&control_points_end[ids_end[i] * dim],
+                dim,
+                &face_control_points[i * dim]);
+  }
+  splinepy::utils::SpatialHash face_hash(dim, 2. * tolerance);
+  face_hash.Insert(face_control_points.data(),
+                   static_cast<int>(ids_end.size()));
+
+  IntVector neighbors;
+  for (const int& id_start : ids_start) {
+    face_hash.RadiusSearch(&control_points_start[id_start * dim],
+                           tolerance,
+                           neighbors);
+    for (const int& neighbor : neighbors) {
+      pairs.push_back(id_start);
+      pairs.push_back(ids_end[neighbor]);
+    }
+  }
+}
+
 py::tuple GetBoundaryOrientations(const py::list& spline_list,
                                   const py::array_t<int>& base_id,
                                   const py::array_t<int>& base_face_id,
@@ -706,21 +993,17 @@ py::tuple GetBoundaryOrientations(const py::list& spline_list,
   bool* bool_orientations_ptr =
       static_cast<bool*>(bool_orientations.request().ptr);
 
-  // Provide lambda for multithread execution
-  auto get_orientation = [&](const int start, const int end, int) {
-    for (int i{start}; i < end; ++i) {
-      GetBoundaryOrientation(cpp_spline_list[base_id_ptr[i]],
-                             base_face_id_ptr[i],
-                             cpp_spline_list[neighbor_id_ptr[i]],
-                             neighbor_face_id_ptr[i],
-                             tolerance,
-                             &int_mapping_ptr[i * para_dim_],
-                             &bool_orientations_ptr[i * para_dim_]);
-    }
-  };
-
-  // Execute in parallel
-  splinepy::utils::NThreadExecution(get_orientation, n_connections, n_threads);
+  // Face jacobians are shared between connections
+  BoundaryOrientations(cpp_spline_list,
+                       n_connections,
+                       base_id_ptr,
+                       base_face_id_ptr,
+                       neighbor_id_ptr,
+                       neighbor_face_id_ptr,
+                       tolerance,
+                       n_threads,
+                       int_mapping_ptr,
+                       bool_orientations_ptr);
 
   // Resize and return
   int_mapping.resize({n_connections, para_dim_});
@@ -825,160 +1108,104 @@ int AddBoundariesFromContinuity(const py::list& boundary_splines,
         "writing an issue on our github");
   }
 
-  // Auxiliary Lambdas to keep code clean
-  // Check if to normal vectors are g1 (tol > cos(phi))
-  auto areG1 = [&tolerance, &dim_](const std::vector<double>& vec0,
-                                   const std::vector<double>& vec1) -> bool {
-    // Checks in Debug
-    assert(static_cast<int>(vec0.size()) == dim_);
-    assert(static_cast<int>(vec1.size()) == dim_);
-
-    // Start actual computation
-    double norm0{}, norm1{}, dot_p{};
-    for (int i{}; i < dim_; i++) {
-      norm0 += vec0[i] * vec0[i];
-      norm1 += vec1[i] * vec1[i];
-      dot_p += vec0[i] * vec1[i];
-    }
-    return (tolerance > abs(1 - abs(dot_p) / std::sqrt(norm0 * norm1)));
-  };
-
-  // Tangential Vector on boundary based on its derivative
-  auto normal_vector = [&cpp_spline_list, &para_dim_, &dim_](
-                           const int& patch_id,
-                           const int& face_id) -> std::vector<double> {
-    // init return value (are default initialized to 0)
+  // Start Computations ------------------------------------------------ //
+  // Normalized normal vectors are computed once per connected face. The
+  // continuity checks and the union-find only need dot products then.
+  const int n_total_faces = n_faces_per_boundary_patch * n_boundary_patches;
+  std::vector<double> normals(n_total_faces * dim_);
+  auto compute_normals = [&](const int start, const int end, int) {
+    // thread local buffers
     std::vector<double> para_coord(para_dim_), bounds(2 * para_dim_),
-        normal_vector(dim_), jacobian(dim_ * para_dim_);
+        jacobian(dim_ * para_dim_);
 
-    // Auxiliary values
-    const int axis_dim = face_id / 2;
-    const int is_in_front = face_id % 2;
-
-    // Parametric Bounds
-    const auto& spline = cpp_spline_list[patch_id];
-    spline->SplinepyParametricBounds(bounds.data());
-
-    for (int i{}; i < para_dim_; i++) {
-      if (i == axis_dim) {
-        para_coord[i] = bounds[i + is_in_front * para_dim_];
-      } else {
-        para_coord[i] = .5 * (bounds[i + para_dim_] + bounds[i]);
-      }
-    }
-
-    // Compute Jacobian
-    spline->SplinepyJacobian(para_coord.data(), jacobian.data());
-
-    // Compute Cross-Product
-    if (dim_ == 2) {
-      normal_vector[0] = -jacobian[1];
-      normal_vector[1] = jacobian[0];
-    } else if (dim_ == 3) {
-      normal_vector[0] = jacobian[2] * jacobian[5] - jacobian[4] * jacobian[3];
-      normal_vector[1] = jacobian[4] * jacobian[1] - jacobian[0] * jacobian[5];
-      normal_vector[2] = jacobian[0] * jacobian[3] - jacobian[2] * jacobian[1];
-    } else {
-      // This should never happen!
-      splinepy::utils::PrintAndThrowError(
-          "G1-based boundary computation is only supported for 2D and 3D "
-          "multipatches. If this is a feature you require, please consider "
-          "writing an issue on our github");
-    }
-    return normal_vector;
-  };
-
-  // Start Computations ------------------------------------------------ //
-  // while the actual propagation needs to be performed in serial, the
-  // precomputation of interface tolerances can be performed in parallel
-  std::vector<bool> faces_are_g1(n_faces_per_boundary_patch
-                                 * n_boundary_patches);
-  auto precompute_tolerances = [&](const int start, const int end, int) {
-    // Loop over relevant faces
     for (int i{start}; i < end; i++) {
-      // Loop over faces
+      const auto& spline = cpp_spline_list[i];
+      spline->SplinepyParametricBounds(bounds.data());
+
       for (int j{}; j < n_faces_per_boundary_patch; j++) {
-        // Interface refers to the global face id (see interface documentation)
-        const int& connected_face_id =
-            boundary_interfaces_ptr[i * n_faces_per_boundary_patch + j];
-
-        // Retrieve patch and face ID of neighbor
-        const int adjacent_element_id =
-            connected_face_id / n_faces_per_boundary_patch;
-        const int adjacent_face_id =
-            connected_face_id % n_faces_per_boundary_patch;
-
-        // only compute if the adjacent neighbor has higher id to prevent double
-        // the work
-        if (adjacent_element_id < i) {
+        const int face = i * n_faces_per_boundary_patch + j;
+        if (boundary_interfaces_ptr[face] < 0) {
           continue;
         }
-        // Get tangential vector of current patch
-        const std::vector<double> vec0 = normal_vector(i, j);
 
-        // Get corresponding tangential vector of neighbor patch
-        const std::vector<double> vec1 =
-            normal_vector(adjacent_element_id, adjacent_face_id);
+        // Face center
+        const int axis_dim = j / 2;
+        const int is_in_front = j % 2;
+        for (int k{}; k < para_dim_; k++) {
+          if (k == axis_dim) {
+            para_coord[k] = bounds[k + is_in_front * para_dim_];
+          } else {
+            para_coord[k] = .5 * (bounds[k + para_dim_] + bounds[k]);
+          }
+        }
+
+        // Compute Jacobian and Cross-Product
+        spline->SplinepyJacobian(para_coord.data(), jacobian.data());
+        double* normal = &normals[face * dim_];
+        // 1D boundaries have no faces, so this is either 2D or 3D
+        if (dim_ == 2) {
+          normal[0] = -jacobian[1];
+          normal[1] = jacobian[0];
+        } else {
+          normal[0] = jacobian[2] * jacobian[5] - jacobian[4] * jacobian[3];
+          normal[1] = jacobian[4] * jacobian[1] - jacobian[0] * jacobian[5];
+          normal[2] = jacobian[0] * jacobian[3] - jacobian[2] * jacobian[1];
+        }
 
-        // Check tolerance
-        const bool is_g1 = areG1(vec0, vec1);
-        faces_are_g1[i * n_faces_per_boundary_patch + j] = is_g1;
-        faces_are_g1[connected_face_id] = is_g1;
+        double norm{};
+        for (int k{}; k < dim_; k++) {
+          norm += normal[k] * normal[k];
+        }
+        norm = std::sqrt(norm);
+        for (int k{}; k < dim_; k++) {
+          normal[k] /= norm;
+        }
       }
     }
   };
-
-  // Execute in parallel
-  splinepy::utils::NThreadExecution(precompute_tolerances,
+  splinepy::utils::NThreadExecution(compute_normals,
                                     n_boundary_patches,
                                     n_threads);
 
-  // std::vector can use less memory for bools
-  std::vector<bool> is_assigned(n_boundary_patches); // defaults false
-  std::vector<int> new_boundary_id(n_boundary_patches);
-  std::vector<int> queued_splines{};
-
-  // Start Assignment
-  // Loop over all patches
-  int current_max_id{1};
-  for (int i{}; i < n_boundary_patches; i++) {
-    if (is_assigned[i]) {
-      continue;
-    }
-    new_boundary_id[i] = current_max_id;
-    is_assigned[i] = true;
-    queued_splines.push_back(i);
-
-    // Start propagation
-    while (!queued_splines.empty()) {
-      const int current_id = queued_splines.back();
-      queued_splines.pop_back();
-      for (int i_face{}; i_face < n_faces_per_boundary_patch; i_face++) {
-        const int combined_index =
-            current_id * n_faces_per_boundary_patch + i_face;
-        // Is the neighborface G1
-        if (faces_are_g1[combined_index]) {
-          // Adjacent global face id
-          const int& adjacent_global_face_id =
-              boundary_interfaces_ptr[combined_index];
-          const int adjacent_patch_id =
-              adjacent_global_face_id / n_faces_per_boundary_patch;
-
-          // Check if the adjacent patch is already assigned
-          if (is_assigned[adjacent_patch_id]) {
-            continue;
-          } else {
-            // Assign a BID and continue
-            new_boundary_id[adjacent_patch_id] = current_max_id;
-            is_assigned[adjacent_patch_id] = true;
-            queued_splines.push_back(adjacent_patch_id);
-          }
-        }
+  // Check G1 continuity per face (1 - |cos(phi)| < tolerance). Both faces of
+  // an interface get the same result and each thread only writes its own
+  // faces. std::vector<bool> is avoided, as it is not safe for concurrent
+  // writes.
+  std::vector<char> faces_are_g1(n_total_faces, 0);
+  auto check_continuity = [&](const int start, const int end, int) {
+    for (int face{start}; face < end; face++) {
+      const int& connected_face_id = boundary_interfaces_ptr[face];
+      if (connected_face_id < 0) {
+        continue;
       }
+      const double* normal0 = &normals[face * dim_];
+      const double* normal1 = &normals[connected_face_id * dim_];
+      double dot_p{};
+      for (int k{}; k < dim_; k++) {
+        dot_p += normal0[k] * normal1[k];
+      }
+      faces_are_g1[face] = (tolerance > std::abs(1. - std::abs(dot_p)));
+    }
+  };
+  splinepy::utils::NThreadExecution(check_continuity,
+                                    n_total_faces,
+                                    n_threads);
+
+  // Group patches with union-find. Unions are cheap compared to the checks
+  // above, so they are performed serially
+  splinepy::utils::UnionFind groups(n_boundary_patches);
+  for (int face{}; face < n_total_faces; face++) {
+    if (faces_are_g1[face]) {
+      groups.Union(face / n_faces_per_boundary_patch,
+                   boundary_interfaces_ptr[face] / n_faces_per_boundary_patch);
     }
+  }
 
-    // End propagation and increase id
-    current_max_id++;
+  // Ids are numbered by their first patch and start at 1
+  std::vector<int> new_boundary_id(n_boundary_patches);
+  const int current_max_id = groups.SetIds(new_boundary_id.data()) + 1;
+  for (int& id : new_boundary_id) {
+    ++id;
   }
 
   // Assign the new boundary ids to the old interface-vector
@@ -1018,6 +1245,10 @@ void PyMultipatch::Clear() {
   boundary_ids_ = py::array_t<int>();
   sub_patch_centers_ = py::array_t<double>();
   field_multipatches_ = py::list();
+  face_center_hash_ = nullptr;
+  non_manifold_faces_ = py::array_t<int>();
+  homogeneous_patches_ = nullptr;
+  point_location_ = nullptr;
 }
 
 void PyMultipatch::SetPatchesNThreads(py::list& patches, const int nthreads) {
@@ -1038,6 +1269,41 @@ void PyMultipatch::SetPatchesNThreads(py::list& patches, const int nthreads) {
                 {},
                 {},
                 nthreads);
+
+  // if all patches share the same basis, use contiguous storage
+  const auto& reference = core_patches_[0];
+  const int para_dim = reference->SplinepyParaDim();
+  IntVector degrees(para_dim), control_mesh_resolutions(para_dim);
+  reference->SplinepyCurrentProperties(degrees.data(),
+                                       nullptr,
+                                       nullptr,
+                                       nullptr);
+  reference->SplinepyControlMeshResolutions(control_mesh_resolutions.data());
+  if (FindMismatch(core_patches_,
+                   reference->SplinepySplineName(),
+                   para_dim,
+                   reference->SplinepyDim(),
+                   degrees,
+                   control_mesh_resolutions,
+                   nthreads)
+          .empty()
+      && splinepy::splines::HomogeneousPatches::HaveSameBasis(core_patches_,
+                                                              nthreads)) {
+    homogeneous_patches_ =
+        std::make_shared<splinepy::splines::HomogeneousPatches>(core_patches_,
+                                                                nthreads);
+  }
+}
+
+std::shared_ptr<splinepy::splines::HomogeneousPatches>
+PyMultipatch::ValidHomogeneousPatches(const int nthreads) {
+  // patches may have been refined or elevated in place. Changed control
+  // points are copied at evaluation
+  if (homogeneous_patches_
+      && !homogeneous_patches_->SharesBasis(core_patches_, nthreads)) {
+    homogeneous_patches_ = nullptr;
+  }
+  return homogeneous_patches_;
 }
 
 void PyMultipatch::SetPatchesWithNullSplines(py::list& patches,
@@ -1191,8 +1457,32 @@ py::array_t<int> PyMultipatch::GetInterfaces(const bool recompute) {
   // set
   if (interfaces_.size() == 0 || recompute) {
     // get, but need to compute since saved member is empty
-    interfaces_ =
-        InterfacesFromBoundaryCenters(SubPatchCenters(), tolerance_, ParaDim());
+    const auto centers = SubPatchCenters();
+    const int n_faces = static_cast<int>(centers.shape(0));
+
+    face_center_hash_ =
+        std::make_shared<splinepy::utils::SpatialHash>(Dim(), 2. * tolerance_);
+    face_center_hash_->Insert(static_cast<const double*>(centers.data()),
+                              n_faces);
+
+    interfaces_ = py::array_t<int>(n_faces);
+    int* interfaces_ptr = static_cast<int*>(interfaces_.request().ptr);
+    std::fill_n(interfaces_ptr, n_faces, -1);
+
+    IntVector non_manifold_faces;
+    ConnectFaceCenters(*face_center_hash_,
+                       0,
+                       tolerance_,
+                       n_default_threads_,
+                       interfaces_ptr,
+                       non_manifold_faces);
+    non_manifold_faces_ = py::array_t<int>(non_manifold_faces.size());
+    std::copy(non_manifold_faces.begin(),
+              non_manifold_faces.end(),
+              static_cast<int*>(non_manifold_faces_.request().ptr));
+
+    interfaces_.resize(
+        {static_cast<int>(core_patches_.size()), ParaDim() * 2});
   }
 
   // regardless of set/get, it will always return the saved member of
@@ -1200,6 +1490,78 @@ py::array_t<int> PyMultipatch::GetInterfaces(const bool recompute) {
   return interfaces_;
 }
 
+void PyMultipatch::AppendPatches(py::list& patches, const int nthreads) {
+  if (patches.size() == 0) {
+    return;
+  }
+
+  // keep face centers and interfaces, as patch setting clears them
+  const int n_old_patches = static_cast<int>(core_patches_.size());
+  auto face_center_hash = face_center_hash_;
+  py::array_t<int> old_interfaces = interfaces_;
+  py::array_t<int> old_non_manifold_faces = non_manifold_faces_;
+
+  py::list all_patches{};
+  for (auto& patch : patches_) {
+    all_patches.append(patch);
+  }
+  for (auto& patch : patches) {
+    all_patches.append(patch);
+  }
+  SetPatchesNThreads(all_patches, nthreads);
+
+  // nothing to update. Interfaces will be computed on demand
+  if (n_old_patches == 0 || !face_center_hash || old_interfaces.size() == 0
+      || face_center_hash->CellSize() < tolerance_) {
+    return;
+  }
+
+  const int n_element_faces = ParaDim() * 2;
+  const int n_old_faces = n_old_patches * n_element_faces;
+  if (static_cast<int>(old_interfaces.size()) != n_old_faces
+      || face_center_hash->Size() != n_old_faces) {
+    return;
+  }
+
+  // add face centers of new patches only. Hash may be shared with copies
+  if (face_center_hash.use_count() > 1) {
+    face_center_hash =
+        std::make_shared<splinepy::utils::SpatialHash>(*face_center_hash);
+  }
+  const auto centers = SubPatchCenters();
+  const int n_faces = static_cast<int>(centers.shape(0));
+  const double* centers_ptr = static_cast<const double*>(centers.data());
+  face_center_hash->Insert(&centers_ptr[n_old_faces * Dim()],
+                           n_faces - n_old_faces);
+
+  interfaces_ = py::array_t<int>(n_faces);
+  int* interfaces_ptr = static_cast<int*>(interfaces_.request().ptr);
+  std::copy_n(static_cast<const int*>(old_interfaces.data()),
+              n_old_faces,
+              interfaces_ptr);
+  std::fill_n(&interfaces_ptr[n_old_faces], n_faces - n_old_faces, -1);
+
+  const int* old_non_manifold_ptr =
+      static_cast<const int*>(old_non_manifold_faces.data());
+  IntVector non_manifold_faces(old_non_manifold_ptr,
+                               old_non_manifold_ptr
+                                   + old_non_manifold_faces.size());
+  ConnectFaceCenters(*face_center_hash,
+                     n_old_faces,
+                     tolerance_,
+                     nthreads,
+                     interfaces_ptr,
+                     non_manifold_faces);
+
+  face_center_hash_ = face_center_hash;
+  non_manifold_faces_ = py::array_t<int>(non_manifold_faces.size());
+  std::copy(non_manifold_faces.begin(),
+            non_manifold_faces.end(),
+            static_cast<int*>(non_manifold_faces_.request().ptr));
+  interfaces_.resize({n_old_patches + static_cast<int>(patches.size()),
+                      n_element_faces});
+}
+
 void PyMultipatch::SetInterfaces(const py::array_t<int>& interfaces) {
   // check if we should set or get
   // set
@@ -1347,6 +1709,16 @@ py::array_t<double> PyMultipatch::Evaluate(py::array_t<double> queries,
   py::array_t<double> evaluated({n_total, dim});
   double* evaluated_ptr = static_cast<double*>(evaluated.request().ptr);
 
+  // shared basis
+  if (const auto homogeneous_patches = ValidHomogeneousPatches(nthreads)) {
+    homogeneous_patches->Evaluate(core_patches_,
+                                  queries_ptr,
+                                  n_queries,
+                                  nthreads,
+                                  evaluated_ptr);
+    return evaluated;
+  }
+
   // each thread evaluates similar amount of queries from each spline
   auto evaluate_step = [&](int, int, const int i_thread) {
     for (int i{i_thread}; i < n_total; i += nthreads) {
@@ -1363,37 +1735,227 @@ py::array_t<double> PyMultipatch::Evaluate(py::array_t<double> queries,
   return evaluated;
 }
 
-py::array_t<double> PyMultipatch::Sample(const int resolution,
-                                         const int nthreads,
-                                         const bool same_parametric_bounds) {
+py::array_t<double>
+PyMultipatch::EvaluatePatches(const py::array_t<double>& queries,
+                              const py::array_t<int>& patch_ids,
+                              const int nthreads) {
   const int para_dim = ParaDim();
   const int dim = Dim();
 
-  // n_queries, and n_splines;
-  int n_queries{1};
-  const int n_splines = core_patches_.size();
+  CheckPyArrayShape(queries, {-1, para_dim}, true);
+  const int n_queries = queries.shape(0);
+  CheckPyArraySize(patch_ids, n_queries, true);
+
+  // group queries by patch
+  const int* patch_ids_ptr = static_cast<const int*>(patch_ids.data());
+  IntVector offsets, order;
+  GroupQueriesByPatch(patch_ids_ptr,
+                      n_queries,
+                      static_cast<int>(core_patches_.size()),
+                      offsets,
+                      order);
+
+  const double* queries_ptr = static_cast<const double*>(queries.data());
+  py::array_t<double> evaluated({n_queries, dim});
+  double* evaluated_ptr = static_cast<double*>(evaluated.request().ptr);
 
-  // prepare resolutions
-  IntVector resolutions_vector(para_dim);
-  int* resolutions = resolutions_vector.data();
-  for (int i{}; i < para_dim; ++i) {
-    resolutions[i] = resolution;
-    n_queries *= resolution;
-  }
+  // threads work on contiguous chunks of grouped queries and write back to
+  // the original position
+  auto evaluate = [&](const int begin, const int end, int) {
+    for (int i{begin}; i < end; ++i) {
+      const int& i_query = order[i];
+      core_patches_[patch_ids_ptr[i_query]]->SplinepyEvaluate(
+          &queries_ptr[i_query * para_dim],
+          &evaluated_ptr[i_query * dim]);
+    }
+  };
+  splinepy::utils::NThreadExecution(evaluate, n_queries, nthreads);
 
-  // prepare input /  output
-  const int n_total = n_splines * n_queries;
-  py::array_t<double> sampled({n_total, dim});
-  double* sampled_ptr = static_cast<double*>(sampled.request().ptr);
+  return evaluated;
+}
 
-  // if you know all the queries have same parametric bounds
-  // you don't need to re-compute queries
-  if (same_parametric_bounds) {
+py::array_t<double>
+PyMultipatch::DerivativePatches(const py::array_t<double>& queries,
+                                const py::array_t<int>& patch_ids,
+                                const py::array_t<int>& orders,
+                                const int nthreads) {
+  const int para_dim = ParaDim();
+  const int dim = Dim();
 
-    // get para bounds
-    DoubleVector para_bounds_vector(2 * para_dim);
-    double* para_bounds = para_bounds_vector.data();
-    core_patches_[0]->SplinepyParametricBounds(para_bounds);
+  CheckPyArrayShape(queries, {-1, para_dim}, true);
+  const int n_queries = queries.shape(0);
+  CheckPyArraySize(patch_ids, n_queries, true);
+  int n_orders{};
+  if (CheckPyArraySize(orders, para_dim, false)) {
+    n_orders = 1;
+  } else if (CheckPyArrayShape(orders, {-1, para_dim}, false)) {
+    n_orders = orders.shape(0);
+  } else {
+    splinepy::utils::PrintAndThrowError(
+        "Derivative-query-orders must be either have same size as para_dim",
+        "or (n, para_dim) shape.");
+  }
+
+  const int* patch_ids_ptr = static_cast<const int*>(patch_ids.data());
+  IntVector offsets, order;
+  GroupQueriesByPatch(patch_ids_ptr,
+                      n_queries,
+                      static_cast<int>(core_patches_.size()),
+                      offsets,
+                      order);
+
+  const double* queries_ptr = static_cast<const double*>(queries.data());
+  const int* orders_ptr = static_cast<const int*>(orders.data());
+  py::array_t<double> derived({n_queries * n_orders, dim});
+  double* derived_ptr = static_cast<double*>(derived.request().ptr);
+
+  const int out_stride = dim * n_orders;
+  auto derive = [&](const int begin, const int end, int) {
+    for (int i{begin}; i < end; ++i) {
+      const int& i_query = order[i];
+      const auto& patch = core_patches_[patch_ids_ptr[i_query]];
+      for (int j{}; j < n_orders; ++j) {
+        patch->SplinepyDerivative(&queries_ptr[i_query * para_dim],
+                                  &orders_ptr[j * para_dim],
+                                  &derived_ptr[i_query * out_stride + j * dim]);
+      }
+    }
+  };
+  splinepy::utils::NThreadExecution(derive, n_queries, nthreads);
+
+  if (n_orders > 1) {
+    derived.resize({n_queries, n_orders, dim});
+  }
+  return derived;
+}
+
+py::array_t<double>
+PyMultipatch::JacobianPatches(const py::array_t<double>& queries,
+                              const py::array_t<int>& patch_ids,
+                              const int nthreads) {
+  const int para_dim = ParaDim();
+  const int dim = Dim();
+
+  CheckPyArrayShape(queries, {-1, para_dim}, true);
+  const int n_queries = queries.shape(0);
+  CheckPyArraySize(patch_ids, n_queries, true);
+
+  const int* patch_ids_ptr = static_cast<const int*>(patch_ids.data());
+  IntVector offsets, order;
+  GroupQueriesByPatch(patch_ids_ptr,
+                      n_queries,
+                      static_cast<int>(core_patches_.size()),
+                      offsets,
+                      order);
+
+  const double* queries_ptr = static_cast<const double*>(queries.data());
+  py::array_t<double> jacobians({n_queries, dim, para_dim});
+  double* jacobians_ptr = static_cast<double*>(jacobians.request().ptr);
+
+  const int stride = dim * para_dim;
+  auto derive = [&](const int begin, const int end, int) {
+    for (int i{begin}; i < end; ++i) {
+      const int& i_query = order[i];
+      core_patches_[patch_ids_ptr[i_query]]->SplinepyJacobian(
+          &queries_ptr[i_query * para_dim],
+          &jacobians_ptr[i_query * stride]);
+    }
+  };
+  splinepy::utils::NThreadExecution(derive, n_queries, nthreads);
+
+  return jacobians;
+}
+
+py::tuple
+PyMultipatch::BasisAndSupportPatches(const py::array_t<double>& queries,
+                                     const py::array_t<int>& patch_ids,
+                                     const int nthreads) {
+  const int para_dim = ParaDim();
+
+  CheckPyArrayShape(queries, {-1, para_dim}, true);
+  const int n_queries = queries.shape(0);
+  CheckPyArraySize(patch_ids, n_queries, true);
+
+  const int* patch_ids_ptr = static_cast<const int*>(patch_ids.data());
+  const int n_patches = static_cast<int>(core_patches_.size());
+  IntVector offsets, order;
+  GroupQueriesByPatch(patch_ids_ptr, n_queries, n_patches, offsets, order);
+
+  // output is rectangular - all involved patches need the same support size
+  int n_support{-1};
+  for (int i{}; i < n_patches; ++i) {
+    if (offsets[i] == offsets[i + 1]) {
+      continue;
+    }
+    const int patch_n_support = core_patches_[i]->SplinepyNumberOfSupports();
+    if (n_support < 0) {
+      n_support = patch_n_support;
+    } else if (n_support != patch_n_support) {
+      splinepy::utils::PrintAndThrowError(
+          "All queried patches should have the same number of supports.",
+          "Expected",
+          n_support,
+          "but patch (",
+          i,
+          ") has",
+          patch_n_support);
+    }
+  }
+  n_support = std::max(n_support, 0);
+
+  const double* queries_ptr = static_cast<const double*>(queries.data());
+  py::array_t<double> basis({n_queries, n_support});
+  py::array_t<int> support({n_queries, n_support});
+  double* basis_ptr = static_cast<double*>(basis.request().ptr);
+  int* support_ptr = static_cast<int*>(support.request().ptr);
+
+  auto basis_support = [&](const int begin, const int end, int) {
+    for (int i{begin}; i < end; ++i) {
+      const int& i_query = order[i];
+      core_patches_[patch_ids_ptr[i_query]]->SplinepyBasisAndSupport(
+          &queries_ptr[i_query * para_dim],
+          &basis_ptr[i_query * n_support],
+          &support_ptr[i_query * n_support]);
+    }
+  };
+  splinepy::utils::NThreadExecution(basis_support, n_queries, nthreads);
+
+  return py::make_tuple(basis, support);
+}
+
+py::array_t<double> PyMultipatch::Sample(const int resolution,
+                                         const int nthreads,
+                                         const bool same_parametric_bounds) {
+  const int para_dim = ParaDim();
+  const int dim = Dim();
+
+  // n_queries, and n_splines;
+  int n_queries{1};
+  const int n_splines = core_patches_.size();
+
+  // prepare resolutions
+  IntVector resolutions_vector(para_dim);
+  int* resolutions = resolutions_vector.data();
+  for (int i{}; i < para_dim; ++i) {
+    resolutions[i] = resolution;
+    n_queries *= resolution;
+  }
+
+  // prepare input /  output
+  const int n_total = n_splines * n_queries;
+  py::array_t<double> sampled({n_total, dim});
+  double* sampled_ptr = static_cast<double*>(sampled.request().ptr);
+
+  // if you know all the queries have same parametric bounds
+  // you don't need to re-compute queries. Homogeneous patches share knot
+  // vectors, thus parametric bounds
+  const auto homogeneous_patches = ValidHomogeneousPatches(nthreads);
+  if (same_parametric_bounds || homogeneous_patches) {
+
+    // get para bounds
+    DoubleVector para_bounds_vector(2 * para_dim);
+    double* para_bounds = para_bounds_vector.data();
+    core_patches_[0]->SplinepyParametricBounds(para_bounds);
 
     // prepare queries
     DoubleVector queries_vector(n_queries * para_dim);
@@ -1405,6 +1967,15 @@ py::array_t<double> PyMultipatch::Sample(const int resolution,
                                              resolutions);
     gp_generator.Fill(queries);
 
+    if (homogeneous_patches) {
+      homogeneous_patches->Evaluate(core_patches_,
+                                    queries,
+                                    n_queries,
+                                    nthreads,
+                                    sampled_ptr);
+      return sampled;
+    }
+
     // create lambda for nthread exe
     auto sample_same_bounds_step = [&](int, int, const int i_thread) {
       for (int i{i_thread}; i < n_total; i += nthreads) {
@@ -1430,8 +2001,8 @@ py::array_t<double> PyMultipatch::Sample(const int resolution,
 
     // create grid_points
     auto create_grid_points = [&](const int begin, const int end, int) {
-      DoubleVector para_bounds_vector(2 * para_dim);
-      double* para_bounds = para_bounds_vector.data();
+      splinepy::utils::ScratchScope scratch;
+      double* para_bounds = scratch.Allocate<double>(2 * para_dim);
 
       for (int i{begin}; i < end; ++i) {
         // get para_bounds
@@ -1448,8 +2019,8 @@ py::array_t<double> PyMultipatch::Sample(const int resolution,
     // query on the fly
     auto sample_step = [&](int, int, const int i_thread) {
       // each thread needs just one query array
-      DoubleVector thread_query_vector(para_dim);
-      double* thread_query = thread_query_vector.data();
+      splinepy::utils::ScratchScope scratch;
+      double* thread_query = scratch.Allocate<double>(para_dim);
 
       for (int i{i_thread}; i < n_total; i += nthreads) {
         const auto [i_spline, i_query] = std::div(i, n_queries);
@@ -1468,6 +2039,375 @@ py::array_t<double> PyMultipatch::Sample(const int resolution,
   return sampled;
 }
 
+py::tuple PyMultipatch::SamplePatches(const py::array_t<int>& resolutions,
+                                      const int nthreads) {
+  const auto& patches = CorePatches();
+  const int n_patches = static_cast<int>(patches.size());
+  const int para_dim = ParaDim();
+  const int dim = Dim();
+
+  // per patch resolutions - (n_patches) is uniform in all directions
+  const bool is_uniform = resolutions.ndim() == 1;
+  if (is_uniform) {
+    CheckPyArraySize(resolutions, n_patches, true);
+  } else {
+    CheckPyArrayShape(resolutions, {n_patches, para_dim}, true);
+  }
+  const int* resolutions_ptr = static_cast<const int*>(resolutions.data());
+
+  IntVector patch_resolutions(n_patches * para_dim);
+  py::array_t<int> offsets(n_patches + 1);
+  int* offsets_ptr = static_cast<int*>(offsets.request().ptr);
+  offsets_ptr[0] = 0;
+  for (int i{}; i < n_patches; ++i) {
+    int n_queries{1};
+    for (int j{}; j < para_dim; ++j) {
+      const int& resolution =
+          resolutions_ptr[is_uniform ? i : i * para_dim + j];
+      // GridPoints needs at least both bounds per axis
+      if (resolution < 2) {
+        splinepy::utils::PrintAndThrowError("Patch (",
+                                            i,
+                                            ") has invalid resolution (",
+                                            resolution,
+                                            "). Resolutions should be at "
+                                            "least 2.");
+      }
+      patch_resolutions[i * para_dim + j] = resolution;
+      n_queries *= resolution;
+    }
+    offsets_ptr[i + 1] = offsets_ptr[i] + n_queries;
+  }
+  const int n_total = offsets_ptr[n_patches];
+
+  // grid point helpers
+  splinepy::utils::DefaultInitializationVector<splinepy::utils::GridPoints>
+      grid_points(n_patches);
+  auto create_grid_points = [&](const int begin, const int end, int) {
+    splinepy::utils::ScratchScope scratch;
+    double* para_bounds = scratch.Allocate<double>(2 * para_dim);
+    for (int i{begin}; i < end; ++i) {
+      patches[i]->SplinepyParametricBounds(para_bounds);
+      grid_points[i].SetUp(para_dim,
+                           para_bounds,
+                           &patch_resolutions[i * para_dim]);
+    }
+  };
+  splinepy::utils::NThreadExecution(create_grid_points, n_patches, nthreads);
+
+  py::array_t<double> sampled({n_total, dim});
+  double* sampled_ptr = static_cast<double*>(sampled.request().ptr);
+
+  // chunks over flattened samples, so that each thread gets the same amount
+  // of work regardless of patch sizes
+  auto sample = [&](const int begin, const int end, int) {
+    splinepy::utils::ScratchScope scratch;
+    double* query = scratch.Allocate<double>(para_dim);
+
+    // patch of first sample
+    int i_patch = static_cast<int>(
+        std::upper_bound(offsets_ptr, offsets_ptr + n_patches + 1, begin)
+        - offsets_ptr - 1);
+    for (int i{begin}; i < end; ++i) {
+      while (i >= offsets_ptr[i_patch + 1]) {
+        ++i_patch;
+      }
+      grid_points[i_patch].IdToGridPoint(i - offsets_ptr[i_patch], query);
+      patches[i_patch]->SplinepyEvaluate(query, &sampled_ptr[i * dim]);
+    }
+  };
+  splinepy::utils::NThreadExecution(sample, n_total, nthreads);
+
+  return py::make_tuple(sampled, offsets);
+}
+
+py::array_t<int> PyMultipatch::SampleResolutions(const double spacing,
+                                                 const int min_resolution,
+                                                 const int max_resolution,
+                                                 const int nthreads) {
+  if (!(spacing > 0.)) {
+    splinepy::utils::PrintAndThrowError("Spacing should be positive. Given -",
+                                        spacing);
+  }
+  if (min_resolution < 2 || max_resolution < min_resolution) {
+    splinepy::utils::PrintAndThrowError("Invalid resolution range [",
+                                        min_resolution,
+                                        ",",
+                                        max_resolution,
+                                        "].");
+  }
+
+  const auto& patches = CorePatches();
+  const int n_patches = static_cast<int>(patches.size());
+  const int para_dim = ParaDim();
+  const int dim = Dim();
+
+  py::array_t<int> resolutions({n_patches, para_dim});
+  int* resolutions_ptr = static_cast<int*>(resolutions.request().ptr);
+
+  auto estimate = [&](const int begin, const int end, int) {
+    IntVector cmr(para_dim);
+    DoubleVector control_points;
+
+    for (int i{begin}; i < end; ++i) {
+      const auto& patch = patches[i];
+      int* patch_resolutions = &resolutions_ptr[i * para_dim];
+      if (patch->SplinepyIsNull()) {
+        std::fill_n(patch_resolutions, para_dim, min_resolution);
+        continue;
+      }
+
+      patch->SplinepyControlMeshResolutions(cmr.data());
+      const int n_control_points = patch->SplinepyNumberOfControlPoints();
+      control_points.resize(n_control_points * dim);
+      patch->SplinepyCurrentProperties(nullptr,
+                                       nullptr,
+                                       control_points.data(),
+                                       nullptr);
+
+      int stride{1};
+      for (int j{}; j < para_dim; ++j) {
+        // longest control polygon line along axis j
+        const int n_lines = n_control_points / cmr[j];
+        double max_length{};
+        for (int line{}; line < n_lines; ++line) {
+          // first control point of this line
+          const int first = (line / stride) * stride * cmr[j] + line % stride;
+          double length{};
+          for (int k{1}; k < cmr[j]; ++k) {
+            const double* a = &control_points[(first + (k - 1) * stride) * dim];
+            const double* b = &control_points[(first + k * stride) * dim];
+            double distance_squared{};
+            for (int l{}; l < dim; ++l) {
+              distance_squared += (b[l] - a[l]) * (b[l] - a[l]);
+            }
+            length += std::sqrt(distance_squared);
+          }
+          max_length = std::max(max_length, length);
+        }
+        stride *= cmr[j];
+
+        const double resolution = std::ceil(max_length / spacing) + 1.;
+        patch_resolutions[j] = static_cast<int>(
+            std::clamp(resolution,
+                       static_cast<double>(min_resolution),
+                       static_cast<double>(max_resolution)));
+      }
+    }
+  };
+  splinepy::utils::NThreadExecution(estimate, n_patches, nthreads);
+
+  return resolutions;
+}
+
+py::tuple PyMultipatch::SampleWatertight(const int resolution,
+                                         const double tolerance,
+                                         const double angle_tolerance,
+                                         const int nthreads) {
+  if (resolution < 2) {
+    splinepy::utils::PrintAndThrowError(
+        "Watertight sampling requires a resolution of at least 2. Given -",
+        resolution);
+  }
+
+  const auto& patches = CorePatches();
+  const int para_dim = ParaDim();
+  const int dim = Dim();
+  const int n_patches = static_cast<int>(patches.size());
+
+  int n_queries{1}, n_face_queries{1}, n_cells{1};
+  for (int i{}; i < para_dim; ++i) {
+    n_queries *= resolution;
+    n_cells *= resolution - 1;
+    if (i != 0) {
+      n_face_queries *= resolution;
+    }
+  }
+  const int n_samples = n_patches * n_queries;
+
+  // parametric sample grid of each patch. Samples are only evaluated on
+  // interfaces to match them and once per unique vertex
+  std::vector<splinepy::utils::GridPoints> grids(n_patches);
+  auto set_up_grids = [&](const int begin, const int end, int) {
+    DoubleVector bounds(2 * para_dim);
+    IntVector resolutions(para_dim, resolution);
+    for (int i{begin}; i < end; ++i) {
+      patches[i]->SplinepyParametricBounds(bounds.data());
+      grids[i].SetUp(para_dim, bounds.data(), resolutions.data());
+    }
+  };
+  splinepy::utils::NThreadExecution(set_up_grids, n_patches, nthreads);
+
+  // interfaces with axis mappings
+  const auto interface_orientations =
+      InterfaceOrientations(angle_tolerance, nthreads);
+  const auto base_ids = interface_orientations[0].cast<py::array_t<int>>();
+  const auto base_face_ids =
+      interface_orientations[1].cast<py::array_t<int>>();
+  const auto neighbor_ids = interface_orientations[2].cast<py::array_t<int>>();
+  const auto neighbor_face_ids =
+      interface_orientations[3].cast<py::array_t<int>>();
+  const auto mappings = interface_orientations[4].cast<py::array_t<int>>();
+  const auto orientations =
+      interface_orientations[5].cast<py::array_t<bool>>();
+  const int* base_ids_ptr = static_cast<const int*>(base_ids.data());
+  const int* base_face_ids_ptr = static_cast<const int*>(base_face_ids.data());
+  const int* neighbor_ids_ptr = static_cast<const int*>(neighbor_ids.data());
+  const int* neighbor_face_ids_ptr =
+      static_cast<const int*>(neighbor_face_ids.data());
+  const int* mappings_ptr = static_cast<const int*>(mappings.data());
+  const bool* orientations_ptr = static_cast<const bool*>(orientations.data());
+  const int n_connections = static_cast<int>(base_ids.size());
+
+  // matching sample ids on each interface. Pairs that don't coincide (e.g.,
+  // different parametrization along the interface) stay -1
+  IntVector pairs(2 * n_connections * n_face_queries, -1);
+  const double tolerance_squared = tolerance * tolerance;
+  auto match_samples = [&](const int begin, const int end, int) {
+    IntVector mapped_axes(para_dim), index_start(para_dim),
+        index_end(para_dim);
+    DoubleVector query_start(para_dim), query_end(para_dim),
+        point_start(dim), point_end(dim);
+
+    for (int i{begin}; i < end; ++i) {
+      const int* mapping = &mappings_ptr[i * para_dim];
+      const bool* orientation = &orientations_ptr[i * para_dim];
+      const int axis_start = base_face_ids_ptr[i] / 2;
+      const int axis_end = neighbor_face_ids_ptr[i] / 2;
+
+      // mapping needs to be a permutation
+      std::fill(mapped_axes.begin(), mapped_axes.end(), 0);
+      bool valid{true};
+      for (int j{}; j < para_dim && valid; ++j) {
+        valid = mapping[j] >= 0 && mapped_axes[mapping[j]]++ == 0;
+      }
+      if (!valid) {
+        continue;
+      }
+
+      const int& patch_start = base_ids_ptr[i];
+      const int& patch_end = neighbor_ids_ptr[i];
+      index_start[axis_start] =
+          (base_face_ids_ptr[i] % 2 == 0) ? 0 : resolution - 1;
+      for (int k{}; k < n_face_queries; ++k) {
+        // multi index on start face
+        int remainder{k};
+        for (int j{}; j < para_dim; ++j) {
+          if (j == axis_start) {
+            continue;
+          }
+          index_start[j] = remainder % resolution;
+          remainder /= resolution;
+          index_end[mapping[j]] = orientation[j]
+                                      ? index_start[j]
+                                      : resolution - 1 - index_start[j];
+        }
+        index_end[axis_end] =
+            (neighbor_face_ids_ptr[i] % 2 == 0) ? 0 : resolution - 1;
+
+        int id_start{}, id_end{}, stride{1};
+        for (int j{}; j < para_dim; ++j) {
+          id_start += index_start[j] * stride;
+          id_end += index_end[j] * stride;
+          stride *= resolution;
+        }
+
+        grids[patch_start].IdToGridPoint(id_start, query_start.data());
+        grids[patch_end].IdToGridPoint(id_end, query_end.data());
+        patches[patch_start]->SplinepyEvaluate(query_start.data(),
+                                               point_start.data());
+        patches[patch_end]->SplinepyEvaluate(query_end.data(),
+                                             point_end.data());
+
+        double distance_squared{};
+        for (int j{}; j < dim; ++j) {
+          const double diff = point_start[j] - point_end[j];
+          distance_squared += diff * diff;
+        }
+        if (distance_squared < tolerance_squared) {
+          pairs[2 * (i * n_face_queries + k)] =
+              patch_start * n_queries + id_start;
+          pairs[2 * (i * n_face_queries + k) + 1] =
+              patch_end * n_queries + id_end;
+        }
+      }
+    }
+  };
+  splinepy::utils::NThreadExecution(match_samples, n_connections, nthreads);
+
+  // merge - also takes care of corners shared by more than two patches
+  splinepy::utils::UnionFind union_find(n_samples);
+  for (std::size_t i{}; i < pairs.size(); i += 2) {
+    if (pairs[i] >= 0) {
+      union_find.Union(pairs[i], pairs[i + 1]);
+    }
+  }
+  IntVector sample_to_vertex(n_samples);
+  const int n_vertices = union_find.SetIds(sample_to_vertex.data());
+
+  // vertices are numbered by first appearance. Evaluate each once
+  IntVector vertex_samples(n_vertices);
+  for (int i{}, n_found{}; i < n_samples; ++i) {
+    if (sample_to_vertex[i] == n_found) {
+      vertex_samples[n_found++] = i;
+    }
+  }
+  py::array_t<double> vertices({n_vertices, dim});
+  double* vertices_ptr = static_cast<double*>(vertices.request().ptr);
+  auto evaluate_vertices = [&](const int begin, const int end, int) {
+    DoubleVector query(para_dim);
+    for (int i{begin}; i < end; ++i) {
+      const auto [i_patch, i_query] = std::div(vertex_samples[i], n_queries);
+      grids[i_patch].IdToGridPoint(i_query, query.data());
+      patches[i_patch]->SplinepyEvaluate(query.data(), &vertices_ptr[i * dim]);
+    }
+  };
+  splinepy::utils::NThreadExecution(evaluate_vertices, n_vertices, nthreads);
+
+  // cell corners relative to first corner. Lexicographic corners with
+  // swapped 3rd and 4th entry of each group of four give VTK ordering
+  const int n_corners = 1 << para_dim;
+  IntVector corner_offsets(n_corners);
+  for (int c{}; c < n_corners; ++c) {
+    int lexicographic{c};
+    if (para_dim > 1 && (c % 4) > 1) {
+      lexicographic = c - (c % 4) + 5 - (c % 4);
+    }
+    int offset{}, stride{1};
+    for (int j{}; j < para_dim; ++j) {
+      offset += ((lexicographic >> j) & 1) * stride;
+      stride *= resolution;
+    }
+    corner_offsets[c] = offset;
+  }
+
+  py::array_t<int> connectivity({n_patches * n_cells, n_corners});
+  int* connectivity_ptr = static_cast<int*>(connectivity.request().ptr);
+  auto connect = [&](const int begin, const int end, int) {
+    for (int i{begin}; i < end; ++i) {
+      const int i_patch = i / n_cells;
+      int remainder = i % n_cells;
+
+      // first corner of this cell
+      int first{}, stride{1};
+      for (int j{}; j < para_dim; ++j) {
+        first += (remainder % (resolution - 1)) * stride;
+        remainder /= resolution - 1;
+        stride *= resolution;
+      }
+      first += i_patch * n_queries;
+
+      for (int c{}; c < n_corners; ++c) {
+        connectivity_ptr[i * n_corners + c] =
+            sample_to_vertex[first + corner_offsets[c]];
+      }
+    }
+  };
+  splinepy::utils::NThreadExecution(connect, n_patches * n_cells, nthreads);
+
+  return py::make_tuple(vertices, connectivity);
+}
+
 void PyMultipatch::AddFields(py::list& fields,
                              const int field_dim,
                              const bool check_name,
@@ -1543,6 +2483,149 @@ void PyMultipatch::AddFields(py::list& fields,
   field_multipatches_ += local_fields;
 }
 
+py::list PyMultipatch::EvaluateWithFields(const py::array_t<double>& queries,
+                                          const py::object& patch_ids,
+                                          const int nthreads) {
+  const auto& patches = CorePatches();
+  const int n_patches = static_cast<int>(patches.size());
+  const int para_dim = ParaDim();
+
+  CheckPyArrayShape(queries, {-1, para_dim}, true);
+  const int n_queries = queries.shape(0);
+  const double* queries_ptr = static_cast<const double*>(queries.data());
+
+  // work items - either every query at every patch or grouped by patch ids
+  py::array_t<int> patch_ids_array;
+  const int* patch_ids_ptr{nullptr};
+  IntVector grouped_offsets, order;
+  int n_rows{n_patches * n_queries};
+  if (!patch_ids.is_none()) {
+    patch_ids_array = patch_ids.cast<py::array_t<int>>();
+    CheckPyArraySize(patch_ids_array, n_queries, true);
+    patch_ids_ptr = static_cast<const int*>(patch_ids_array.data());
+    GroupQueriesByPatch(patch_ids_ptr,
+                        n_queries,
+                        n_patches,
+                        grouped_offsets,
+                        order);
+    n_rows = n_queries;
+  }
+
+  // geometry is the first "field"
+  std::vector<const CorePatches_*> field_patches{&patches};
+  IntVector field_dims{Dim()};
+  for (auto& field : field_multipatches_) {
+    const auto field_ptr = field.cast<std::shared_ptr<PyMultipatch>>();
+    field_patches.push_back(&field_ptr->CorePatches());
+    field_dims.push_back(field_ptr->Dim());
+  }
+  const int n_fields = static_cast<int>(field_patches.size());
+
+  for (int i{1}; i < n_fields; ++i) {
+    if (static_cast<int>(field_patches[i]->size()) != n_patches) {
+      splinepy::utils::PrintAndThrowError("Field (",
+                                          i - 1,
+                                          ") has",
+                                          field_patches[i]->size(),
+                                          "patches, but",
+                                          n_patches,
+                                          "are expected.");
+    }
+  }
+
+  // which fields share basis with geometry and their control points
+  // (n_fields * n_patches)
+  const int n_pairs = n_fields * n_patches;
+  std::vector<char> shares_basis(n_pairs, 0);
+  std::vector<DoubleVector> control_points(n_pairs);
+  auto prepare_pairs = [&](const int begin, const int end, int) {
+    for (int i{begin}; i < end; ++i) {
+      const int i_field = i / n_patches;
+      const int i_patch = i % n_patches;
+      const auto& field_patch = (*field_patches[i_field])[i_patch];
+      if (!SharesBasis(patches[i_patch], field_patch)) {
+        continue;
+      }
+      shares_basis[i] = 1;
+      control_points[i].resize(field_patch->SplinepyNumberOfControlPoints()
+                               * field_dims[i_field]);
+      field_patch->SplinepyCurrentProperties(nullptr,
+                                             nullptr,
+                                             control_points[i].data(),
+                                             nullptr);
+    }
+  };
+  splinepy::utils::NThreadExecution(prepare_pairs, n_pairs, nthreads);
+
+  // outputs
+  py::list evaluated(n_fields);
+  std::vector<double*> evaluated_ptrs(n_fields);
+  for (int i{}; i < n_fields; ++i) {
+    py::array_t<double> field_evaluated({n_rows, field_dims[i]});
+    evaluated_ptrs[i] = static_cast<double*>(field_evaluated.request().ptr);
+    evaluated[i] = field_evaluated;
+  }
+
+  int max_n_supports{};
+  for (const auto& patch : patches) {
+    max_n_supports =
+        std::max(max_n_supports, patch->SplinepyNumberOfSupports());
+  }
+
+  auto evaluate = [&](const int begin, const int end, int) {
+    DoubleVector basis(max_n_supports);
+    IntVector support(max_n_supports);
+
+    for (int i{begin}; i < end; ++i) {
+      // row, patch and query of this work item
+      int row, i_patch, i_query;
+      if (patch_ids_ptr) {
+        row = order[i];
+        i_patch = patch_ids_ptr[row];
+        i_query = row;
+      } else {
+        row = i;
+        i_patch = i / n_queries;
+        i_query = i % n_queries;
+      }
+      const double* query = &queries_ptr[i_query * para_dim];
+
+      // basis once
+      const auto& patch = patches[i_patch];
+      const int n_supports = patch->SplinepyNumberOfSupports();
+      patch->SplinepyBasisAndSupport(query, basis.data(), support.data());
+
+      for (int i_field{}; i_field < n_fields; ++i_field) {
+        const int& field_dim = field_dims[i_field];
+        double* out = &evaluated_ptrs[i_field][row * field_dim];
+        const int pair_id = i_field * n_patches + i_patch;
+
+        if (shares_basis[pair_id]) {
+          const double* field_control_points = control_points[pair_id].data();
+          std::fill_n(out, field_dim, 0.);
+          for (int j{}; j < n_supports; ++j) {
+            const double* control_point =
+                &field_control_points[support[j] * field_dim];
+            for (int k{}; k < field_dim; ++k) {
+              out[k] += basis[j] * control_point[k];
+            }
+          }
+        } else {
+          const auto& field_patch = (*field_patches[i_field])[i_patch];
+          if (field_patch->SplinepyIsNull()) {
+            std::fill_n(out, field_dim, 0.);
+          } else {
+            field_patch->SplinepyEvaluate(query, out);
+          }
+        }
+      }
+    }
+  };
+  splinepy::utils::NThreadExecution(evaluate, n_rows, nthreads);
+
+  return evaluated;
+}
+
 int PyMultipatch::GetNumberOfControlPoints() {
   // Init return value
   int n_control_points{};
@@ -1601,6 +2684,794 @@ py::array_t<double> PyMultipatch::GetControlPoints() {
   return control_points;
 }
 
+py::tuple PyMultipatch::InterfaceOrientations(const double tolerance,
+                                              const int nthreads) {
+  const auto& patches = CorePatches();
+  const int para_dim = ParaDim();
+  const int n_element_faces = 2 * para_dim;
+
+  const auto interfaces = GetInterfaces(false);
+  const int* interfaces_ptr = static_cast<const int*>(interfaces.data());
+  const int n_total_faces = static_cast<int>(interfaces.size());
+
+  // connections from lower global face ids
+  IntVector base_faces;
+  for (int i{}; i < n_total_faces; ++i) {
+    if (interfaces_ptr[i] > i) {
+      base_faces.push_back(i);
+    }
+  }
+  const int n_connections = static_cast<int>(base_faces.size());
+
+  py::array_t<int> base_ids(n_connections), base_face_ids(n_connections),
+      neighbor_ids(n_connections), neighbor_face_ids(n_connections);
+  int* base_ids_ptr = static_cast<int*>(base_ids.request().ptr);
+  int* base_face_ids_ptr = static_cast<int*>(base_face_ids.request().ptr);
+  int* neighbor_ids_ptr = static_cast<int*>(neighbor_ids.request().ptr);
+  int* neighbor_face_ids_ptr =
+      static_cast<int*>(neighbor_face_ids.request().ptr);
+  for (int i{}; i < n_connections; ++i) {
+    const int& base_face = base_faces[i];
+    const int& neighbor_face = interfaces_ptr[base_face];
+    base_ids_ptr[i] = base_face / n_element_faces;
+    base_face_ids_ptr[i] = base_face % n_element_faces;
+    neighbor_ids_ptr[i] = neighbor_face / n_element_faces;
+    neighbor_face_ids_ptr[i] = neighbor_face % n_element_faces;
+  }
+
+  // axes without match stay -1
+  py::array_t<int> axis_mappings({n_connections, para_dim});
+  py::array_t<bool> axis_orientations({n_connections, para_dim});
+  std::fill_n(static_cast<int*>(axis_mappings.request().ptr),
+              n_connections * para_dim,
+              -1);
+  BoundaryOrientations(patches,
+                       n_connections,
+                       base_ids_ptr,
+                       base_face_ids_ptr,
+                       neighbor_ids_ptr,
+                       neighbor_face_ids_ptr,
+                       tolerance,
+                       nthreads,
+                       static_cast<int*>(axis_mappings.request().ptr),
+                       static_cast<bool*>(axis_orientations.request().ptr));
+
+  return py::make_tuple(base_ids,
+                        base_face_ids,
+                        neighbor_ids,
+                        neighbor_face_ids,
+                        axis_mappings,
+                        axis_orientations);
+}
+
+py::object PyMultipatch::Partition(const int n_parts,
+                                   const py::object& weights,
+                                   const bool renumber,
+                                   const int nthreads) {
+  const auto& patches = CorePatches();
+  const int n_patches = static_cast<int>(patches.size());
+  const int n_element_faces = ParaDim() * 2;
+
+  // patch weights
+  DoubleVector patch_weights(n_patches);
+  if (py::isinstance<py::str>(weights)) {
+    const auto weight_type = weights.cast<std::string>();
+    if (weight_type == "uniform") {
+      std::fill(patch_weights.begin(), patch_weights.end(), 1.);
+    } else if (weight_type == "control_points") {
+      for (int i{}; i < n_patches; ++i) {
+        patch_weights[i] = patches[i]->SplinepyNumberOfControlPoints();
+      }
+    } else if (weight_type == "elements") {
+      auto count_elements = [&](const int begin, const int end, int) {
+        std::vector<std::vector<double>> knot_vectors;
+        for (int i{begin}; i < end; ++i) {
+          const auto& patch = patches[i];
+          if (patch->SplinepyIsNull() || !patch->SplinepyHasKnotVectors()) {
+            patch_weights[i] = patch->SplinepyIsNull() ? 0. : 1.;
+            continue;
+          }
+          knot_vectors.clear();
+          patch->SplinepyCurrentProperties(nullptr,
+                                           &knot_vectors,
+                                           nullptr,
+                                           nullptr);
+          double n_elements{1.};
+          for (const auto& knot_vector : knot_vectors) {
+            int n_unique{1};
+            for (std::size_t j{1}; j < knot_vector.size(); ++j) {
+              if (knot_vector[j] != knot_vector[j - 1]) {
+                ++n_unique;
+              }
+            }
+            n_elements *= n_unique - 1;
+          }
+          patch_weights[i] = n_elements;
+        }
+      };
+      splinepy::utils::NThreadExecution(count_elements, n_patches, nthreads);
+    } else {
+      splinepy::utils::PrintAndThrowError(
+          "Unknown weights (",
+          weight_type,
+          "). Options are 'uniform', 'control_points' and 'elements'.");
+    }
+  } else {
+    const auto weights_array = weights.cast<py::array_t<double>>();
+    CheckPyArraySize(weights_array, n_patches, true);
+    std::copy_n(static_cast<const double*>(weights_array.data()),
+                n_patches,
+                patch_weights.begin());
+  }
+
+  // adjacency from interfaces
+  const auto interfaces = GetInterfaces(false);
+  const int* interfaces_ptr = static_cast<const int*>(interfaces.data());
+  IntVector edges;
+  for (int i{}; i < n_patches * n_element_faces; ++i) {
+    const int& neighbor_face = interfaces_ptr[i];
+    if (neighbor_face < 0) {
+      continue;
+    }
+    const int patch = i / n_element_faces;
+    const int neighbor = neighbor_face / n_element_faces;
+    // each interface appears twice
+    if (patch < neighbor) {
+      edges.push_back(patch);
+      edges.push_back(neighbor);
+    }
+  }
+  splinepy::utils::CsrGraph graph;
+  splinepy::utils::GraphFromEdges(n_patches,
+                                  edges.data(),
+                                  static_cast<int>(edges.size()) / 2,
+                                  graph);
+
+  py::array_t<int> parts(n_patches);
+  int* parts_ptr = static_cast<int*>(parts.request().ptr);
+  splinepy::utils::RecursiveBisection(graph,
+                                      patch_weights.data(),
+                                      n_parts,
+                                      parts_ptr);
+
+  if (!renumber) {
+    return parts;
+  }
+
+  py::array_t<int> order(n_patches);
+  splinepy::utils::PartitionOrder(graph,
+                                  parts_ptr,
+                                  n_parts,
+                                  static_cast<int*>(order.request().ptr));
+  return py::make_tuple(parts, order);
+}
+
+py::tuple PyMultipatch::GlobalControlPointIds(const double tolerance,
+                                              const int nthreads) {
+  const auto& patches = CorePatches();
+  const int n_patches = static_cast<int>(patches.size());
+  const int dim = Dim();
+  const int n_element_faces = ParaDim() * 2;
+
+  const auto interfaces = GetInterfaces(false);
+  const int* interfaces_ptr = static_cast<const int*>(interfaces.data());
+
+  // interfaces may be set by users. Check them before parallel sections
+  const int n_faces = n_patches * n_element_faces;
+  for (int i{}; i < n_faces; ++i) {
+    const int& partner = interfaces_ptr[i];
+    if (partner >= n_faces || (partner > -1 && interfaces_ptr[partner] != i)) {
+      splinepy::utils::PrintAndThrowError("Face (",
+                                          i,
+                                          ") has invalid interface (",
+                                          partner,
+                                          ").");
+    }
+  }
+
+  // offsets and control points
+  IntVector offsets(n_patches + 1);
+  offsets[0] = 0;
+  for (int i{}; i < n_patches; ++i) {
+    offsets[i + 1] = offsets[i] + patches[i]->SplinepyNumberOfControlPoints();
+  }
+  const int n_control_points = offsets[n_patches];
+
+  DoubleVector control_points(n_control_points * dim);
+  auto copy_control_points = [&](const int begin, const int end, int) {
+    for (int i{begin}; i < end; ++i) {
+      patches[i]->SplinepyCurrentProperties(nullptr,
+                                            nullptr,
+                                            &control_points[offsets[i] * dim],
+                                            nullptr);
+    }
+  };
+  splinepy::utils::NThreadExecution(copy_control_points, n_patches, nthreads);
+
+  // coincident pairs of each interface, collected per thread with global ids
+  IntVectorVector thread_pairs(nthreads);
+  auto find_pairs = [&](int, int, const int i_thread) {
+    IntVector pairs;
+    auto& global_pairs = thread_pairs[i_thread];
+    for (int i{i_thread}; i < n_faces; i += nthreads) {
+      // each interface once
+      const int& partner = interfaces_ptr[i];
+      if (partner <= i) {
+        continue;
+      }
+      const auto [patch_start, face_start] = std::div(i, n_element_faces);
+      const auto [patch_end, face_end] = std::div(partner, n_element_faces);
+
+      pairs.clear();
+      InterfaceControlPointPairs(patches[patch_start],
+                                 face_start,
+                                 &control_points[offsets[patch_start] * dim],
+                                 patches[patch_end],
+                                 face_end,
+                                 &control_points[offsets[patch_end] * dim],
+                                 tolerance,
+                                 pairs);
+      for (std::size_t j{}; j < pairs.size(); j += 2) {
+        global_pairs.push_back(offsets[patch_start] + pairs[j]);
+        global_pairs.push_back(offsets[patch_end] + pairs[j + 1]);
+      }
+    }
+  };
+  splinepy::utils::NThreadExecution(find_pairs, n_faces, nthreads);
+
+  // merge
+  splinepy::utils::UnionFind union_find(n_control_points);
+  for (const auto& pairs : thread_pairs) {
+    for (std::size_t j{}; j < pairs.size(); j += 2) {
+      union_find.Union(pairs[j], pairs[j + 1]);
+    }
+  }
+
+  py::array_t<int> local_to_global(n_control_points);
+  const int n_unique =
+      union_find.SetIds(static_cast<int*>(local_to_global.request().ptr));
+
+  return py::make_tuple(local_to_global, n_unique);
+}
+
+py::tuple PyMultipatch::BasisMatrix(const py::array_t<double>& queries,
+                                    const py::array_t<int>& patch_ids,
+                                    const py::object& orders,
+                                    const bool merge,
+                                    const double tolerance,
+                                    const int nthreads) {
+  const auto& patches = CorePatches();
+  const int n_patches = static_cast<int>(patches.size());
+  const int para_dim = ParaDim();
+
+  CheckPyArrayShape(queries, {-1, para_dim}, true);
+  const int n_queries = queries.shape(0);
+  CheckPyArraySize(patch_ids, n_queries, true);
+
+  // derivative orders
+  py::array_t<int> orders_array;
+  const int* orders_ptr{nullptr};
+  if (!orders.is_none()) {
+    orders_array = orders.cast<py::array_t<int>>();
+    CheckPyArraySize(orders_array, para_dim, true);
+    orders_ptr = static_cast<const int*>(orders_array.data());
+  }
+
+  // column ids
+  IntVector offsets(n_patches + 1), n_supports(n_patches);
+  offsets[0] = 0;
+  for (int i{}; i < n_patches; ++i) {
+    offsets[i + 1] = offsets[i] + patches[i]->SplinepyNumberOfControlPoints();
+    n_supports[i] = patches[i]->SplinepyNumberOfSupports();
+  }
+  int n_columns = offsets[n_patches];
+  py::array_t<int> local_to_global;
+  const int* local_to_global_ptr{nullptr};
+  if (merge) {
+    const auto global_ids = GlobalControlPointIds(tolerance, nthreads);
+    local_to_global = global_ids[0].cast<py::array_t<int>>();
+    local_to_global_ptr = static_cast<const int*>(local_to_global.data());
+    n_columns = global_ids[1].cast<int>();
+  }
+
+  // group queries by patch
+  const int* patch_ids_ptr = static_cast<const int*>(patch_ids.data());
+  IntVector grouped_offsets, order;
+  GroupQueriesByPatch(patch_ids_ptr,
+                      n_queries,
+                      n_patches,
+                      grouped_offsets,
+                      order);
+
+  // row pointers
+  py::array_t<int> indptr(n_queries + 1);
+  int* indptr_ptr = static_cast<int*>(indptr.request().ptr);
+  indptr_ptr[0] = 0;
+  for (int i{}; i < n_queries; ++i) {
+    indptr_ptr[i + 1] = indptr_ptr[i] + n_supports[patch_ids_ptr[i]];
+  }
+  const int n_entries = indptr_ptr[n_queries];
+
+  py::array_t<double> data(n_entries);
+  py::array_t<int> indices(n_entries);
+  double* data_ptr = static_cast<double*>(data.request().ptr);
+  int* indices_ptr = static_cast<int*>(indices.request().ptr);
+  const double* queries_ptr = static_cast<const double*>(queries.data());
+
+  // fill rows. Grouped order keeps each thread on few patches
+  auto fill_rows = [&](const int begin, const int end, int) {
+    for (int i{begin}; i < end; ++i) {
+      const int& i_query = order[i];
+      const int& patch_id = patch_ids_ptr[i_query];
+      double* row_data = &data_ptr[indptr_ptr[i_query]];
+      int* row_indices = &indices_ptr[indptr_ptr[i_query]];
+
+      if (orders_ptr) {
+        patches[patch_id]->SplinepyBasisDerivativeAndSupport(
+            &queries_ptr[i_query * para_dim],
+            orders_ptr,
+            row_data,
+            row_indices);
+      } else {
+        patches[patch_id]->SplinepyBasisAndSupport(
+            &queries_ptr[i_query * para_dim],
+            row_data,
+            row_indices);
+      }
+
+      const int& offset = offsets[patch_id];
+      for (int j{}; j < n_supports[patch_id]; ++j) {
+        row_indices[j] += offset;
+        if (local_to_global_ptr) {
+          row_indices[j] = local_to_global_ptr[row_indices[j]];
+        }
+      }
+    }
+  };
+  splinepy::utils::NThreadExecution(fill_rows, n_queries, nthreads);
+
+  return py::make_tuple(data, indices, indptr, n_columns);
+}
+
+void PyMultipatch::SetControlPoints(const py::array_t<double>& control_points,
+                                    const int nthreads) {
+  const int dim = Dim();
+  const int n_patches = static_cast<int>(CorePatches().size());
+
+  // offsets, with total number of control points at the end
+  IntVector offsets(n_patches + 1);
+  offsets[0] = 0;
+  for (int i{}; i < n_patches; ++i) {
+    offsets[i + 1] =
+        offsets[i] + core_patches_[i]->SplinepyNumberOfControlPoints();
+  }
+  CheckPyArrayShape(control_points, {offsets[n_patches], dim}, true);
+  const double* control_points_ptr =
+      static_cast<const double*>(control_points.data());
+
+  // bounding boxes and kdtrees are outdated
+  point_location_ = nullptr;
+
+  // control points saved on python side may be copies of core's control
+  // points. Collect them with GIL, so that they can be updated in parallel.
+  std::vector<double*> cached_ptrs(n_patches, nullptr);
+  if (!has_null_splines_ && static_cast<int>(patches_.size()) == n_patches) {
+    for (int i{}; i < n_patches; ++i) {
+      auto& data =
+          patches_[i].template cast<std::shared_ptr<PySpline>>()->data_;
+      if (!data.contains("control_points")) {
+        continue;
+      }
+      py::object cached = data["control_points"];
+      if (!py::isinstance<py::array_t<double>>(cached)) {
+        continue;
+      }
+      auto cached_array = cached.cast<py::array_t<double>>();
+      if (cached_array.size() == (offsets[i + 1] - offsets[i]) * dim) {
+        cached_ptrs[i] = static_cast<double*>(cached_array.request().ptr);
+      }
+    }
+  }
+
+  // scatter
+  auto set_control_points = [&](const int begin, const int end, int) {
+    for (int i{begin}; i < end; ++i) {
+      const auto& patch = core_patches_[i];
+      if (patch->SplinepyIsNull()) {
+        continue;
+      }
+      const double* patch_values = &control_points_ptr[offsets[i] * dim];
+      patch->SplinepyControlPointPointers()->Sync(patch_values);
+      if (cached_ptrs[i] && cached_ptrs[i] != patch_values) {
+        std::copy_n(patch_values,
+                    (offsets[i + 1] - offsets[i]) * dim,
+                    cached_ptrs[i]);
+      }
+    }
+  };
+  splinepy::utils::NThreadExecution(set_control_points, n_patches, nthreads);
+}
+
+py::object
+PyMultipatch::SignedDistanceField(const py::array_t<double>& grid_bounds,
+                                  const py::array_t<int>& grid_resolutions,
+                                  const int sample_resolution,
+                                  const double band_width,
+                                  const int n_candidates,
+                                  const double tolerance,
+                                  const int max_iterations,
+                                  const bool sparse,
+                                  const int nthreads) {
+  const int para_dim = ParaDim();
+  const int dim = Dim();
+
+  CheckPyArrayShape(grid_bounds, {2, dim}, true);
+  CheckPyArraySize(grid_resolutions, dim, true);
+
+  // prepare boundaries and their normal orientations
+  CoreSplineVector boundaries;
+  DoubleVector normal_orientations;
+
+  if (para_dim == dim) {
+    const auto boundary_pids = BoundaryPatchIds(-1);
+    const int* boundary_pids_ptr =
+        static_cast<int*>(boundary_pids.request().ptr);
+    boundaries = BoundaryMultipatch(-1)->core_patches_;
+
+    const int n_boundaries = static_cast<int>(boundaries.size());
+    const int n_faces = 2 * para_dim;
+    const int b_para_dim = para_dim - 1;
+    normal_orientations.resize(n_boundaries);
+
+    // boundary normals should point away from the patch: against the
+    // parametric axis on lower faces and along it on upper faces
+    auto orient_boundaries = [&](const int begin, const int end, int) {
+      DoubleVector face_centers(n_faces * para_dim), axis_derivative(dim),
+          b_bounds(2 * b_para_dim), b_center(b_para_dim),
+          b_first_derivatives(b_para_dim * dim), normal(dim);
+      IntVector derivative_query(para_dim), b_derivative_query(b_para_dim);
+
+      for (int i{begin}; i < end; ++i) {
+        const auto [i_patch, i_face] = std::div(boundary_pids_ptr[i], n_faces);
+        const auto& patch = *core_patches_[i_patch];
+        const int axis = i_face / 2;
+
+        // derivative along the face normal axis at face center
+        splinepy::splines::helpers::ScalarTypeBoundaryCenters(
+            patch,
+            face_centers.data());
+        std::fill(derivative_query.begin(), derivative_query.end(), 0);
+        derivative_query[axis] = 1;
+        patch.SplinepyDerivative(&face_centers[i_face * para_dim],
+                                 derivative_query.data(),
+                                 axis_derivative.data());
+
+        // boundary normal at its parametric center
+        const auto& boundary = *boundaries[i];
+        boundary.SplinepyParametricBounds(b_bounds.data());
+        for (int j{}; j < b_para_dim; ++j) {
+          b_center[j] = .5 * (b_bounds[j] + b_bounds[j + b_para_dim]);
+        }
+        std::fill(b_derivative_query.begin(), b_derivative_query.end(), 0);
+        for (int j{}; j < b_para_dim; ++j) {
+          b_derivative_query[j] = 1;
+          boundary.SplinepyDerivative(b_center.data(),
+                                      b_derivative_query.data(),
+                                      &b_first_derivatives[j * dim]);
+          b_derivative_query[j] = 0;
+        }
+        splinepy::proximity::SignedDistance::NormalFromFirstDerivatives(
+            b_first_derivatives.data(),
+            dim,
+            normal.data());
+
+        double dot{};
+        for (int k{}; k < dim; ++k) {
+          dot += normal[k] * axis_derivative[k];
+        }
+        // lower faces point against the axis
+        if (i_face % 2 == 0) {
+          dot = -dot;
+        }
+        normal_orientations[i] = (dot < 0.) ? -1. : 1.;
+      }
+    };
+
+    splinepy::utils::NThreadExecution(orient_boundaries,
+                                      n_boundaries,
+                                      nthreads);
+  } else if (para_dim == dim - 1) {
+    boundaries = core_patches_;
+  } else {
+    splinepy::utils::PrintAndThrowError(
+        "Signed distance field requires para_dim == dim or para_dim == dim - "
+        "1. Given para_dim:",
+        para_dim,
+        "dim:",
+        dim);
+  }
+
+  // sample boundaries and plant a tree
+  const splinepy::proximity::SignedDistance signed_distance(
+      boundaries,
+      (normal_orientations.size() > 0) ? normal_orientations.data() : nullptr,
+      sample_resolution,
+      nthreads);
+
+  const double* grid_bounds_ptr =
+      static_cast<double*>(grid_bounds.request().ptr);
+  const int* grid_resolutions_ptr =
+      static_cast<int*>(grid_resolutions.request().ptr);
+
+  if (sparse) {
+    IntVector grid_ids;
+    DoubleVector distances;
+    signed_distance.SampleGridSparse(grid_bounds_ptr,
+                                     grid_resolutions_ptr,
+                                     band_width,
+                                     n_candidates,
+                                     tolerance,
+                                     max_iterations,
+                                     nthreads,
+                                     grid_ids,
+                                     distances);
+
+    const int n_in_band = static_cast<int>(grid_ids.size());
+    py::array_t<int> py_grid_ids(n_in_band);
+    py::array_t<double> py_distances(n_in_band);
+    std::copy_n(grid_ids.data(),
+                n_in_band,
+                static_cast<int*>(py_grid_ids.request().ptr));
+    std::copy_n(distances.data(),
+                n_in_band,
+                static_cast<double*>(py_distances.request().ptr));
+
+    return py::make_tuple(py_grid_ids, py_distances);
+  }
+
+  int n_grid_points{1};
+  for (int i{}; i < dim; ++i) {
+    n_grid_points *= grid_resolutions_ptr[i];
+  }
+  py::array_t<double> distances(n_grid_points);
+  signed_distance.SampleGrid(grid_bounds_ptr,
+                             grid_resolutions_ptr,
+                             band_width,
+                             n_candidates,
+                             tolerance,
+                             max_iterations,
+                             nthreads,
+                             static_cast<double*>(distances.request().ptr));
+
+  return distances;
+}
+
+py::tuple PyMultipatch::LocatePoints(const py::array_t<double>& queries,
+                                     const int sample_resolution,
+                                     const double tolerance,
+                                     const double newton_tolerance,
+                                     const int max_iterations,
+                                     const int nthreads) {
+  const int para_dim = ParaDim();
+  const int dim = Dim();
+
+  CheckPyArrayShape(queries, {-1, dim}, true);
+
+  // bounding structure and kdtrees of each patch. Kept for next calls
+  if (!point_location_
+      || point_location_->SampleResolution() != sample_resolution
+      || point_location_->Tolerance() != tolerance) {
+    point_location_ =
+        std::make_shared<const splinepy::proximity::PointLocation>(
+            core_patches_,
+            sample_resolution,
+            tolerance,
+            nthreads);
+  }
+
+  // prepare output
+  const int n_queries = queries.shape(0);
+  py::array_t<int> patch_ids(n_queries);
+  py::array_t<double> para_coords({n_queries, para_dim});
+
+  point_location_->LocateMany(static_cast<double*>(queries.request().ptr),
+                              n_queries,
+                              newton_tolerance,
+                              max_iterations,
+                              nthreads,
+                              static_cast<int*>(patch_ids.request().ptr),
+                              static_cast<double*>(para_coords.request().ptr));
+
+  return py::make_tuple(patch_ids, para_coords);
+}
+
+py::object CreateMany(const py::array_t<int>& degrees,
+                      const py::array_t<double>& control_points,
+                      const py::object& knot_vectors,
+                      const py::object& knot_vector_offsets,
+                      const py::object& weights,
+                      const bool as_multipatch,
+                      const int nthreads) {
+  if (degrees.ndim() != 2 || control_points.ndim() != 2) {
+    splinepy::utils::PrintAndThrowError(
+        "degrees and control_points should be 2D arrays.");
+  }
+  const int n_splines = static_cast<int>(degrees.shape(0));
+  const int para_dim = static_cast<int>(degrees.shape(1));
+  const int dim = static_cast<int>(control_points.shape(1));
+  const int n_control_points = static_cast<int>(control_points.shape(0));
+  const int* degrees_ptr = static_cast<const int*>(degrees.data());
+  const double* control_points_ptr =
+      static_cast<const double*>(control_points.data());
+
+  if (n_splines < 1 || para_dim < 1 || dim < 1) {
+    splinepy::utils::PrintAndThrowError(
+        "create_many requires at least one spline with positive dimensions.");
+  }
+
+  // knot vectors
+  const bool has_knot_vectors = !knot_vectors.is_none();
+  py::array_t<double> knots;
+  py::array_t<int> knot_offsets;
+  const double* knots_ptr{nullptr};
+  const int* knot_offsets_ptr{nullptr};
+  if (has_knot_vectors) {
+    if (knot_vector_offsets.is_none()) {
+      splinepy::utils::PrintAndThrowError(
+          "knot_vector_offsets are required with knot_vectors.");
+    }
+    knots = knot_vectors.cast<py::array_t<double>>();
+    knot_offsets = knot_vector_offsets.cast<py::array_t<int>>();
+    CheckPyArraySize(knot_offsets, n_splines * para_dim + 1, true);
+    knots_ptr = static_cast<const double*>(knots.data());
+    knot_offsets_ptr = static_cast<const int*>(knot_offsets.data());
+    if (knot_offsets_ptr[0] != 0
+        || knot_offsets_ptr[n_splines * para_dim] != knots.size()) {
+      splinepy::utils::PrintAndThrowError(
+          "knot_vector_offsets should start with 0 and end with the number of "
+          "knots (",
+          knots.size(),
+          ").");
+    }
+    // together with the first and last entry, this keeps all offsets within
+    // knots
+    for (int i{1}; i < n_splines * para_dim + 1; ++i) {
+      if (knot_offsets_ptr[i] < knot_offsets_ptr[i - 1]) {
+        splinepy::utils::PrintAndThrowError(
+            "knot_vector_offsets should not decrease. Offset (",
+            i,
+            ") is smaller than its predecessor.");
+      }
+    }
+  }
+
+  // weights
+  py::array_t<double> weights_array;
+  double* weights_ptr{nullptr};
+  if (!weights.is_none()) {
+    weights_array = weights.cast<py::array_t<double>>();
+    CheckPyArraySize(weights_array, n_control_points, true);
+    weights_ptr = const_cast<double*>(
+        static_cast<const double*>(weights_array.data()));
+  }
+
+  // validate and count control points per spline
+  IntVector control_point_offsets(n_splines + 1);
+  control_point_offsets[0] = 0;
+  std::string error_info{};
+  std::mutex error_mutex;
+  auto validate = [&](const int begin, const int end, int) {
+    for (int i{begin}; i < end; ++i) {
+      std::string spline_error{};
+      int n_spline_control_points{1};
+      for (int j{}; j < para_dim; ++j) {
+        const int& degree = degrees_ptr[i * para_dim + j];
+        if (degree < 0) {
+          spline_error += " Negative degree along parametric dimension ("
+                          + std::to_string(j) + ").";
+          break;
+        }
+        if (!has_knot_vectors) {
+          n_spline_control_points *= degree + 1;
+          continue;
+        }
+
+        const int kv_begin = knot_offsets_ptr[i * para_dim + j];
+        const int kv_end = knot_offsets_ptr[i * para_dim + j + 1];
+        const int n_knots = kv_end - kv_begin;
+        if (n_knots < 2 * (degree + 1)) {
+          spline_error += " Not enough knots in parametric dimension ("
+                          + std::to_string(j) + ").";
+          break;
+        }
+        for (int k{kv_begin + 1}; k < kv_end; ++k) {
+          if (knots_ptr[k - 1] > knots_ptr[k]) {
+            spline_error += " Knots of parametric dimension ("
+                            + std::to_string(j)
+                            + ") are not in increasing order.";
+            break;
+          }
+        }
+        n_spline_control_points *= n_knots - degree - 1;
+      }
+
+      if (!spline_error.empty()) {
+        std::lock_guard<std::mutex> guard(error_mutex);
+        error_info += "[spline (" + std::to_string(i) + ")]" + spline_error
+                      + "\n";
+      }
+      control_point_offsets[i + 1] = n_spline_control_points;
+    }
+  };
+  splinepy::utils::NThreadExecution(validate, n_splines, nthreads);
+  if (!error_info.empty()) {
+    splinepy::utils::PrintAndThrowError(error_info);
+  }
+
+  for (int i{}; i < n_splines; ++i) {
+    control_point_offsets[i + 1] += control_point_offsets[i];
+  }
+  if (control_point_offsets[n_splines] != n_control_points) {
+    splinepy::utils::PrintAndThrowError("Invalid number of control points.",
+                                        control_point_offsets[n_splines],
+                                        "expected, but",
+                                        n_control_points,
+                                        "were given.");
+  }
+
+  // each spline gets its own copy of control points. BSpline cores keep a
+  // view on them, which is kept alive in PySpline::data_, same as NewCore.
+  // arrays are allocated here, as worker threads don't hold the GIL
+  std::vector<py::array_t<double>> spline_control_points(n_splines);
+  std::vector<double*> spline_control_points_ptrs(n_splines);
+  for (int i{}; i < n_splines; ++i) {
+    spline_control_points[i] = py::array_t<double>(
+        {control_point_offsets[i + 1] - control_point_offsets[i], dim});
+    spline_control_points_ptrs[i] =
+        static_cast<double*>(spline_control_points[i].request().ptr);
+  }
+
+  // create cores. Exceptions of workers are rethrown here
+  CoreSplineVector cores(n_splines);
+  auto create = [&](const int begin, const int end, int) {
+    std::vector<std::vector<double>> spline_knot_vectors(para_dim);
+    for (int i{begin}; i < end; ++i) {
+      if (has_knot_vectors) {
+        for (int j{}; j < para_dim; ++j) {
+          spline_knot_vectors[j].assign(
+              &knots_ptr[knot_offsets_ptr[i * para_dim + j]],
+              &knots_ptr[knot_offsets_ptr[i * para_dim + j + 1]]);
+        }
+      }
+      const int& offset = control_point_offsets[i];
+      std::copy(&control_points_ptr[offset * dim],
+                &control_points_ptr[control_point_offsets[i + 1] * dim],
+                spline_control_points_ptrs[i]);
+      cores[i] = splinepy::splines::SplinepyBase::SplinepyCreate(
+          para_dim,
+          dim,
+          &degrees_ptr[i * para_dim],
+          has_knot_vectors ? &spline_knot_vectors : nullptr,
+          spline_control_points_ptrs[i],
+          weights_ptr ? &weights_ptr[offset] : nullptr);
+    }
+  };
+  splinepy::utils::NThreadExecution(create, n_splines, nthreads);
+
+  // python objects - serial
+  py::list splines(n_splines);
+  for (int i{}; i < n_splines; ++i) {
+    auto spline = std::make_shared<PySpline>(cores[i]);
+    spline->data_["control_points"] = spline_control_points[i];
+    splines[i] = spline->ToDerived();
+  }
+  if (!as_multipatch) {
+    return splines;
+  }
+
+  return ToDerived(std::make_shared<PyMultipatch>(splines, nthreads));
+}
+
 py::object ToDerived(std::shared_ptr<PyMultipatch> core_obj) {
   const auto to_derived = py::module_::import("splinepy").attr("to_derived");
   return to_derived(py::cast(core_obj));
@@ -1615,6 +3486,15 @@ void init_multipatch(py::module_& m) {
         py::arg("face_center_vertices"),
         py::arg("tolerance"),
         py::arg("para_dim"));
+  m.def("create_many",
+        &splinepy::py::CreateMany,
+        py::arg("degrees"),
+        py::arg("control_points"),
+        py::arg("knot_vectors"),
+        py::arg("knot_vector_offsets"),
+        py::arg("weights"),
+        py::arg("as_multipatch"),
+        py::arg("nthreads"));
   m.def("extract_all_boundary_splines",
         &splinepy::py::ExtractAllBoundarySplines,
         py::arg("splines"),
@@ -1655,6 +3535,32 @@ void init_multipatch(py::module_& m) {
       .def_property_readonly("whatami", &PyMultipatch::WhatAmI)
       .def_property_readonly("control_points", &PyMultipatch::GetControlPoints)
       .def("control_point_offsets", &PyMultipatch::GetControlPointOffsets)
+      .def("interface_orientations",
+           &PyMultipatch::InterfaceOrientations,
+           py::arg("tolerance"),
+           py::arg("nthreads"))
+      .def("partition",
+           &PyMultipatch::Partition,
+           py::arg("n_parts"),
+           py::arg("weights"),
+           py::arg("renumber"),
+           py::arg("nthreads"))
+      .def("global_control_point_ids",
+           &PyMultipatch::GlobalControlPointIds,
+           py::arg("tolerance"),
+           py::arg("nthreads"))
+      .def("basis_matrix",
+           &PyMultipatch::BasisMatrix,
+           py::arg("queries"),
+           py::arg("patch_ids"),
+           py::arg("orders"),
+           py::arg("merge"),
+           py::arg("tolerance"),
+           py::arg("nthreads"))
+      .def("set_control_points",
+           &PyMultipatch::SetControlPoints,
+           py::arg("control_points"),
+           py::arg("nthreads"))
       .def_property("patches",
                     &PyMultipatch::GetPatches,
                     &PyMultipatch::SetPatchesDefault)
@@ -1666,21 +3572,64 @@ void init_multipatch(py::module_& m) {
       .def("set_interfaces",
            &PyMultipatch::SetInterfaces,
            py::arg("interfaces"))
+      .def("non_manifold_faces", &PyMultipatch::GetNonManifoldFaces)
+      .def("append_patches",
+           &PyMultipatch::AppendPatches,
+           py::arg("patches"),
+           py::arg("nthreads"))
       .def("boundary_patch_ids",
            &PyMultipatch::BoundaryPatchIds,
            py::arg("bid") = -1)
       .def("boundary_multipatch",
            &PyMultipatch::PyBoundaryMultipatch,
            py::arg("bid") = -1)
+      .def_property_readonly("is_homogeneous", &PyMultipatch::IsHomogeneous)
       .def("evaluate",
            &PyMultipatch::Evaluate,
            py::arg("queries"),
            py::arg("nthreads"))
+      .def("evaluate_patches",
+           &PyMultipatch::EvaluatePatches,
+           py::arg("queries"),
+           py::arg("patch_ids"),
+           py::arg("nthreads"))
+      .def("derivative_patches",
+           &PyMultipatch::DerivativePatches,
+           py::arg("queries"),
+           py::arg("patch_ids"),
+           py::arg("orders"),
+           py::arg("nthreads"))
+      .def("jacobian_patches",
+           &PyMultipatch::JacobianPatches,
+           py::arg("queries"),
+           py::arg("patch_ids"),
+           py::arg("nthreads"))
+      .def("basis_and_support_patches",
+           &PyMultipatch::BasisAndSupportPatches,
+           py::arg("queries"),
+           py::arg("patch_ids"),
+           py::arg("nthreads"))
       .def("sample",
            &PyMultipatch::Sample,
            py::arg("resolution"),
            py::arg("nthreads"),
            py::arg("same_parametric_bounds"))
+      .def("sample_patches",
+           &PyMultipatch::SamplePatches,
+           py::arg("resolutions"),
+           py::arg("nthreads"))
+      .def("sample_resolutions",
+           &PyMultipatch::SampleResolutions,
+           py::arg("spacing"),
+           py::arg("min_resolution"),
+           py::arg("max_resolution"),
+           py::arg("nthreads"))
+      .def("sample_watertight",
+           &PyMultipatch::SampleWatertight,
+           py::arg("resolution"),
+           py::arg("tolerance"),
+           py::arg("angle_tolerance"),
+           py::arg("nthreads"))
       .def("add_fields",
            &PyMultipatch::AddFields,
            py::arg("fields"),
@@ -1691,6 +3640,30 @@ void init_multipatch(py::module_& m) {
            py::arg("checK_control_mesh_resolutions"),
            py::arg("nthreads"))
       .def("fields", &PyMultipatch::GetFields)
+      .def("evaluate_with_fields",
+           &PyMultipatch::EvaluateWithFields,
+           py::arg("queries"),
+           py::arg("patch_ids"),
+           py::arg("nthreads"))
+      .def("signed_distance_field",
+           &PyMultipatch::SignedDistanceField,
+           py::arg("grid_bounds"),
+           py::arg("grid_resolutions"),
+           py::arg("sample_resolution"),
+           py::arg("band_width"),
+           py::arg("n_candidates"),
+           py::arg("tolerance"),
+           py::arg("max_iterations"),
+           py::arg("sparse"),
+           py::arg("nthreads"))
+      .def("locate_points",
+           &PyMultipatch::LocatePoints,
+           py::arg("queries"),
+           py::arg("sample_resolution"),
+           py::arg("tolerance"),
+           py::arg("newton_tolerance"),
+           py::arg("max_iterations"),
+           py::arg("nthreads"))
       //.def("", &PyMultipatch::)
       ;
 }
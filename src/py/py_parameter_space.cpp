@@ -1,9 +1,12 @@
+#include <cstdint>
+
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
 #include <BSplineLib/ParameterSpaces/knot_vector.hpp>
 #include <BSplineLib/ParameterSpaces/parameter_space.hpp>
 
+#include "splinepy/py/py_parameter_space.hpp"
 #include "splinepy/utils/arrays.hpp"
 #include "splinepy/utils/print.hpp"
 
@@ -13,8 +16,7 @@ namespace py = pybind11;
 
 void init_parameter_space(py::module_& m) {
   using PSpace = bsplinelib::parameter_spaces::ParameterSpaceBase;
-  using KV = bsplinelib::parameter_spaces::KnotVector;
-  using KVPtr = std::shared_ptr<KV>;
+  using KVPtr = std::shared_ptr<bsplinelib::parameter_spaces::KnotVector>;
 
   // implementations adapted from pybind11/stl_bind.h
   /// as python supports negative ids, this func brings negative ids to pos
@@ -34,7 +36,7 @@ void init_parameter_space(py::module_& m) {
     // so, deepcopy it is.
     py::list kvs(p.ParaDim());
     for (int i{}; i < p.ParaDim(); ++i) {
-      KVPtr kv = p.GetKnotVector(i);
+      const KVPtr& kv = p.GetKnotVector(i);
       py::array_t<double> out_kv(kv->GetSize());
       std::copy_n(kv->GetKnots().data(),
                   kv->GetKnots().size(),
@@ -44,39 +46,38 @@ void init_parameter_space(py::module_& m) {
     return kvs;
   };
 
-  py::class_<PSpace, std::shared_ptr<PSpace>> klasse(m, "ParameterSpace");
+  py::class_<PyParameterSpace> klasse(m, "ParameterSpace");
 
   klasse
       .def(
           "__len__",
-          [](const PSpace& p) { return p.ParaDim(); },
+          [](const PyParameterSpace& p) { return p.Read()->ParaDim(); },
           "Returns number of parameter dimension.")
 
       .def(
           "__iter__",
-          [](PSpace& p) {
-            return py::make_iterator<
-                py::return_value_policy::reference_internal,
-                KVPtr*,
-                KVPtr*,
-                KVPtr&>(p.KnotVectorsBegin(), p.KnotVectorsEnd());
+          [](const PyParameterSpace& p) {
+            const int para_dim = p.Read()->ParaDim();
+            py::list items(para_dim);
+            for (int i{}; i < para_dim; ++i) {
+              items[i] = p.KnotVector(i);
+            }
+            return py::iter(items);
           },
-          py::keep_alive<0, 1>(),
-          "Support iterations of element references.")
+          "Support iterations of knot vectors.")
 
       .def(
           "__getitem__",
-          [wrap_id](PSpace& p, int i) -> KVPtr& {
-            i = wrap_id(i, p.ParaDim());
-            return p.GetKnotVector(i);
+          [wrap_id](const PyParameterSpace& p, int i) {
+            i = wrap_id(i, p.Read()->ParaDim());
+            return p.KnotVector(i);
           },
-          py::return_value_policy::reference_internal,
-          "int based __getitem__, which returns reference.")
+          "int based __getitem__, which returns knot vector of the spline.")
       .def(
           "__getitem__",
-          [](const PSpace& p, const py::slice& slice) -> py::list {
+          [](const PyParameterSpace& p, const py::slice& slice) -> py::list {
             std::size_t start{}, stop{}, step{}, slicelength{};
-            if (!slice.compute(static_cast<std::size_t>(p.ParaDim()),
+            if (!slice.compute(static_cast<std::size_t>(p.Read()->ParaDim()),
                                &start,
                                &stop,
                                &step,
@@ -85,7 +86,7 @@ void init_parameter_space(py::module_& m) {
             }
             py::list items{};
             for (std::size_t i{}; i < slicelength; ++i) {
-              items.append(p.GetKnotVector(static_cast<int>(start)));
+              items.append(p.KnotVector(static_cast<int>(start)));
               start += step;
             }
             return items;
@@ -94,23 +95,30 @@ void init_parameter_space(py::module_& m) {
           "support slice based __getitem__.")
       .def(
           "__setitem__",
-          [wrap_id](PSpace& p, int i, const KVPtr new_kv) {
-            i = wrap_id(i, p.ParaDim());
-            auto& p_kv = p.GetKnotVector(i);
-            if (p_kv->GetSize() != new_kv->GetSize()) {
+          [wrap_id](const PyParameterSpace& py_p,
+                    int i,
+                    const PyKnotVector& new_kv) {
+            i = wrap_id(i, py_p.Read()->ParaDim());
+            if (py_p.Read()->GetKnotVector(i)->GetSize()
+                != new_kv.Read()->GetSize()) {
               splinepy::utils::PrintAndThrowError(
                   "Size mismatch of lhs & rhs knot vectors");
             }
             // update is simple assignment - note that this is reference
-            // this is a same behavir as list
-            p_kv = new_kv;
+            // this is a same behavir as list. Both splines stop sharing
+            // their parameter spaces with others
+            KVPtr shared_kv = new_kv.Write();
+            py_p.Write()->GetKnotVector(i) = shared_kv;
           },
           "Single knot vector assignment with another knot vector.")
       .def(
           "__setitem__",
-          [wrap_id](PSpace& p, int i, const py::array_t<double>& new_kv) {
-            i = wrap_id(i, p.ParaDim());
-            auto& p_kv = p.GetKnotVector(i);
+          [wrap_id](const PyParameterSpace& py_p,
+                    int i,
+                    const py::array_t<double>& new_kv) {
+            i = wrap_id(i, py_p.Read()->ParaDim());
+            auto p = py_p.Write();
+            auto& p_kv = p->GetKnotVector(i);
             const int kv_size = p_kv->GetSize();
             if (kv_size != new_kv.size()) {
               splinepy::utils::PrintAndThrowError(
@@ -127,20 +135,21 @@ void init_parameter_space(py::module_& m) {
           },
           "Single knot vector assignment with an array")
       .def("__add__",
-           [to_list](const PSpace& p, py::list& next) {
-             return to_list(p) + next;
+           [to_list](const PyParameterSpace& p, py::list& next) {
+             return to_list(*p.Read()) + next;
            })
       .def("__radd__",
-           [to_list](const PSpace& p, py::list& next) {
-             return next + to_list(p);
+           [to_list](const PyParameterSpace& p, py::list& next) {
+             return next + to_list(*p.Read());
            })
       .def("__repr__",
-           [](const PSpace& p) {
+           [](const PyParameterSpace& py_p) {
+             const auto p = py_p.Read();
              std::string s{"ParameterSpace ["};
-             const int para_dim = p.ParaDim();
+             const int para_dim = p->ParaDim();
              const int last{para_dim - 1};
              for (int i{}; i < para_dim; ++i) {
-               s.append(p.GetKnotVector(i)->StringRepresentation());
+               s.append(p->GetKnotVector(i)->StringRepresentation());
                if (i != last) {
                  s.append(", ");
                }
@@ -148,8 +157,16 @@ void init_parameter_space(py::module_& m) {
              s.append("]");
              return s;
            })
-      .def("copy", [to_list](const PSpace& p) { return to_list(p); })
-      .def("unique_knots", [](const PSpace& p) {
+      .def("copy",
+           [to_list](const PyParameterSpace& p) { return to_list(*p.Read()); })
+      .def(
+          "_address",
+          [](const PyParameterSpace& p) {
+            return reinterpret_cast<std::uintptr_t>(p.Read().get());
+          },
+          "Address of the parameter space. Equal for splines sharing it.")
+      .def("unique_knots", [](const PyParameterSpace& py_p) {
+        const PSpace& p = *py_p.Read();
         py::list unique_knots;
 
         for (int i{}; i < p.ParaDim(); ++i) {
@@ -1,10 +1,12 @@
 #include <algorithm>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "splinepy/proximity/proximity.hpp"
 #include "splinepy/py/py_spline.hpp"
 // following four are required for Create* implementations
 #include "splinepy/splines/bezier.hpp"
@@ -13,6 +15,7 @@
 #include "splinepy/splines/rational_bezier.hpp"
 #include "splinepy/utils/grid_points.hpp"
 #include "splinepy/utils/nthreads.hpp"
+#include "splinepy/utils/scratch_arena.hpp"
 
 namespace splinepy::py {
 
@@ -190,14 +193,28 @@ void PySpline::NewCore(const py::kwargs& kwargs) {
     }
   }
 
+  // opt-in for non-rational beziers. (rational) bsplines view control
+  // points anyway and rational beziers save them weighted.
+  views_control_points_ = kwargs.contains("view_control_points")
+                          && kwargs["view_control_points"].cast<bool>()
+                          && !knot_vectors_ptr && !weights_ptr;
+
   // new assign
-  c_spline_ =
-      splinepy::splines::SplinepyBase::SplinepyCreate(para_dim,
-                                                      dim,
-                                                      degrees_ptr,
-                                                      knot_vectors_ptr,
-                                                      control_points_ptr,
-                                                      weights_ptr);
+  if (views_control_points_) {
+    c_spline_ = splinepy::splines::SplinepyBase::SplinepyCreateBezierView(
+        para_dim,
+        dim,
+        degrees_ptr,
+        control_points_ptr);
+  } else {
+    c_spline_ =
+        splinepy::splines::SplinepyBase::SplinepyCreate(para_dim,
+                                                        dim,
+                                                        degrees_ptr,
+                                                        knot_vectors_ptr,
+                                                        control_points_ptr,
+                                                        weights_ptr);
+  }
   para_dim_ = c_spline_->SplinepyParaDim();
   dim_ = c_spline_->SplinepyDim();
 }
@@ -210,6 +227,15 @@ PySpline::CoreSpline_& PySpline::Core() {
                                         "Please first initialize core spline.");
   }
 
+  // views keep their data_ buffer until anything but a query happens.
+  // Coordinate pointers handed out so far write to the new core.
+  if (views_control_points_) {
+    auto materialized = MaterializedCore();
+    materialized->SplinepyTakeOverControlPointPointers(*c_spline_);
+    c_spline_ = std::move(materialized);
+    views_control_points_ = false;
+  }
+
   return c_spline_;
 }
 
@@ -223,6 +249,24 @@ const PySpline::CoreSpline_& PySpline::Core() const {
   return c_spline_;
 }
 
+PySpline::CoreSpline_ PySpline::MaterializedCore() const {
+  const auto& core = Core();
+  std::vector<int> degrees(para_dim_);
+  std::vector<double> control_points(core->SplinepyNumberOfControlPoints()
+                                     * dim_);
+  core->SplinepyCurrentProperties(degrees.data(),
+                                  nullptr,
+                                  control_points.data(),
+                                  nullptr);
+  return splinepy::splines::SplinepyBase::SplinepyCreate(
+      para_dim_,
+      dim_,
+      degrees.data(),
+      nullptr,
+      control_points.data(),
+      nullptr);
+}
+
 py::array_t<int> PySpline::CurrentCoreDegrees() const {
   py::array_t<int> degrees(para_dim_);
   int* degrees_ptr = static_cast<int*>(degrees.request().ptr);
@@ -285,8 +329,17 @@ py::dict PySpline::CurrentCoreProperties() const {
   return dict_spline;
 }
 
+std::shared_ptr<PySpline> PySpline::CopyCore() const {
+  // copies own their control points
+  if (views_control_points_) {
+    return std::make_shared<PySpline>(MaterializedCore());
+  }
+  return std::make_shared<PySpline>(Core()->SplinepyDeepCopy());
+}
+
 py::tuple PySpline::CoordinatePointers() {
-  auto& core = *Core();
+  // views can write through coordinate pointers, too
+  auto& core = *std::as_const(*this).Core();
   if (core.SplinepyIsRational()) {
     auto wcpp = core.SplinepyWeightedControlPointPointers();
     return py::make_tuple(wcpp, wcpp->weight_pointers_);
@@ -295,14 +348,16 @@ py::tuple PySpline::CoordinatePointers() {
   }
 }
 
-std::shared_ptr<bsplinelib::parameter_spaces::ParameterSpaceBase>
-PySpline::ParameterSpace() {
-  return Core()->SplinepyParameterSpace();
+PyParameterSpace PySpline::ParameterSpace() {
+  // checks if there's a parameter space to share
+  std::as_const(*Core()).SplinepyParameterSpace();
+  return PyParameterSpace(Core());
 }
 
-std::shared_ptr<bsplinelib::parameter_spaces::KnotVector>
-PySpline::KnotVector(const int para_dim) {
-  return Core()->SplinepyKnotVector(para_dim);
+PyKnotVector PySpline::KnotVector(const int para_dim) {
+  // checks p_dim
+  std::as_const(*Core()).SplinepyKnotVector(para_dim);
+  return PyKnotVector(Core(), para_dim);
 }
 
 py::array_t<double> PySpline::ParametricBounds() const {
@@ -392,11 +447,11 @@ py::array_t<double> PySpline::Sample(py::array_t<int> resolutions,
 
   // wrap evaluate
   auto sample = [&](const int begin, const int end, int) {
-    std::vector<double> query(para_dim_);
-    double* query_ptr = query.data();
+    splinepy::utils::ScratchScope scratch;
+    double* query_ptr = scratch.Allocate<double>(para_dim_);
     for (int i{begin}; i < end; ++i) {
       grid.IdToGridPoint(i, query_ptr);
-      Core()->SplinepyEvaluate(&query[0], &sampled_ptr[i * dim_]);
+      Core()->SplinepyEvaluate(query_ptr, &sampled_ptr[i * dim_]);
     }
   };
 
@@ -664,7 +719,8 @@ PySpline::Proximities(py::array_t<double> queries,
                       double tolerance,
                       int max_iterations,
                       bool aggresive_search_bounds,
-                      int nthreads) {
+                      int nthreads,
+                      bool return_statistics) {
   CheckPyArrayShape(queries, {-1, dim_}, true);
   CheckPyArraySize(initial_guess_sample_resolutions, para_dim_);
 
@@ -693,6 +749,36 @@ PySpline::Proximities(py::array_t<double> queries,
       static_cast<double*>(first_derivatives.request().ptr);
   double* second_derivatives_ptr =
       static_cast<double*>(second_derivatives.request().ptr);
+
+  // statistics are kept in the proximity helper of the spline, which is
+  // shared by all calls. They are reset and recorded only during this call
+  splinepy::proximity::Proximity* proximity{nullptr};
+  py::array_t<int> iterations;
+  int* iterations_ptr{nullptr};
+  if (return_statistics) {
+    proximity = Core()->SplinepyProximity();
+    iterations = py::array_t<int>(n_queries);
+    iterations_ptr = static_cast<int*>(iterations.request().ptr);
+  }
+
+  auto proximities_with_statistics = [&](const int begin, const int end, int) {
+    for (int i{begin}; i < end; ++i) {
+      proximity->VerboseQuery(&queries_ptr[i * dim_],
+                              tolerance,
+                              max_iterations,
+                              aggresive_search_bounds,
+                              &para_coord_ptr[i * para_dim_],
+                              &phys_coord_ptr[i * dim_],
+                              &phys_diff_ptr[i * dim_],
+                              distance_ptr[i],
+                              convergence_norm_ptr[i],
+                              &first_derivatives_ptr[i * pd],
+                              &second_derivatives_ptr[i * ppd],
+                              false,
+                              &iterations_ptr[i]);
+    }
+  };
+
   auto proximities = [&](const int begin, const int end, int) {
     for (int i{begin}; i < end; ++i) {
       Core()->SplinepyVerboseProximity(&queries_ptr[i * dim_],
@@ -738,13 +824,28 @@ PySpline::Proximities(py::array_t<double> queries,
           res);
     }
   }
+  // inputs are valid - start recording. Recording stops at the end of the
+  // scope, also if queries throw
+  std::optional<splinepy::proximity::Proximity::ScopedStatisticsRecording>
+      recording;
+  if (return_statistics) {
+    proximity->ResetStatistics();
+    recording.emplace(*proximity);
+  }
+
   // yes, we could've built an input and called the function directly,
   // but, we will stick with calling interface functions
   if (plant_kdtree) {
     Core()->SplinepyPlantNewKdTreeForProximity(igsr_ptr, nthreads);
   }
 
-  splinepy::utils::NThreadExecution(proximities, n_queries, nthreads);
+  if (return_statistics) {
+    splinepy::utils::NThreadExecution(proximities_with_statistics,
+                                      n_queries,
+                                      nthreads);
+  } else {
+    splinepy::utils::NThreadExecution(proximities, n_queries, nthreads);
+  }
 
   para_coord.resize({n_queries, para_dim_});
   phys_coord.resize({n_queries, para_dim_});
@@ -754,6 +855,38 @@ PySpline::Proximities(py::array_t<double> queries,
   first_derivatives.resize({n_queries, para_dim_, dim_});
   second_derivatives.resize({n_queries, para_dim_, para_dim_, dim_});
 
+  if (return_statistics) {
+    recording.reset();
+    const auto& statistics = proximity->GetStatistics();
+
+    py::dict statistics_dict{};
+    statistics_dict["n_kdtree_plantings"] =
+        statistics.n_kdtree_plantings.load();
+    statistics_dict["n_samples"] = statistics.n_samples.load();
+    statistics_dict["sampling_time"] = 1e-9 * statistics.sampling_time.load();
+    statistics_dict["kdtree_build_time"] =
+        1e-9 * statistics.kdtree_build_time.load();
+    statistics_dict["n_queries"] = statistics.n_queries.load();
+    statistics_dict["n_iterations"] = statistics.n_iterations.load();
+    statistics_dict["n_max_iterations_reached"] =
+        statistics.n_max_iterations_reached.load();
+    statistics_dict["n_bound_hits"] = statistics.n_bound_hits.load();
+    statistics_dict["n_evaluations"] = statistics.n_evaluations.load();
+    statistics_dict["n_derivative_evaluations"] =
+        statistics.n_derivative_evaluations.load();
+    statistics_dict["query_time"] = 1e-9 * statistics.query_time.load();
+    statistics_dict["iterations"] = iterations;
+
+    return py::make_tuple(para_coord,
+                          phys_coord,
+                          phys_diff,
+                          distance,
+                          convergence_norm,
+                          first_derivatives,
+                          second_derivatives,
+                          statistics_dict);
+  }
+
   return py::make_tuple(para_coord,
                         phys_coord,
                         phys_diff,
@@ -811,6 +944,8 @@ void init_pyspline(py::module& m) {
       .def_readwrite("_data", &splinepy::py::PySpline::data_)
       .def_readonly("para_dim", &splinepy::py::PySpline::para_dim_)
       .def_readonly("dim", &splinepy::py::PySpline::dim_)
+      .def_readonly("_views_control_points",
+                    &splinepy::py::PySpline::views_control_points_)
       .def_property_readonly("whatami", &splinepy::py::PySpline::WhatAmI)
       .def_property_readonly("name", &splinepy::py::PySpline::Name)
       .def_property_readonly("has_knot_vectors",
@@ -826,6 +961,7 @@ void init_pyspline(py::module& m) {
       .def("current_core_properties",
            &splinepy::py::PySpline::CurrentCoreProperties)
       .def("_current_core_degrees", &splinepy::py::PySpline::CurrentCoreDegrees)
+      .def("_copy_core", &splinepy::py::PySpline::CopyCore)
       .def("_parameter_space", &splinepy::py::PySpline::ParameterSpace)
       .def("_knot_vector", &splinepy::py::PySpline::KnotVector)
       .def("_coordinate_pointers", &splinepy::py::PySpline::CoordinatePointers)
@@ -875,7 +1011,8 @@ void init_pyspline(py::module& m) {
            py::arg("tolerance"),
            py::arg("max_iterations") = -1,
            py::arg("aggressive_search_bounds") = false,
-           py::arg("nthreads") = 1)
+           py::arg("nthreads") = 1,
+           py::arg("return_statistics") = false)
       .def("elevate_degrees",
            &splinepy::py::PySpline::ElevateDegrees,
            py::arg("para_dims"))
@@ -1,5 +1,8 @@
 #include <pybind11/pybind11.h>
 
+#include "splinepy/splines/helpers/fixed_degree_kernels.hpp"
+#include "splinepy/splines/helpers/parameter_space_cache.hpp"
+
 // core_spline
 namespace splinepy::py {
 
@@ -56,10 +59,28 @@ PYBIND11_MODULE(splinepy_core, m) {
 #endif
   });
   m.def("is_minimal", []() {
-#ifdef SPLINEPY_MORE
+#if defined(SPLINEPY_MORE) || defined(SPLINEPY_LAZY_MORE)
     return false;
 #else
   return true;
 #endif
   });
+
+  // switch for compile-time degree kernels. returns previous state
+  m.def(
+      "use_fixed_degree_kernels",
+      [](const bool use) {
+        return splinepy::splines::helpers::FixedDegreeKernelsEnabled()
+            .exchange(use);
+      },
+      py::arg("use"));
+
+  // switch for sharing identical parameter spaces. returns previous state
+  m.def(
+      "use_parameter_space_interning",
+      [](const bool use) {
+        return splinepy::splines::helpers::ParameterSpaceInterningEnabled()
+            .exchange(use);
+      },
+      py::arg("use"));
 }
@@ -0,0 +1,100 @@
+#include <cstdlib>
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include <splinepy/splines/create/create_more.hpp>
+#include <splinepy/utils/print.hpp>
+
+// file name of the library is given by the build system
+#ifndef SPLINEPY_MORE_LIBRARY_NAME
+#if defined(_WIN32)
+#define SPLINEPY_MORE_LIBRARY_NAME "splinepy_more.dll"
+#else
+#define SPLINEPY_MORE_LIBRARY_NAME "splinepy_more.so"
+#endif
+#endif
+
+namespace splinepy::splines::create {
+
+namespace {
+
+/// @brief Directory of the binary that contains this function, with
+/// trailing separator. Empty if it can't be found.
+std::string ThisModuleDirectory() {
+  std::string path;
+#if defined(_WIN32)
+  HMODULE module{};
+  if (GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS
+                             | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                         reinterpret_cast<LPCSTR>(&ThisModuleDirectory),
+                         &module)) {
+    char buffer[MAX_PATH];
+    const DWORD length = GetModuleFileNameA(module, buffer, MAX_PATH);
+    path.assign(buffer, length);
+  }
+#else
+  Dl_info info;
+  if (dladdr(reinterpret_cast<void*>(&ThisModuleDirectory), &info)
+      && info.dli_fname) {
+    path = info.dli_fname;
+  }
+#endif
+  const auto separator = path.find_last_of("/\\");
+  if (separator == std::string::npos) {
+    return std::string{};
+  }
+  return path.substr(0, separator + 1);
+}
+
+/// @brief Opens library and looks up entry point. Library stays loaded.
+const MoreFactories* OpenMoreFactories(const std::string& path) {
+  using Entry_ = const MoreFactories* (*) ();
+#if defined(_WIN32)
+  HMODULE library = LoadLibraryA(path.c_str());
+  if (!library) {
+    return nullptr;
+  }
+  const auto entry = reinterpret_cast<Entry_>(
+      reinterpret_cast<void*>(GetProcAddress(library, kMoreFactoriesSymbol)));
+#else
+  void* library = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (!library) {
+    return nullptr;
+  }
+  const auto entry =
+      reinterpret_cast<Entry_>(dlsym(library, kMoreFactoriesSymbol));
+#endif
+  return (entry) ? entry() : nullptr;
+}
+
+} // namespace
+
+const MoreFactories* LoadMoreFactories() {
+  // thread safe, one time initialization
+  static const MoreFactories* factories = []() -> const MoreFactories* {
+    std::string path;
+    if (const char* env_path = std::getenv("SPLINEPY_MORE_LIBRARY")) {
+      path = env_path;
+    } else {
+      path = ThisModuleDirectory() + SPLINEPY_MORE_LIBRARY_NAME;
+    }
+
+    const MoreFactories* loaded = OpenMoreFactories(path);
+    if (!loaded) {
+      splinepy::utils::PrintWarning(
+          "Could not load splines with parametric dimension > 3 from",
+          path,
+          "- falling back to runtime dimensioned splines.");
+    }
+    return loaded;
+  }();
+
+  return factories;
+}
+
+} // namespace splinepy::splines::create
@@ -0,0 +1,162 @@
+#include <splinepy/splines/bspline.hpp>
+#include <splinepy/splines/create/create_bezier.hpp>
+#include <splinepy/splines/create/create_more.hpp>
+#include <splinepy/splines/create/create_rational_bezier.hpp>
+#include <splinepy/splines/nurbs.hpp>
+#include <splinepy/utils/print.hpp>
+
+namespace splinepy::splines::create {
+
+namespace {
+
+void ThrowInvalidParaDim(const char* spline_name, const int para_dim) {
+  splinepy::utils::PrintAndThrowError(spline_name,
+                                      "with parametric dimension",
+                                      para_dim,
+                                      "is not in this library.");
+}
+
+std::shared_ptr<SplinepyBase> MoreBezier(const int para_dim,
+                                         const int dim,
+                                         const int* degrees,
+                                         const double* control_points) {
+  switch (para_dim) {
+  case 4:
+    return CreateBezier4(dim, degrees, control_points);
+  case 5:
+    return CreateBezier5(dim, degrees, control_points);
+  case 6:
+    return CreateBezier6(dim, degrees, control_points);
+  case 7:
+    return CreateBezier7(dim, degrees, control_points);
+  case 8:
+    return CreateBezier8(dim, degrees, control_points);
+  case 9:
+    return CreateBezier9(dim, degrees, control_points);
+  case 10:
+    return CreateBezier10(dim, degrees, control_points);
+  default:
+    ThrowInvalidParaDim("Bezier", para_dim);
+  }
+  return std::shared_ptr<SplinepyBase>{};
+}
+
+std::shared_ptr<SplinepyBase> MoreRationalBezier(const int para_dim,
+                                                 const int dim,
+                                                 const int* degrees,
+                                                 const double* control_points,
+                                                 const double* weights) {
+  switch (para_dim) {
+  case 4:
+    return CreateRationalBezier4(dim, degrees, control_points, weights);
+  case 5:
+    return CreateRationalBezier5(dim, degrees, control_points, weights);
+  case 6:
+    return CreateRationalBezier6(dim, degrees, control_points, weights);
+  case 7:
+    return CreateRationalBezier7(dim, degrees, control_points, weights);
+  case 8:
+    return CreateRationalBezier8(dim, degrees, control_points, weights);
+  case 9:
+    return CreateRationalBezier9(dim, degrees, control_points, weights);
+  case 10:
+    return CreateRationalBezier10(dim, degrees, control_points, weights);
+  default:
+    ThrowInvalidParaDim("RationalBezier", para_dim);
+  }
+  return std::shared_ptr<SplinepyBase>{};
+}
+
+template<std::size_t para_dim>
+std::shared_ptr<SplinepyBase>
+MakeBSpline(const int dim,
+            const int* degrees,
+            const std::vector<std::vector<double>>* knot_vectors,
+            double* control_points) {
+  return std::make_shared<BSpline<para_dim>>(degrees,
+                                             *knot_vectors,
+                                             control_points,
+                                             dim);
+}
+
+std::shared_ptr<SplinepyBase>
+MoreBSpline(const int para_dim,
+            const int dim,
+            const int* degrees,
+            const std::vector<std::vector<double>>* knot_vectors,
+            double* control_points) {
+  switch (para_dim) {
+  case 4:
+    return MakeBSpline<4>(dim, degrees, knot_vectors, control_points);
+  case 5:
+    return MakeBSpline<5>(dim, degrees, knot_vectors, control_points);
+  case 6:
+    return MakeBSpline<6>(dim, degrees, knot_vectors, control_points);
+  case 7:
+    return MakeBSpline<7>(dim, degrees, knot_vectors, control_points);
+  case 8:
+    return MakeBSpline<8>(dim, degrees, knot_vectors, control_points);
+  case 9:
+    return MakeBSpline<9>(dim, degrees, knot_vectors, control_points);
+  case 10:
+    return MakeBSpline<10>(dim, degrees, knot_vectors, control_points);
+  default:
+    ThrowInvalidParaDim("BSpline", para_dim);
+  }
+  return std::shared_ptr<SplinepyBase>{};
+}
+
+template<std::size_t para_dim>
+std::shared_ptr<SplinepyBase>
+MakeNurbs(const int dim,
+          const int* degrees,
+          const std::vector<std::vector<double>>* knot_vectors,
+          double* control_points,
+          double* weights) {
+  return std::make_shared<Nurbs<para_dim>>(degrees,
+                                           *knot_vectors,
+                                           control_points,
+                                           weights,
+                                           dim);
+}
+
+std::shared_ptr<SplinepyBase>
+MoreNurbs(const int para_dim,
+          const int dim,
+          const int* degrees,
+          const std::vector<std::vector<double>>* knot_vectors,
+          double* control_points,
+          double* weights) {
+  switch (para_dim) {
+  case 4:
+    return MakeNurbs<4>(dim, degrees, knot_vectors, control_points, weights);
+  case 5:
+    return MakeNurbs<5>(dim, degrees, knot_vectors, control_points, weights);
+  case 6:
+    return MakeNurbs<6>(dim, degrees, knot_vectors, control_points, weights);
+  case 7:
+    return MakeNurbs<7>(dim, degrees, knot_vectors, control_points, weights);
+  case 8:
+    return MakeNurbs<8>(dim, degrees, knot_vectors, control_points, weights);
+  case 9:
+    return MakeNurbs<9>(dim, degrees, knot_vectors, control_points, weights);
+  case 10:
+    return MakeNurbs<10>(dim, degrees, knot_vectors, control_points, weights);
+  default:
+    ThrowInvalidParaDim("NURBS", para_dim);
+  }
+  return std::shared_ptr<SplinepyBase>{};
+}
+
+} // namespace
+
+} // namespace splinepy::splines::create
+
+const splinepy::splines::create::MoreFactories* SplinepyMoreFactories() {
+  using namespace splinepy::splines::create;
+  static const MoreFactories factories{&MoreBezier,
+                                       &MoreRationalBezier,
+                                       &MoreBSpline,
+                                       &MoreNurbs};
+  return &factories;
+}
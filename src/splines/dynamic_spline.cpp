@@ -0,0 +1,677 @@
+#include "splinepy/splines/dynamic_spline.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "splinepy/splines/helpers/basis_functions.hpp"
+#include "splinepy/utils/print.hpp"
+#include "splinepy/utils/scratch_arena.hpp"
+
+namespace splinepy::splines {
+
+namespace {
+
+/// @brief Binomial coefficient for small numbers
+inline double Binomial(const int n, const int k) {
+  double b{1.};
+  for (int i{1}; i <= k; ++i) {
+    b = b * (n - k + i) / i;
+  }
+  return b;
+}
+
+/// @brief Increments multi index with first entry fastest.
+/// @return false if it wrapped around
+inline bool Increment(const int n, const int* ends, int* multi_index) {
+  for (int i{}; i < n; ++i) {
+    if (++multi_index[i] < ends[i]) {
+      return true;
+    }
+    multi_index[i] = 0;
+  }
+  return false;
+}
+
+} // namespace
+
+DynamicSpline::DynamicSpline(
+    const int para_dim,
+    const int dim,
+    const int* degrees,
+    const std::vector<std::vector<double>>* knot_vectors,
+    const double* control_points,
+    const double* weights)
+    : para_dim_(para_dim),
+      dim_(dim),
+      is_rational_(weights != nullptr),
+      has_knot_vectors_(knot_vectors != nullptr) {
+  if (para_dim_ < 1 || dim_ < 1) {
+    splinepy::utils::PrintAndThrowError(
+        "DynamicSpline requires positive dimensions. Given - para_dim:",
+        para_dim_,
+        "dim:",
+        dim_);
+  }
+  if (has_knot_vectors_
+      && static_cast<int>(knot_vectors->size()) != para_dim_) {
+    splinepy::utils::PrintAndThrowError("Expected (",
+                                        para_dim_,
+                                        ") knot vectors. Given -",
+                                        knot_vectors->size());
+  }
+
+  degrees_.assign(degrees, degrees + para_dim_);
+  control_mesh_resolutions_.resize(para_dim_);
+  auto owned_knot_vectors =
+      std::make_shared<std::vector<std::vector<double>>>(para_dim_);
+  int n_control_points{1};
+  for (int i{}; i < para_dim_; ++i) {
+    const int& degree = degrees_[i];
+    if (degree < 0) {
+      splinepy::utils::PrintAndThrowError("Negative degree along parametric",
+                                          "dimension",
+                                          i);
+    }
+
+    auto& knot_vector = (*owned_knot_vectors)[i];
+    if (has_knot_vectors_) {
+      knot_vector = (*knot_vectors)[i];
+      if (!std::is_sorted(knot_vector.begin(), knot_vector.end())) {
+        splinepy::utils::PrintAndThrowError("Knot vector along parametric",
+                                            "dimension",
+                                            i,
+                                            "is not sorted.");
+      }
+    } else {
+      // bezier - open knot vector without interior knots
+      knot_vector.assign(2 * (degree + 1), 1.);
+      std::fill_n(knot_vector.begin(), degree + 1, 0.);
+    }
+
+    const int cmr = static_cast<int>(knot_vector.size()) - degree - 1;
+    if (cmr < degree + 1) {
+      splinepy::utils::PrintAndThrowError("Knot vector along parametric",
+                                          "dimension",
+                                          i,
+                                          "is too short for degree",
+                                          degree);
+    }
+    control_mesh_resolutions_[i] = cmr;
+    n_control_points *= cmr;
+  }
+  knot_vectors_ = std::move(owned_knot_vectors);
+
+  // views set their control points afterwards
+  if (!control_points) {
+    return;
+  }
+
+  // save weighted control points for rational splines
+  const int stride = Stride();
+  control_points_ = std::make_shared<DoubleVector_>(n_control_points * stride);
+  for (int i{}; i < n_control_points; ++i) {
+    const double weight = (is_rational_) ? weights[i] : 1.;
+    double* control_point = &(*control_points_)[i * stride];
+    for (int j{}; j < dim_; ++j) {
+      control_point[j] = control_points[i * dim_ + j] * weight;
+    }
+    if (is_rational_) {
+      control_point[dim_] = weight;
+    }
+  }
+}
+
+DynamicSpline::DynamicSpline(const int para_dim,
+                             const int dim,
+                             const int* degrees,
+                             double* control_points)
+    : DynamicSpline(para_dim, dim, degrees, nullptr, nullptr, nullptr) {
+  if (!control_points) {
+    splinepy::utils::PrintAndThrowError("DynamicSpline views need control",
+                                        "points.");
+  }
+  viewed_control_points_ = control_points;
+}
+
+DynamicSpline::DynamicSpline(const DynamicSpline& other)
+    : SplinepyBase(),
+      para_dim_(other.para_dim_),
+      dim_(other.dim_),
+      is_rational_(other.is_rational_),
+      has_knot_vectors_(other.has_knot_vectors_),
+      degrees_(other.degrees_),
+      knot_vectors_(other.knot_vectors_),
+      control_points_(other.control_points_),
+      control_mesh_resolutions_(other.control_mesh_resolutions_) {
+  // other may write through its pointers anytime and views don't own theirs
+  if (other.control_point_pointers_ || other.IsView()) {
+    const double* control_points = other.ControlPoints();
+    control_points_ = std::make_shared<DoubleVector_>(
+        control_points,
+        control_points + other.SplinepyNumberOfControlPoints() * Stride());
+  }
+}
+
+const double* DynamicSpline::ControlPoints() const {
+  return (IsView()) ? viewed_control_points_ : control_points_->data();
+}
+
+double* DynamicSpline::MutableControlPoints() {
+  if (IsView()) {
+    return viewed_control_points_;
+  }
+  if (control_points_.use_count() > 1) {
+    control_points_ = std::make_shared<DoubleVector_>(*control_points_);
+  }
+  return control_points_->data();
+}
+
+std::string DynamicSpline::SplinepySplineName() const {
+  if (has_knot_vectors_) {
+    return (is_rational_) ? "NURBS" : "BSpline";
+  }
+  return (is_rational_) ? "RationalBezier" : "Bezier";
+}
+
+std::string DynamicSpline::SplinepyWhatAmI() const {
+  return SplinepySplineName()
+         + ", parametric dimension: " + std::to_string(para_dim_)
+         + ", physical dimension: " + std::to_string(dim_);
+}
+
+int DynamicSpline::SplinepyNumberOfControlPoints() const {
+  int n_control_points{1};
+  for (const int& cmr : control_mesh_resolutions_) {
+    n_control_points *= cmr;
+  }
+  return n_control_points;
+}
+
+int DynamicSpline::SplinepyNumberOfSupports() const {
+  int n_supports{1};
+  for (const int& degree : degrees_) {
+    n_supports *= degree + 1;
+  }
+  return n_supports;
+}
+
+void DynamicSpline::SplinepyCurrentProperties(
+    int* degrees,
+    std::vector<std::vector<double>>* knot_vectors,
+    double* control_points,
+    double* weights) const {
+  if (degrees) {
+    std::copy(degrees_.begin(), degrees_.end(), degrees);
+  }
+
+  if (knot_vectors && has_knot_vectors_) {
+    knot_vectors->clear();
+    knot_vectors->reserve(para_dim_);
+    for (const auto& knot_vector : *knot_vectors_) {
+      knot_vectors->push_back(knot_vector);
+    }
+  }
+
+  const int n_control_points = SplinepyNumberOfControlPoints();
+  const int stride = Stride();
+  if (control_points) {
+    for (int i{}; i < n_control_points; ++i) {
+      const double* control_point = &ControlPoints()[i * stride];
+      const double inv_weight = (is_rational_) ? 1. / control_point[dim_] : 1.;
+      for (int j{}; j < dim_; ++j) {
+        control_points[i * dim_ + j] = control_point[j] * inv_weight;
+      }
+    }
+  }
+
+  if (weights && is_rational_) {
+    for (int i{}; i < n_control_points; ++i) {
+      weights[i] = ControlPoints()[i * stride + dim_];
+    }
+  }
+}
+
+std::shared_ptr<typename DynamicSpline::ControlPointPointers_>
+DynamicSpline::SplinepyControlPointPointers() {
+  if (is_rational_) {
+    return SplinepyWeightedControlPointPointers();
+  }
+
+  const int n_control_points = SplinepyNumberOfControlPoints();
+  if (control_point_pointers_
+      && control_point_pointers_->Len() == n_control_points) {
+    return control_point_pointers_;
+  }
+
+  double* control_points = MutableControlPoints();
+  auto cpp = std::make_shared<ControlPointPointers_>();
+  cpp->dim_ = dim_;
+  cpp->coordinate_begins_.resize(n_control_points);
+  for (int i{}; i < n_control_points; ++i) {
+    cpp->coordinate_begins_[i] = &control_points[i * dim_];
+  }
+  control_point_pointers_ = cpp;
+
+  return cpp;
+}
+
+std::shared_ptr<typename DynamicSpline::WeightedControlPointPointers_>
+DynamicSpline::SplinepyWeightedControlPointPointers() {
+  if (!is_rational_) {
+    return SplinepyBase::SplinepyWeightedControlPointPointers();
+  }
+
+  const int n_control_points = SplinepyNumberOfControlPoints();
+  if (control_point_pointers_
+      && control_point_pointers_->Len() == n_control_points) {
+    return control_point_pointers_;
+  }
+
+  const int stride = Stride();
+  double* control_points = MutableControlPoints();
+  auto wcpp = std::make_shared<WeightedControlPointPointers_>();
+  wcpp->dim_ = dim_;
+  wcpp->for_rational_ = true;
+  wcpp->coordinate_begins_.resize(n_control_points);
+  auto w = std::make_shared<WeightPointers_>();
+  w->weights_.resize(n_control_points);
+  for (int i{}; i < n_control_points; ++i) {
+    double* coord_begin = &control_points[i * stride];
+    wcpp->coordinate_begins_[i] = coord_begin;
+    w->weights_[i] = coord_begin + dim_;
+  }
+
+  // reference each other
+  w->control_point_pointers_ = wcpp; // weak-ref
+  wcpp->weight_pointers_ = w;
+
+  control_point_pointers_ = wcpp;
+
+  return wcpp;
+}
+
+std::shared_ptr<typename DynamicSpline::WeightPointers_>
+DynamicSpline::SplinepyWeightPointers() {
+  if (!is_rational_) {
+    return SplinepyBase::SplinepyWeightPointers();
+  }
+  return SplinepyWeightedControlPointPointers()->weight_pointers_;
+}
+
+void DynamicSpline::SplinepyParametricBounds(double* para_bounds) const {
+  for (int i{}; i < para_dim_; ++i) {
+    const auto& knot_vector = (*knot_vectors_)[i];
+    para_bounds[i] = knot_vector[degrees_[i]];
+    para_bounds[para_dim_ + i] = knot_vector[control_mesh_resolutions_[i]];
+  }
+}
+
+void DynamicSpline::SplinepyControlMeshResolutions(
+    int* control_mesh_res) const {
+  std::copy(control_mesh_resolutions_.begin(),
+            control_mesh_resolutions_.end(),
+            control_mesh_res);
+}
+
+void DynamicSpline::SplinepyGrevilleAbscissae(
+    double* greville_abscissae,
+    const int& i_para_dim,
+    const double& duplicate_tolerance) const {
+  const auto& knot_vector = (*knot_vectors_)[i_para_dim];
+  const int& degree = degrees_[i_para_dim];
+  const int& cmr = control_mesh_resolutions_[i_para_dim];
+
+  // same as helpers::GetGrevilleAbscissae
+  for (int j{}; j < cmr; ++j) {
+    if (degree == 0) {
+      greville_abscissae[j] = 0.5 * (knot_vector[j] + knot_vector[j + 1]);
+      continue;
+    }
+    double factor{};
+    for (int k{}; k < degree; ++k) {
+      factor += knot_vector[k + j + 1];
+    }
+    greville_abscissae[j] = factor / static_cast<double>(degree);
+  }
+
+  if (has_knot_vectors_ && duplicate_tolerance > 0.0) {
+    double previous_knot{greville_abscissae[1]};
+    for (int j{2}; j < cmr - 1; ++j) {
+      if (std::abs(previous_knot - greville_abscissae[j])
+          < duplicate_tolerance) {
+        greville_abscissae[j - 1] =
+            0.5 * (greville_abscissae[j - 2] + greville_abscissae[j - 1]);
+        greville_abscissae[j] =
+            0.5 * (greville_abscissae[j] + greville_abscissae[j + 1]);
+      } else {
+        previous_knot = greville_abscissae[j];
+      }
+    }
+  }
+}
+
+int DynamicSpline::Span(const int i_para_dim, const double para_coord) const {
+  const auto& knot_vector = (*knot_vectors_)[i_para_dim];
+  return splinepy::splines::helpers::FindKnotSpan(
+      knot_vector.data(),
+      static_cast<int>(knot_vector.size()),
+      degrees_[i_para_dim],
+      para_coord);
+}
+
+void DynamicSpline::BasisDerivatives1D(const int i_para_dim,
+                                       const double para_coord,
+                                       const int order,
+                                       DoubleVector_& derivatives) const {
+  const auto& knot_vector = (*knot_vectors_)[i_para_dim];
+  const int& p = degrees_[i_para_dim];
+  const int n_basis = p + 1;
+
+  // derivatives higher than degree vanish
+  derivatives.assign((order + 1) * n_basis, 0.);
+
+  splinepy::utils::ScratchScope scratch;
+  double* work = scratch.Allocate<double>(
+      splinepy::splines::helpers::BSplineBasis1DWorkSize(p));
+  for (int k{}; k <= std::min(order, p); ++k) {
+    splinepy::splines::helpers::BSplineBasis1D(
+        knot_vector.data(),
+        static_cast<int>(knot_vector.size()),
+        p,
+        para_coord,
+        k,
+        &derivatives[k * n_basis],
+        work);
+  }
+}
+
+void DynamicSpline::TensorBasisDerivatives(const double* para_coord,
+                                           const int* orders,
+                                           DoubleVector_& derivatives,
+                                           int* support) const {
+  const int n_supports = SplinepyNumberOfSupports();
+
+  // 1D derivatives and spans
+  std::vector<DoubleVector_> derivatives_1d(para_dim_);
+  IntVector_ spans(para_dim_), sub_ends(para_dim_), basis_ends(para_dim_);
+  int n_sub_orders{1};
+  for (int i{}; i < para_dim_; ++i) {
+    spans[i] = Span(i, para_coord[i]);
+    BasisDerivatives1D(i, para_coord[i], orders[i], derivatives_1d[i]);
+    sub_ends[i] = orders[i] + 1;
+    basis_ends[i] = degrees_[i] + 1;
+    n_sub_orders *= sub_ends[i];
+  }
+
+  // tensor product for each sub order
+  derivatives.resize(n_sub_orders * n_supports);
+  IntVector_ sub_order(para_dim_, 0), local(para_dim_);
+  double* current = derivatives.data();
+  do {
+    std::fill(local.begin(), local.end(), 0);
+    do {
+      double value{1.};
+      for (int i{}; i < para_dim_; ++i) {
+        value *= derivatives_1d[i][sub_order[i] * basis_ends[i] + local[i]];
+      }
+      *current++ = value;
+    } while (Increment(para_dim_, basis_ends.data(), local.data()));
+  } while (Increment(para_dim_, sub_ends.data(), sub_order.data()));
+
+  // global ids of supports
+  if (support) {
+    std::fill(local.begin(), local.end(), 0);
+    int* current_support = support;
+    do {
+      int id{}, stride{1};
+      for (int i{}; i < para_dim_; ++i) {
+        id += (spans[i] - degrees_[i] + local[i]) * stride;
+        stride *= control_mesh_resolutions_[i];
+      }
+      *current_support++ = id;
+    } while (Increment(para_dim_, basis_ends.data(), local.data()));
+  }
+}
+
+void DynamicSpline::SplinepyEvaluate(const double* para_coord,
+                                     double* evaluated) const {
+  IntVector_ orders(para_dim_, 0);
+  SplinepyDerivative(para_coord, orders.data(), evaluated);
+}
+
+void DynamicSpline::SplinepyDerivative(const double* para_coord,
+                                       const int* orders,
+                                       double* derived) const {
+  const int n_supports = SplinepyNumberOfSupports();
+  const int stride = Stride();
+  DoubleVector_ basis_der(n_supports);
+  IntVector_ support(n_supports);
+  SplinepyBasisDerivativeAndSupport(para_coord,
+                                    orders,
+                                    basis_der.data(),
+                                    support.data());
+
+  // rational basis is contracted with unweighted control points
+  std::fill_n(derived, dim_, 0.);
+  for (int i{}; i < n_supports; ++i) {
+    const double* control_point = &ControlPoints()[support[i] * stride];
+    const double value =
+        (is_rational_) ? basis_der[i] / control_point[dim_] : basis_der[i];
+    for (int j{}; j < dim_; ++j) {
+      derived[j] += value * control_point[j];
+    }
+  }
+}
+
+void DynamicSpline::SplinepyJacobian(const double* para_coord,
+                                     double* jacobians) const {
+  IntVector_ orders(para_dim_, 0);
+  DoubleVector_ derived(dim_);
+  for (int i{}; i < para_dim_; ++i) {
+    orders[i] = 1;
+    SplinepyDerivative(para_coord, orders.data(), derived.data());
+    for (int j{}; j < dim_; ++j) {
+      jacobians[j * para_dim_ + i] = derived[j];
+    }
+    orders[i] = 0;
+  }
+}
+
+void DynamicSpline::SplinepyBasis(const double* para_coord,
+                                  double* basis) const {
+  IntVector_ support(SplinepyNumberOfSupports());
+  SplinepyBasisAndSupport(para_coord, basis, support.data());
+}
+
+void DynamicSpline::SplinepyBasisDerivative(const double* para_coord,
+                                            const int* order,
+                                            double* basis_der) const {
+  IntVector_ support(SplinepyNumberOfSupports());
+  SplinepyBasisDerivativeAndSupport(para_coord,
+                                    order,
+                                    basis_der,
+                                    support.data());
+}
+
+void DynamicSpline::SplinepySupport(const double* para_coord,
+                                    int* support) const {
+  DoubleVector_ basis(SplinepyNumberOfSupports());
+  SplinepyBasisAndSupport(para_coord, basis.data(), support);
+}
+
+void DynamicSpline::SplinepyBasisAndSupport(const double* para_coord,
+                                            double* basis,
+                                            int* support) const {
+  IntVector_ orders(para_dim_, 0);
+  SplinepyBasisDerivativeAndSupport(para_coord, orders.data(), basis, support);
+}
+
+void DynamicSpline::SplinepyBasisDerivativeAndSupport(
+    const double* para_coord,
+    const int* orders,
+    double* basis_der,
+    int* support) const {
+  const int n_supports = SplinepyNumberOfSupports();
+  DoubleVector_ derivatives;
+  TensorBasisDerivatives(para_coord, orders, derivatives, support);
+
+  // non-rational - highest sub order is the last block
+  const int n_sub_orders = static_cast<int>(derivatives.size()) / n_supports;
+  if (!is_rational_) {
+    std::copy_n(&derivatives[(n_sub_orders - 1) * n_supports],
+                n_supports,
+                basis_der);
+    return;
+  }
+
+  // rational - with A = N w and W = sum(A), derivatives follow from
+  // A^(k) = sum_{j <= k} C(k, j) W^(j) R^(k - j) in increasing sub order.
+  const int stride = Stride();
+  DoubleVector_ weighted_sums(n_sub_orders, 0.);
+  for (int s{}; s < n_sub_orders; ++s) {
+    double* block = &derivatives[s * n_supports];
+    for (int i{}; i < n_supports; ++i) {
+      block[i] *= ControlPoints()[support[i] * stride + dim_];
+      weighted_sums[s] += block[i];
+    }
+  }
+
+  IntVector_ sub_ends(para_dim_), strides(para_dim_);
+  int sub_stride{1};
+  for (int i{}; i < para_dim_; ++i) {
+    sub_ends[i] = orders[i] + 1;
+    strides[i] = sub_stride;
+    sub_stride *= sub_ends[i];
+  }
+
+  // derivatives are overwritten in place with rational ones. sub orders
+  // j <= k have smaller indices, so they are final when k is processed
+  const double inv_weight_sum = 1. / weighted_sums[0];
+  IntVector_ k(para_dim_, 0), j(para_dim_), j_ends(para_dim_);
+  int s{};
+  do {
+    double* block = &derivatives[s * n_supports];
+    for (int d{}; d < para_dim_; ++d) {
+      j_ends[d] = k[d] + 1;
+    }
+    std::fill(j.begin(), j.end(), 0);
+    // skip j = 0
+    while (Increment(para_dim_, j_ends.data(), j.data())) {
+      double coefficient{1.};
+      int j_index{}, k_minus_j_index{};
+      for (int d{}; d < para_dim_; ++d) {
+        coefficient *= Binomial(k[d], j[d]);
+        j_index += j[d] * strides[d];
+        k_minus_j_index += (k[d] - j[d]) * strides[d];
+      }
+      coefficient *= weighted_sums[j_index];
+      const double* previous = &derivatives[k_minus_j_index * n_supports];
+      for (int i{}; i < n_supports; ++i) {
+        block[i] -= coefficient * previous[i];
+      }
+    }
+    for (int i{}; i < n_supports; ++i) {
+      block[i] *= inv_weight_sum;
+    }
+    ++s;
+  } while (Increment(para_dim_, sub_ends.data(), k.data()));
+
+  std::copy_n(&derivatives[(n_sub_orders - 1) * n_supports],
+              n_supports,
+              basis_der);
+}
+
+std::vector<std::vector<int>>
+DynamicSpline::SplinepyKnotMultiplicities() const {
+  if (!has_knot_vectors_) {
+    return SplinepyBase::SplinepyKnotMultiplicities();
+  }
+
+  std::vector<std::vector<int>> multiplicities(para_dim_);
+  for (int i{}; i < para_dim_; ++i) {
+    const auto& knot_vector = (*knot_vectors_)[i];
+    auto& multiplicity = multiplicities[i];
+    for (std::size_t j{}; j < knot_vector.size(); ++j) {
+      if (j != 0 && knot_vector[j] == knot_vector[j - 1]) {
+        ++multiplicity.back();
+      } else {
+        multiplicity.push_back(1);
+      }
+    }
+  }
+  return multiplicities;
+}
+
+std::shared_ptr<SplinepyBase>
+DynamicSpline::SplinepyExtractBoundary(const int& boundary_id) {
+  if (para_dim_ < 2) {
+    splinepy::utils::PrintAndThrowError(
+        "Boundary extraction requires a parametric dimension of at least 2.");
+  }
+  if (boundary_id < 0 || boundary_id >= 2 * para_dim_) {
+    splinepy::utils::PrintAndThrowError("Invalid boundary id (",
+                                        boundary_id,
+                                        ") for parametric dimension",
+                                        para_dim_);
+  }
+  const int axis = boundary_id / 2;
+  const int plane =
+      (boundary_id % 2 == 0) ? 0 : control_mesh_resolutions_[axis] - 1;
+
+  // properties without the normal axis
+  IntVector_ boundary_degrees(para_dim_ - 1), boundary_cmr(para_dim_ - 1),
+      mesh_strides(para_dim_);
+  std::vector<std::vector<double>> boundary_knot_vectors(para_dim_ - 1);
+  int n_boundary_control_points{1}, mesh_stride{1};
+  for (int i{}, j{}; i < para_dim_; ++i) {
+    mesh_strides[i] = mesh_stride;
+    mesh_stride *= control_mesh_resolutions_[i];
+    if (i == axis) {
+      continue;
+    }
+    boundary_degrees[j] = degrees_[i];
+    boundary_cmr[j] = control_mesh_resolutions_[i];
+    boundary_knot_vectors[j] = (*knot_vectors_)[i];
+    n_boundary_control_points *= boundary_cmr[j];
+    ++j;
+  }
+
+  // control mesh slice
+  const int stride = Stride();
+  DoubleVector_ control_points(n_boundary_control_points * dim_);
+  DoubleVector_ weights((is_rational_) ? n_boundary_control_points : 0);
+  IntVector_ multi_index(para_dim_ - 1, 0);
+  for (int i{}; i < n_boundary_control_points; ++i) {
+    int id{plane * mesh_strides[axis]};
+    for (int j{}, k{}; j < para_dim_; ++j) {
+      if (j != axis) {
+        id += multi_index[k++] * mesh_strides[j];
+      }
+    }
+
+    const double* control_point = &ControlPoints()[id * stride];
+    const double inv_weight = (is_rational_) ? 1. / control_point[dim_] : 1.;
+    for (int j{}; j < dim_; ++j) {
+      control_points[i * dim_ + j] = control_point[j] * inv_weight;
+    }
+    if (is_rational_) {
+      weights[i] = control_point[dim_];
+    }
+    Increment(para_dim_ - 1, boundary_cmr.data(), multi_index.data());
+  }
+
+  return std::make_shared<DynamicSpline>(
+      para_dim_ - 1,
+      dim_,
+      boundary_degrees.data(),
+      (has_knot_vectors_) ? &boundary_knot_vectors : nullptr,
+      control_points.data(),
+      (is_rational_) ? weights.data() : nullptr);
+}
+
+std::shared_ptr<SplinepyBase> DynamicSpline::SplinepyDeepCopy() const {
+  return std::make_shared<DynamicSpline>(*this);
+}
+
+} // namespace splinepy::splines
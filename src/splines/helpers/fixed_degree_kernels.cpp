@@ -0,0 +1,13 @@
+#include "splinepy/splines/helpers/fixed_degree_kernels.hpp"
+
+namespace splinepy::splines::helpers {
+
+namespace {
+std::atomic<bool> fixed_degree_kernels_enabled{true};
+} // namespace
+
+std::atomic<bool>& FixedDegreeKernelsEnabled() {
+  return fixed_degree_kernels_enabled;
+}
+
+} // namespace splinepy::splines::helpers
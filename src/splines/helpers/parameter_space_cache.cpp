@@ -0,0 +1,13 @@
+#include "splinepy/splines/helpers/parameter_space_cache.hpp"
+
+namespace splinepy::splines::helpers {
+
+namespace {
+std::atomic<bool> parameter_space_interning_enabled{true};
+} // namespace
+
+std::atomic<bool>& ParameterSpaceInterningEnabled() {
+  return parameter_space_interning_enabled;
+}
+
+} // namespace splinepy::splines::helpers
@@ -0,0 +1,251 @@
+#include "splinepy/splines/homogeneous_patches.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include <BSplineLib/ParameterSpaces/knot_vector.hpp>
+#include <BSplineLib/ParameterSpaces/parameter_space.hpp>
+
+#include "splinepy/utils/nthreads.hpp"
+#include "splinepy/utils/print.hpp"
+#include "splinepy/utils/scratch_arena.hpp"
+
+namespace splinepy::splines {
+
+bool HomogeneousPatches::HaveSameBasis(const Patches_& patches,
+                                       const int n_thread) {
+  const int n_patches = static_cast<int>(patches.size());
+  if (n_patches < 1) {
+    return false;
+  }
+
+  const auto& reference = patches[0];
+  if (reference->SplinepyIsNull() || reference->SplinepyIsRational()) {
+    return false;
+  }
+
+  const bool has_knot_vectors = reference->SplinepyHasKnotVectors();
+  std::vector<std::vector<double>> reference_knot_vectors;
+  if (has_knot_vectors) {
+    reference->SplinepyCurrentProperties(nullptr,
+                                         &reference_knot_vectors,
+                                         nullptr,
+                                         nullptr);
+  }
+
+  // each thread sets its own flag
+  std::vector<char> same(n_thread, 1);
+  auto check_step = [&](int, int, const int i_thread) {
+    std::vector<std::vector<double>> knot_vectors;
+    for (int i{i_thread}; i < n_patches; i += n_thread) {
+      const auto& patch = patches[i];
+      if (patch->SplinepyIsNull() || patch->SplinepyIsRational()
+          || patch->SplinepyHasKnotVectors() != has_knot_vectors) {
+        same[i_thread] = 0;
+        return;
+      }
+      if (has_knot_vectors) {
+        knot_vectors.clear();
+        patch->SplinepyCurrentProperties(nullptr,
+                                         &knot_vectors,
+                                         nullptr,
+                                         nullptr);
+        if (knot_vectors != reference_knot_vectors) {
+          same[i_thread] = 0;
+          return;
+        }
+      }
+    }
+  };
+  splinepy::utils::NThreadExecution(check_step, n_patches, n_thread);
+
+  return std::all_of(same.begin(), same.end(), [](const char s) {
+    return s != 0;
+  });
+}
+
+HomogeneousPatches::HomogeneousPatches(const Patches_& patches,
+                                       const int n_thread) {
+  if (patches.size() == 0) {
+    splinepy::utils::PrintAndThrowError(
+        "HomogeneousPatches requires at least one patch.");
+  }
+
+  const auto& reference = patches[0];
+  n_patches_ = static_cast<int>(patches.size());
+  n_control_points_ = reference->SplinepyNumberOfControlPoints();
+  n_supports_ = reference->SplinepyNumberOfSupports();
+  para_dim_ = reference->SplinepyParaDim();
+  dim_ = reference->SplinepyDim();
+
+  name_ = reference->SplinepySplineName();
+  has_knot_vectors_ = reference->SplinepyHasKnotVectors();
+  degrees_.resize(para_dim_);
+  reference->SplinepyCurrentProperties(degrees_.data(),
+                                       (has_knot_vectors_) ? &knot_vectors_
+                                                           : nullptr,
+                                       nullptr,
+                                       nullptr);
+
+  // copy all control points
+  control_points_.resize(n_patches_ * n_control_points_ * dim_);
+  copied_pointers_.resize(n_patches_);
+  copied_versions_.resize(n_patches_);
+  auto copy_step = [&](const int begin, const int end, int) {
+    for (int i{begin}; i < end; ++i) {
+      copied_pointers_[i] = patches[i]->SplinepyExistingControlPointPointers();
+      copied_versions_[i] =
+          (copied_pointers_[i]) ? copied_pointers_[i]->version_ : 0;
+      patches[i]->SplinepyCurrentProperties(
+          nullptr,
+          nullptr,
+          &control_points_[i * n_control_points_ * dim_],
+          nullptr);
+    }
+  };
+  splinepy::utils::NThreadExecution(copy_step, n_patches_, n_thread);
+}
+
+bool HomogeneousPatches::HasRecordedBasis(
+    const ParameterSpace_& parameter_space) const {
+  for (int i{}; i < para_dim_; ++i) {
+    if (static_cast<int>(parameter_space.GetDegree(i)) != degrees_[i]) {
+      return false;
+    }
+    const auto& knots = parameter_space.GetKnotVector(i)->GetKnots();
+    const auto& recorded_knots = knot_vectors_[i];
+    if (knots.size() != recorded_knots.size()
+        || !std::equal(knots.begin(),
+                       knots.end(),
+                       recorded_knots.begin(),
+                       [](const auto& knot, const double recorded_knot) {
+                         return static_cast<double>(knot) == recorded_knot;
+                       })) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool HomogeneousPatches::SharesBasis(const Patches_& patches,
+                                     const int n_thread) const {
+  if (static_cast<int>(patches.size()) != n_patches_) {
+    return false;
+  }
+
+  // each thread sets its own flag
+  std::vector<char> same(n_thread, 1);
+  auto check_step = [&](const int begin, const int end, const int i_thread) {
+    splinepy::utils::ScratchScope scratch;
+    int* degrees = scratch.Allocate<int>(para_dim_);
+    // consecutive patches usually share their parameter space
+    const ParameterSpace_* checked_parameter_space{};
+    for (int i{begin}; i < end; ++i) {
+      const SplinepyBase& patch = *patches[i];
+      if (patch.SplinepyIsNull() || patch.SplinepyIsRational()
+          || patch.SplinepyParaDim() != para_dim_
+          || patch.SplinepyDim() != dim_
+          || patch.SplinepyNumberOfControlPoints() != n_control_points_
+          || patch.SplinepySplineName() != name_) {
+        same[i_thread] = 0;
+        return;
+      }
+
+      if (!has_knot_vectors_) {
+        patch.SplinepyCurrentProperties(degrees, nullptr, nullptr, nullptr);
+        if (!std::equal(degrees, degrees + para_dim_, degrees_.begin())) {
+          same[i_thread] = 0;
+          return;
+        }
+        continue;
+      }
+
+      const auto parameter_space = patch.SplinepyParameterSpace();
+      if (parameter_space.get() == checked_parameter_space) {
+        continue;
+      }
+      if (!HasRecordedBasis(*parameter_space)) {
+        same[i_thread] = 0;
+        return;
+      }
+      checked_parameter_space = parameter_space.get();
+    }
+  };
+  splinepy::utils::NThreadExecution(check_step, n_patches_, n_thread);
+
+  return std::all_of(same.begin(), same.end(), [](const char s) {
+    return s != 0;
+  });
+}
+
+void HomogeneousPatches::UpdateControlPoints(const Patches_& patches,
+                                             const int n_thread) const {
+  auto update_step = [&](const int begin, const int end, int) {
+    for (int i{begin}; i < end; ++i) {
+      auto pointers = patches[i]->SplinepyExistingControlPointPointers();
+      const std::size_t version = (pointers) ? pointers->version_ : 0;
+      if (pointers == copied_pointers_[i] && version == copied_versions_[i]) {
+        continue;
+      }
+      patches[i]->SplinepyCurrentProperties(
+          nullptr,
+          nullptr,
+          &control_points_[i * n_control_points_ * dim_],
+          nullptr);
+      copied_pointers_[i] = std::move(pointers);
+      copied_versions_[i] = version;
+    }
+  };
+  splinepy::utils::NThreadExecution(update_step, n_patches_, n_thread);
+}
+
+void HomogeneousPatches::Evaluate(const Patches_& patches,
+                                  const double* queries,
+                                  const int n_queries,
+                                  const int n_thread,
+                                  double* evaluated) const {
+  std::lock_guard<std::mutex> lock(control_points_mutex_);
+  UpdateControlPoints(patches, n_thread);
+
+  // shared basis - computed once per query
+  const auto& reference = patches[0];
+  DoubleVector_ basis(n_queries * n_supports_);
+  IntVector_ support(n_queries * n_supports_);
+  auto compute_basis = [&](const int begin, const int end, int) {
+    for (int i{begin}; i < end; ++i) {
+      reference->SplinepyBasisAndSupport(&queries[i * para_dim_],
+                                         &basis[i * n_supports_],
+                                         &support[i * n_supports_]);
+    }
+  };
+  splinepy::utils::NThreadExecution(compute_basis, n_queries, n_thread);
+
+  // contract with all patches. Each thread works on a range of patches, so
+  // that control points of one patch stay in cache for all queries
+  auto contract = [&](const int begin, const int end, int) {
+    for (int i_patch{begin}; i_patch < end; ++i_patch) {
+      const double* patch_control_points =
+          &control_points_[i_patch * n_control_points_ * dim_];
+      double* patch_evaluated = &evaluated[i_patch * n_queries * dim_];
+
+      for (int i_query{}; i_query < n_queries; ++i_query) {
+        const double* query_basis = &basis[i_query * n_supports_];
+        const int* query_support = &support[i_query * n_supports_];
+        double* out = &patch_evaluated[i_query * dim_];
+
+        std::fill_n(out, dim_, 0.);
+        for (int j{}; j < n_supports_; ++j) {
+          const double& b = query_basis[j];
+          const double* control_point =
+              &patch_control_points[query_support[j] * dim_];
+          for (int k{}; k < dim_; ++k) {
+            out[k] += b * control_point[k];
+          }
+        }
+      }
+    }
+  };
+  splinepy::utils::NThreadExecution(contract, n_patches_, n_thread);
+}
+
+} // namespace splinepy::splines
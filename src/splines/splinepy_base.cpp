@@ -3,13 +3,49 @@
 
 #include <splinepy/splines/bspline.hpp>
 #include <splinepy/splines/create/create_bezier.hpp>
+#include <splinepy/splines/create/create_more.hpp>
 #include <splinepy/splines/create/create_rational_bezier.hpp>
+#include <splinepy/splines/dynamic_spline.hpp>
 #include <splinepy/splines/nurbs.hpp>
 #include <splinepy/splines/splinepy_base.hpp>
 #include <splinepy/utils/print.hpp>
 
 namespace splinepy::splines {
 
+namespace {
+
+/// Largest dimension with template instantiations. With SPLINEPY_LAZY_MORE,
+/// parametric dimensions above 3 are loaded on first use.
+#if defined(SPLINEPY_MORE) || defined(SPLINEPY_LAZY_MORE)
+constexpr int kMaxTemplateDim = 10;
+#else
+constexpr int kMaxTemplateDim = 3;
+#endif
+
+/// Largest physical dimension of bezier types with parametric dimension up
+/// to 3. With SPLINEPY_LAZY_MORE, those are compiled into core without
+/// SPLINEPY_MORE and therefore only up to 3.
+#ifdef SPLINEPY_LAZY_MORE
+constexpr int kMaxCoreBezierDim = 3;
+#else
+constexpr int kMaxCoreBezierDim = kMaxTemplateDim;
+#endif
+
+/// Checks if there's a template instantiation for given dimensions. Bezier
+/// types are templated on both dimensions, (rational) bsplines only on
+/// para_dim.
+inline bool HasTemplateInstantiation(const int para_dim,
+                                     const int dim,
+                                     const bool has_knot_vectors) {
+  if (para_dim < 1 || para_dim > kMaxTemplateDim) {
+    return false;
+  }
+  const int max_dim = (para_dim <= 3) ? kMaxCoreBezierDim : kMaxTemplateDim;
+  return has_knot_vectors || (dim > 0 && dim <= max_dim);
+}
+
+} // namespace
+
 std::shared_ptr<SplinepyBase> SplinepyBase::SplinepyCreate(
     const int para_dim,
     const int dim,
@@ -22,6 +58,16 @@ std::shared_ptr<SplinepyBase> SplinepyBase::SplinepyCreate(
         "Not Enough information to create any spline.");
   }
 
+  // runtime dimensioned fallback beyond the instantiated templates
+  if (!HasTemplateInstantiation(para_dim, dim, knot_vectors != nullptr)) {
+    return std::make_shared<DynamicSpline>(para_dim,
+                                           dim,
+                                           degrees,
+                                           knot_vectors,
+                                           control_points,
+                                           weights);
+  }
+
   if (!knot_vectors) {
     if (!weights) {
       return SplinepyCreateBezier(para_dim, dim, degrees, control_points);
@@ -55,6 +101,19 @@ SplinepyBase::SplinepyCreateBezier(const int para_dim,
                                    const int dim,
                                    const int* degrees,
                                    const double* control_points) {
+#ifdef SPLINEPY_LAZY_MORE
+  if (para_dim > 3) {
+    if (const auto* more = splinepy::splines::create::LoadMoreFactories()) {
+      return more->bezier(para_dim, dim, degrees, control_points);
+    }
+    return std::make_shared<DynamicSpline>(para_dim,
+                                           dim,
+                                           degrees,
+                                           nullptr,
+                                           control_points,
+                                           nullptr);
+  }
+#endif
   switch (para_dim) {
   case 1:
     return splinepy::splines::create::CreateBezier1(dim,
@@ -114,12 +173,44 @@ SplinepyBase::SplinepyCreateBezier(const int para_dim,
   return std::shared_ptr<SplinepyBase>{};
 }
 
+std::shared_ptr<SplinepyBase>
+SplinepyBase::SplinepyCreateBezierView(const int para_dim,
+                                       const int dim,
+                                       const int* degrees,
+                                       double* control_points) {
+  if (!degrees || !control_points) {
+    splinepy::utils::PrintAndThrowError(
+        "Not Enough information to create any spline.");
+  }
+  return std::make_shared<DynamicSpline>(para_dim,
+                                         dim,
+                                         degrees,
+                                         control_points);
+}
+
 std::shared_ptr<SplinepyBase>
 SplinepyBase::SplinepyCreateRationalBezier(const int para_dim,
                                            const int dim,
                                            const int* degrees,
                                            const double* control_points,
                                            const double* weights) {
+#ifdef SPLINEPY_LAZY_MORE
+  if (para_dim > 3) {
+    if (const auto* more = splinepy::splines::create::LoadMoreFactories()) {
+      return more->rational_bezier(para_dim,
+                                   dim,
+                                   degrees,
+                                   control_points,
+                                   weights);
+    }
+    return std::make_shared<DynamicSpline>(para_dim,
+                                           dim,
+                                           degrees,
+                                           nullptr,
+                                           control_points,
+                                           weights);
+  }
+#endif
   switch (para_dim) {
   case 1:
     return splinepy::splines::create::CreateRationalBezier1(dim,
@@ -198,6 +289,24 @@ std::shared_ptr<SplinepyBase> SplinepyBase::SplinepyCreateBSpline(
     const std::vector<std::vector<double>>* knot_vectors,
     double* control_points) {
 
+#ifdef SPLINEPY_LAZY_MORE
+  if (para_dim > 3) {
+    if (const auto* more = splinepy::splines::create::LoadMoreFactories()) {
+      return more->bspline(para_dim,
+                           dim,
+                           degrees,
+                           knot_vectors,
+                           control_points);
+    }
+    return std::make_shared<DynamicSpline>(para_dim,
+                                           dim,
+                                           degrees,
+                                           knot_vectors,
+                                           control_points,
+                                           nullptr);
+  }
+#endif
+
   switch (para_dim) {
   case 1:
     return std::make_shared<BSpline<1>>(degrees,
@@ -271,6 +380,24 @@ std::shared_ptr<SplinepyBase> SplinepyBase::SplinepyCreateNurbs(
     const std::vector<std::vector<double>>* knot_vectors,
     double* control_points,
     double* weights) {
+#ifdef SPLINEPY_LAZY_MORE
+  if (para_dim > 3) {
+    if (const auto* more = splinepy::splines::create::LoadMoreFactories()) {
+      return more->nurbs(para_dim,
+                         dim,
+                         degrees,
+                         knot_vectors,
+                         control_points,
+                         weights);
+    }
+    return std::make_shared<DynamicSpline>(para_dim,
+                                           dim,
+                                           degrees,
+                                           knot_vectors,
+                                           control_points,
+                                           weights);
+  }
+#endif
   switch (para_dim) {
   case 1:
     return std::make_shared<Nurbs<1>>(degrees,
@@ -415,6 +542,14 @@ SplinepyBase::SplinepyParameterSpace() {
   return nullptr;
 }
 
+std::shared_ptr<const bsplinelib::parameter_spaces::ParameterSpaceBase>
+SplinepyBase::SplinepyParameterSpace() const {
+  splinepy::utils::PrintAndThrowError(
+      "SplinepyParameterSpace not implemented for",
+      SplinepyWhatAmI());
+  return nullptr;
+}
+
 std::shared_ptr<bsplinelib::parameter_spaces::KnotVector>
 SplinepyBase::SplinepyKnotVector(const int p_dim) {
   splinepy::utils::PrintAndThrowError("SplinepyKnotVector not implemented for",
@@ -422,6 +557,13 @@ SplinepyBase::SplinepyKnotVector(const int p_dim) {
   return nullptr;
 }
 
+std::shared_ptr<const bsplinelib::parameter_spaces::KnotVector>
+SplinepyBase::SplinepyKnotVector(const int p_dim) const {
+  splinepy::utils::PrintAndThrowError("SplinepyKnotVector not implemented for",
+                                      SplinepyWhatAmI());
+  return nullptr;
+}
+
 std::shared_ptr<typename SplinepyBase::ControlPointPointers_>
 SplinepyBase::SplinepyControlPointPointers() {
   splinepy::utils::PrintAndThrowError(
@@ -446,6 +588,32 @@ SplinepyBase::SplinepyWeightPointers() {
   return nullptr;
 }
 
+void SplinepyBase::SplinepyTakeOverControlPointPointers(SplinepyBase& other) {
+  if (!other.control_point_pointers_) {
+    return;
+  }
+  if (SplinepyIsRational() || other.SplinepyIsRational()) {
+    splinepy::utils::PrintAndThrowError(
+        "SplinepyTakeOverControlPointPointers supports only non-rational",
+        "splines.");
+  }
+  if (other.control_point_pointers_->Len()
+      != SplinepyNumberOfControlPoints()) {
+    splinepy::utils::PrintAndThrowError(
+        "SplinepyTakeOverControlPointPointers - number of control points",
+        "mismatch. Expected -",
+        SplinepyNumberOfControlPoints(),
+        "given -",
+        other.control_point_pointers_->Len());
+  }
+
+  auto pointers = std::move(other.control_point_pointers_);
+  pointers->coordinate_begins_ =
+      SplinepyControlPointPointers()->coordinate_begins_;
+  ++pointers->version_;
+  control_point_pointers_ = std::move(pointers);
+}
+
 void SplinepyBase::SplinepyParametricBounds(double* para_bounds) const {
   splinepy::utils::PrintAndThrowError(
       "SplinepyParametricBounds not implemented for",
@@ -546,6 +714,12 @@ void SplinepyBase::SplinepyVerboseProximity(const double* query,
       SplinepyWhatAmI());
 }
 
+splinepy::proximity::Proximity* SplinepyBase::SplinepyProximity() {
+  splinepy::utils::PrintAndThrowError("SplinepyProximity not implemented for",
+                                      SplinepyWhatAmI());
+  return nullptr;
+}
+
 void SplinepyBase::SplinepyElevateDegree(const int& para_dims) {
   splinepy::utils::PrintAndThrowError(
       "SplinepyElevateDegree not implemented for",
@@ -15,6 +15,7 @@ void ControlPointPointers::SetRow(const int id, const double* values) {
   if (invalid_) {
     return;
   }
+  ++version_;
 
   if (for_rational_) {
     const double& weight = *(weight_pointers_->weights_[id]);
@@ -34,6 +35,7 @@ void ControlPointPointers::Sync(const double* values) {
   if (invalid_) {
     return;
   }
+  ++version_;
 
   const int dim = Dim();
 
@@ -77,6 +79,8 @@ void WeightPointers::SetRow(const int id, double const& value) {
   }
 
   if (auto cpp = control_point_pointers_.lock()) {
+    ++cpp->version_;
+
     // adjustment factor - new value divided by previous factor;
     double& current_weight = *weights_[id];
     const double adjust_factor = value / current_weight;
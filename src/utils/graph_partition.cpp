@@ -0,0 +1,367 @@
+#include "splinepy/utils/graph_partition.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "splinepy/utils/print.hpp"
+
+namespace splinepy::utils {
+
+namespace {
+
+using IntVector_ = CsrGraph::IntVector_;
+
+inline double VertexWeight(const double* vertex_weights, const int v) {
+  return (vertex_weights) ? vertex_weights[v] : 1.;
+}
+
+inline int EdgeWeight(const CsrGraph& graph, const int i) {
+  return (graph.edge_weights.size() != 0) ? graph.edge_weights[i] : 1;
+}
+
+/// @brief Last vertex of breadth first searches within given label. A few
+/// repetitions give a vertex that is far away from the others.
+int PseudoPeripheralVertex(const CsrGraph& graph,
+                           const int* labels,
+                           const int label,
+                           int start,
+                           std::vector<char>& visited,
+                           IntVector_& queue) {
+  for (int i_search{}; i_search < 2; ++i_search) {
+    queue.clear();
+    queue.push_back(start);
+    visited[start] = 1;
+    for (std::size_t head{}; head < queue.size(); ++head) {
+      const int v = queue[head];
+      for (int i{graph.offsets[v]}; i < graph.offsets[v + 1]; ++i) {
+        const int u = graph.neighbors[i];
+        if (labels[u] == label && !visited[u]) {
+          visited[u] = 1;
+          queue.push_back(u);
+        }
+      }
+    }
+    for (const int& v : queue) {
+      visited[v] = 0;
+    }
+    start = queue.back();
+  }
+  return start;
+}
+
+/// @brief Splits vertices with given label into two sides. Vertices of the
+/// second side get second_label.
+void Bisect(const CsrGraph& graph,
+            const double* vertex_weights,
+            const IntVector_& vertices,
+            const double target_weight,
+            const int label,
+            const int second_label,
+            int* labels) {
+  const int n_vertices = static_cast<int>(vertices.size());
+
+  // everything starts on the second side, first side is grown
+  for (const int& v : vertices) {
+    labels[v] = second_label;
+  }
+
+  std::vector<char> visited(graph.n_vertices, 0);
+  IntVector_ queue;
+  IntVector_ connectivity(graph.n_vertices, 0);
+
+  // (connectivity to region, negative insertion count, vertex) - stale
+  // entries are skipped
+  using Candidate_ = std::tuple<int, int, int>;
+  std::priority_queue<Candidate_> candidates;
+  int n_pushed{};
+
+  double region_weight{};
+  int n_region{};
+  int next_seed{};
+
+  auto add_to_region = [&](const int v) {
+    labels[v] = label;
+    region_weight += VertexWeight(vertex_weights, v);
+    ++n_region;
+    for (int i{graph.offsets[v]}; i < graph.offsets[v + 1]; ++i) {
+      const int u = graph.neighbors[i];
+      if (labels[u] == second_label) {
+        connectivity[u] += EdgeWeight(graph, i);
+        candidates.emplace(connectivity[u], -(n_pushed++), u);
+      }
+    }
+  };
+
+  add_to_region(PseudoPeripheralVertex(graph,
+                                       labels,
+                                       second_label,
+                                       vertices[0],
+                                       visited,
+                                       queue));
+
+  // vertices that would overshoot the target weight
+  std::vector<char> rejected(graph.n_vertices, 0);
+  auto is_available = [&](const int v) {
+    return labels[v] == second_label && !rejected[v];
+  };
+
+  while (n_region < n_vertices - 1) {
+    // next vertex - most connected candidate or a new seed for disconnected
+    // graphs
+    int v{-1};
+    while (!candidates.empty()) {
+      const int connected = std::get<0>(candidates.top());
+      const int candidate = std::get<2>(candidates.top());
+      candidates.pop();
+      if (is_available(candidate) && connected == connectivity[candidate]) {
+        v = candidate;
+        break;
+      }
+    }
+    if (v < 0) {
+      while (next_seed < n_vertices && !is_available(vertices[next_seed])) {
+        ++next_seed;
+      }
+      if (next_seed == n_vertices) {
+        break;
+      }
+      v = vertices[next_seed];
+    }
+
+    // skip v if it overshoots more than current undershoot
+    const double weight = VertexWeight(vertex_weights, v);
+    if (region_weight + weight - target_weight
+        > target_weight - region_weight) {
+      rejected[v] = 1;
+      continue;
+    }
+    add_to_region(v);
+  }
+
+  // greedy refinement - moves boundary vertices that reduce the cut without
+  // worsening balance beyond what growing reached or 3 percent of the weight
+  double total_weight{};
+  for (const int& v : vertices) {
+    total_weight += VertexWeight(vertex_weights, v);
+  }
+  const double allowed_imbalance =
+      std::max(std::abs(region_weight - target_weight), 0.03 * total_weight);
+  int n_second = n_vertices - n_region;
+
+  constexpr int kMaxPasses{4};
+  for (int i_pass{}; i_pass < kMaxPasses; ++i_pass) {
+    bool moved{false};
+    for (const int& v : vertices) {
+      const int own = labels[v];
+      const int other = (own == label) ? second_label : label;
+
+      int gain{};
+      for (int i{graph.offsets[v]}; i < graph.offsets[v + 1]; ++i) {
+        const int& u_label = labels[graph.neighbors[i]];
+        if (u_label == other) {
+          gain += EdgeWeight(graph, i);
+        } else if (u_label == own) {
+          gain -= EdgeWeight(graph, i);
+        }
+      }
+      if (gain <= 0) {
+        continue;
+      }
+
+      // keep both sides non-empty and balanced
+      if ((own == label && n_region < 2) || (own != label && n_second < 2)) {
+        continue;
+      }
+      const double weight = VertexWeight(vertex_weights, v);
+      const double new_region_weight =
+          (own == label) ? region_weight - weight : region_weight + weight;
+      if (std::abs(new_region_weight - target_weight) > allowed_imbalance) {
+        continue;
+      }
+
+      labels[v] = other;
+      region_weight = new_region_weight;
+      if (own == label) {
+        --n_region;
+        ++n_second;
+      } else {
+        ++n_region;
+        --n_second;
+      }
+      moved = true;
+    }
+    if (!moved) {
+      break;
+    }
+  }
+}
+
+/// @brief Bisects vertices labeled with first_part until there's one part
+/// per label in [first_part, first_part + n_parts).
+void Partition(const CsrGraph& graph,
+               const double* vertex_weights,
+               const IntVector_& vertices,
+               const int n_parts,
+               const int first_part,
+               int* parts) {
+  if (n_parts < 2 || vertices.size() < 2) {
+    return;
+  }
+
+  const int n_first_parts = n_parts / 2;
+  double total_weight{};
+  for (const int& v : vertices) {
+    total_weight += VertexWeight(vertex_weights, v);
+  }
+
+  const int second_part = first_part + n_first_parts;
+  Bisect(graph,
+         vertex_weights,
+         vertices,
+         total_weight * n_first_parts / n_parts,
+         first_part,
+         second_part,
+         parts);
+
+  IntVector_ first_vertices, second_vertices;
+  for (const int& v : vertices) {
+    if (parts[v] == first_part) {
+      first_vertices.push_back(v);
+    } else {
+      second_vertices.push_back(v);
+    }
+  }
+
+  Partition(graph,
+            vertex_weights,
+            first_vertices,
+            n_first_parts,
+            first_part,
+            parts);
+  Partition(graph,
+            vertex_weights,
+            second_vertices,
+            n_parts - n_first_parts,
+            second_part,
+            parts);
+}
+
+} // namespace
+
+void GraphFromEdges(const int n_vertices,
+                    const int* edges,
+                    const int n_edges,
+                    CsrGraph& graph) {
+  // both directions
+  std::vector<std::pair<int, int>> directed;
+  directed.reserve(2 * n_edges);
+  for (int i{}; i < n_edges; ++i) {
+    const int& a = edges[2 * i];
+    const int& b = edges[2 * i + 1];
+    if (a < 0 || b < 0 || a >= n_vertices || b >= n_vertices) {
+      PrintAndThrowError("Edge (", i, ") refers to invalid vertex.");
+    }
+    if (a == b) {
+      continue;
+    }
+    directed.emplace_back(a, b);
+    directed.emplace_back(b, a);
+  }
+  std::sort(directed.begin(), directed.end());
+
+  graph.n_vertices = n_vertices;
+  graph.offsets.assign(n_vertices + 1, 0);
+  graph.neighbors.clear();
+  graph.edge_weights.clear();
+  for (std::size_t i{}; i < directed.size(); ++i) {
+    if (i != 0 && directed[i] == directed[i - 1]) {
+      ++graph.edge_weights.back();
+      continue;
+    }
+    graph.neighbors.push_back(directed[i].second);
+    graph.edge_weights.push_back(1);
+    ++graph.offsets[directed[i].first + 1];
+  }
+  for (int i{}; i < n_vertices; ++i) {
+    graph.offsets[i + 1] += graph.offsets[i];
+  }
+}
+
+int RecursiveBisection(const CsrGraph& graph,
+                       const double* vertex_weights,
+                       const int n_parts,
+                       int* parts) {
+  if (n_parts < 1) {
+    PrintAndThrowError("Number of parts should be positive. Given -",
+                       n_parts);
+  }
+
+  IntVector_ vertices(graph.n_vertices);
+  for (int i{}; i < graph.n_vertices; ++i) {
+    vertices[i] = i;
+    parts[i] = 0;
+  }
+
+  Partition(graph, vertex_weights, vertices, n_parts, 0, parts);
+
+  // edge cut - each edge is visited twice
+  int cut{};
+  for (int v{}; v < graph.n_vertices; ++v) {
+    for (int i{graph.offsets[v]}; i < graph.offsets[v + 1]; ++i) {
+      if (parts[v] != parts[graph.neighbors[i]]) {
+        cut += EdgeWeight(graph, i);
+      }
+    }
+  }
+  return cut / 2;
+}
+
+void PartitionOrder(const CsrGraph& graph,
+                    const int* parts,
+                    const int n_parts,
+                    int* order) {
+  const int n_vertices = graph.n_vertices;
+
+  // vertices grouped by part
+  IntVector_ part_offsets(n_parts + 1, 0);
+  for (int v{}; v < n_vertices; ++v) {
+    ++part_offsets[parts[v] + 1];
+  }
+  for (int i{}; i < n_parts; ++i) {
+    part_offsets[i + 1] += part_offsets[i];
+  }
+  IntVector_ grouped(n_vertices);
+  IntVector_ fill(part_offsets.begin(), part_offsets.end() - 1);
+  for (int v{}; v < n_vertices; ++v) {
+    grouped[fill[parts[v]]++] = v;
+  }
+
+  // breadth first within parts
+  std::vector<char> visited(n_vertices, 0);
+  int n_ordered{};
+  for (const int& seed : grouped) {
+    if (visited[seed]) {
+      continue;
+    }
+    const int part = parts[seed];
+    int head = n_ordered;
+    visited[seed] = 1;
+    order[n_ordered++] = seed;
+    while (head < n_ordered) {
+      const int v = order[head++];
+      for (int i{graph.offsets[v]}; i < graph.offsets[v + 1]; ++i) {
+        const int u = graph.neighbors[i];
+        if (parts[u] == part && !visited[u]) {
+          visited[u] = 1;
+          order[n_ordered++] = u;
+        }
+      }
+    }
+  }
+}
+
+} // namespace splinepy::utils
@@ -0,0 +1,39 @@
+#include "splinepy/utils/scratch_arena.hpp"
+
+#include <mutex>
+
+namespace splinepy::utils {
+
+namespace {
+std::mutex pool_mutex;
+ScratchArenaPool::Arenas_ pool;
+} // namespace
+
+ScratchArenaPool::Arenas_ ScratchArenaPool::Take(const std::size_t n) {
+  Arenas_ arenas;
+  arenas.reserve(n);
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    while (!pool.empty() && arenas.size() < n) {
+      arenas.push_back(std::move(pool.back()));
+      pool.pop_back();
+    }
+  }
+  while (arenas.size() < n) {
+    arenas.push_back(std::make_unique<ScratchArena>());
+  }
+  return arenas;
+}
+
+void ScratchArenaPool::Give(Arenas_&& arenas) {
+  for (auto& arena : arenas) {
+    arena->Reset();
+  }
+  std::lock_guard<std::mutex> lock(pool_mutex);
+  for (auto& arena : arenas) {
+    pool.push_back(std::move(arena));
+  }
+  arenas.clear();
+}
+
+} // namespace splinepy::utils
@@ -0,0 +1,98 @@
+#include "splinepy/utils/spatial_hash.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "splinepy/utils/print.hpp"
+
+namespace splinepy::utils {
+
+SpatialHash::SpatialHash(const int dim, const double cell_size)
+    : dim_(dim),
+      cell_size_(cell_size) {
+  if (dim_ < 1) {
+    PrintAndThrowError("SpatialHash requires positive dimension.");
+  }
+  if (!(cell_size_ > 0.)) {
+    PrintAndThrowError("SpatialHash requires positive cell size. Given -",
+                       cell_size_);
+  }
+}
+
+void SpatialHash::CellIndex(const double* point, long long* cell_index) const {
+  for (int i{}; i < dim_; ++i) {
+    cell_index[i] = static_cast<long long>(std::floor(point[i] / cell_size_));
+  }
+}
+
+SpatialHash::Key_ SpatialHash::CellKey(const long long* cell_index) const {
+  // boost-style hash combine with 64 bit golden ratio
+  Key_ key{};
+  for (int i{}; i < dim_; ++i) {
+    key ^= static_cast<Key_>(cell_index[i]) + 0x9e3779b97f4a7c15ULL
+           + (key << 6) + (key >> 2);
+  }
+  return key;
+}
+
+void SpatialHash::Insert(const double* points, const int n_points) {
+  const int offset = Size();
+  points_.insert(points_.end(), points, points + n_points * dim_);
+
+  DefaultInitializationVector<long long> cell_index(dim_);
+  for (int i{}; i < n_points; ++i) {
+    CellIndex(&points[i * dim_], cell_index.data());
+    cells_[CellKey(cell_index.data())].push_back(offset + i);
+  }
+}
+
+void SpatialHash::RadiusSearch(const double* query,
+                               const double radius,
+                               IntVector_& ids) const {
+  ids.clear();
+  const double radius_squared = radius * radius;
+
+  DefaultInitializationVector<long long> center(dim_), neighbor(dim_);
+  DefaultInitializationVector<int> offset(dim_, -1);
+  CellIndex(query, center.data());
+
+  // visit all 3^dim adjacent cells
+  bool done{false};
+  while (!done) {
+    for (int i{}; i < dim_; ++i) {
+      neighbor[i] = center[i] + offset[i];
+    }
+
+    const auto cell = cells_.find(CellKey(neighbor.data()));
+    if (cell != cells_.end()) {
+      for (const int& id : cell->second) {
+        const double* point = Point(id);
+        double distance_squared{};
+        for (int i{}; i < dim_; ++i) {
+          const double diff = point[i] - query[i];
+          distance_squared += diff * diff;
+        }
+        if (distance_squared < radius_squared) {
+          ids.push_back(id);
+        }
+      }
+    }
+
+    // increment offset
+    done = true;
+    for (int i{}; i < dim_; ++i) {
+      if (offset[i] < 1) {
+        ++offset[i];
+        done = false;
+        break;
+      }
+      offset[i] = -1;
+    }
+  }
+
+  // key collisions may visit the same bucket more than once
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+}
+
+} // namespace splinepy::utils
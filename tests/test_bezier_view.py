@@ -0,0 +1,127 @@
+try:
+    from . import common as c
+except BaseException:
+    import common as c
+
+
+class BezierViewTest(c.SplineBasedTestCase):
+    """With settings.VIEW_BEZIER_CONTROL_POINTS, non-rational beziers view
+    their saved control points until first use beyond queries."""
+
+    def setUp(self):
+        self.view_setting = c.splinepy.settings.VIEW_BEZIER_CONTROL_POINTS
+        c.splinepy.settings.VIEW_BEZIER_CONTROL_POINTS = True
+
+    def tearDown(self):
+        c.splinepy.settings.VIEW_BEZIER_CONTROL_POINTS = self.view_setting
+
+    def reference(self, view):
+        """Same spline without view"""
+        c.splinepy.settings.VIEW_BEZIER_CONTROL_POINTS = False
+        reference = c.splinepy.Bezier(
+            degrees=view.degrees, control_points=view.control_points
+        )
+        c.splinepy.settings.VIEW_BEZIER_CONTROL_POINTS = True
+        assert not reference._views_control_points
+        return reference
+
+    def test_queries(self):
+        queries = c.np.random.rand(10, 2)
+        view = self.bezier_2p2d()
+        assert view._views_control_points
+        reference = self.reference(view)
+
+        for query in ("evaluate", "jacobian", "basis", "support"):
+            assert c.np.allclose(
+                getattr(view, query)(queries),
+                getattr(reference, query)(queries),
+            )
+        assert c.np.allclose(
+            view.derivative(queries, [1, 1]),
+            reference.derivative(queries, [1, 1]),
+        )
+
+        # rational beziers save weighted control points and don't view
+        assert not self.rational_bezier_2p2d()._views_control_points
+
+    def test_writes(self):
+        queries = c.np.random.rand(10, 2)
+        view = self.bezier_2p2d()
+        reference = self.reference(view)
+
+        view.control_points[1] += 0.5
+        reference.control_points[1] += 0.5
+
+        assert view._views_control_points
+        assert c.np.allclose(
+            view.evaluate(queries), reference.evaluate(queries)
+        )
+
+    def test_materialize(self):
+        queries = c.np.random.rand(10, 2)
+
+        # resizing operation
+        view = self.bezier_2p2d()
+        reference = self.reference(view)
+        view.elevate_degrees([0])
+        reference.elevate_degrees([0])
+        assert not view._views_control_points
+        assert c.np.allclose(
+            view.evaluate(queries), reference.evaluate(queries)
+        )
+        view.control_points[2] -= 0.5
+        reference.control_points[2] -= 0.5
+        assert c.np.allclose(
+            view.evaluate(queries), reference.evaluate(queries)
+        )
+
+        # other operations keep control points, so arrays handed out before
+        # keep writing to the spline
+        view = self.bezier_2p2d()
+        reference = self.reference(view)
+        control_points = view.control_points
+        product = view * view
+        assert not view._views_control_points
+        squared = (reference * reference).evaluate(queries)
+        assert c.np.allclose(product.evaluate(queries), squared)
+        control_points[1] += 0.5
+        reference.control_points[1] += 0.5
+        assert c.np.allclose(
+            view.evaluate(queries), reference.evaluate(queries)
+        )
+
+    def test_copy(self):
+        queries = c.np.random.rand(10, 2)
+        view = self.bezier_2p2d()
+        evaluated = view.evaluate(queries)
+
+        copied = view.copy()
+        assert not copied._views_control_points
+        assert view._views_control_points
+
+        view.control_points[1] += 0.5
+        assert c.np.allclose(copied.evaluate(queries), evaluated)
+
+        copied.elevate_degrees([1])
+        assert view._views_control_points
+
+    def test_runtime_dimensioned(self):
+        """Views are runtime dimensioned, so beyond template instantiations,
+        they materialize into runtime dimensioned splines, too."""
+        rng = c.np.random.default_rng(0)
+        queries = rng.random((10, 1))
+        view = c.splinepy.Bezier(
+            degrees=[2], control_points=rng.random((3, 11))
+        )
+        reference = self.reference(view)
+        assert view._views_control_points
+
+        view.control_points[1] += 0.5
+        reference.control_points[1] += 0.5
+        assert c.np.allclose(
+            view.evaluate(queries), reference.evaluate(queries)
+        )
+
+
+if __name__ == "__main__":
+    c.unittest.main()
@@ -0,0 +1,131 @@
+try:
+    from . import common as c
+except BaseException:
+    import common as c
+
+
+def move_control_point(spline):
+    spline.control_points[1] += 0.5
+
+
+def insert_knot(spline):
+    spline.insert_knots(0, [0.3])
+
+
+def elevate_degree(spline):
+    spline.elevate_degrees([1])
+
+
+def set_knot(spline):
+    spline.knot_vectors[0][-1] = 2.0
+
+
+def copy_pairs(create):
+    """Yields an original with its copy and a copy with its copy. Originals
+    view python's control point arrays and only share knot vectors. Copies
+    share control points, too."""
+    original = create()
+    yield original, original.copy()
+    copied = create().copy()
+    yield copied, copied.copy()
+
+
+def properties(spline):
+    """Copies of current properties. Only reads, so nothing is detached."""
+    return spline.current_core_properties()
+
+
+def same_properties(a, b):
+    for key, value in a.items():
+        if key == "knot_vectors":
+            if len(value) != len(b[key]) or not all(
+                len(kv) == len(other_kv) and c.np.allclose(kv, other_kv)
+                for kv, other_kv in zip(value, b[key])
+            ):
+                return False
+        elif c.np.shape(value) != c.np.shape(b[key]) or not c.np.allclose(
+            value, b[key]
+        ):
+            return False
+    return True
+
+
+class CopyTest(c.SplineBasedTestCase):
+    """Copies share knot vectors and control points with their original until
+    one of them writes. Writes must never show up in the other spline."""
+
+    def test_writes_do_not_propagate(self):
+        queries = c.np.random.rand(10, 2)
+        for create in (self.bspline_2p2d, self.nurbs_2p2d):
+            for write in (
+                move_control_point,
+                insert_knot,
+                elevate_degree,
+                set_knot,
+            ):
+                for write_second in (False, True):
+                    for a, b in copy_pairs(create):
+                        target, other = (b, a) if write_second else (a, b)
+                        reference = properties(other)
+                        evaluated = other.evaluate(queries)
+
+                        write(target)
+
+                        assert same_properties(properties(other), reference)
+                        assert c.np.allclose(
+                            other.evaluate(queries), evaluated
+                        )
+                        assert not same_properties(
+                            properties(target), reference
+                        )
+
+    def test_extract_bezier_patches(self):
+        queries = c.np.random.rand(10, 2)
+        for create in (self.bspline_2p2d, self.nurbs_2p2d):
+            for a, b in copy_pairs(create):
+                reference = properties(a)
+                evaluated = a.evaluate(queries)
+
+                # extraction inserts knots into a working copy
+                b.extract_bezier_patches()
+
+                for spline in (a, b):
+                    assert same_properties(properties(spline), reference)
+                    assert c.np.allclose(spline.evaluate(queries), evaluated)
+
+                # both still detach on write
+                move_control_point(b)
+                assert same_properties(properties(a), reference)
+
+    def test_runtime_dimensioned_copies(self):
+        """Splines beyond template instantiations, here with dim 11, are
+        DynamicSplines, which share their control point buffer."""
+        rng = c.np.random.default_rng(0)
+        queries = rng.random((10, 1))
+        for create in (
+            lambda: c.splinepy.Bezier(
+                degrees=[2], control_points=rng.random((3, 11))
+            ),
+            lambda: c.splinepy.RationalBezier(
+                degrees=[2],
+                control_points=rng.random((3, 11)),
+                weights=[[1.0], [0.5], [1.0]],
+            ),
+        ):
+            for write_second in (False, True):
+                for a, b in copy_pairs(create):
+                    target, other = (b, a) if write_second else (a, b)
+                    reference = properties(other)
+                    evaluated = other.evaluate(queries)
+
+                    move_control_point(target)
+                    if target.is_rational:
+                        target.weights[1] = 0.7
+
+                    assert same_properties(properties(other), reference)
+                    assert c.np.allclose(other.evaluate(queries), evaluated)
+                    assert not same_properties(properties(target), reference)
+
+
+if __name__ == "__main__":
+    c.unittest.main()
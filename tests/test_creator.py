@@ -361,6 +361,87 @@ class CreatorTest(c.SplineBasedTestCase):
                 )
             )
 
+    def test_create_many(self):
+        """
+        Test bulk creation from stacked arrays
+        """
+        references = [self.nurbs_2p2d(), self.nurbs_2p2d()]
+        references[1].control_points = references[1].control_points + 5.0
+
+        splines = c.splinepy.helpme.create.many(
+            degrees=[r.degrees for r in references],
+            control_points=c.np.vstack([r.cps for r in references]),
+            knot_vectors=[
+                [c.np.asarray(r.knot_vectors[i]) for i in range(r.para_dim)]
+                for r in references
+            ],
+            weights=c.np.vstack([r.weights for r in references]),
+            nthreads=2,
+        )
+        self.assertEqual(len(splines), 2)
+        queries = c.np.random.random((10, 2))
+        for spline, reference in zip(splines, references):
+            self.assertTrue(isinstance(spline, c.splinepy.NURBS))
+            self.assertTrue(
+                c.np.allclose(
+                    spline.evaluate(queries), reference.evaluate(queries)
+                )
+            )
+
+        # bspline cores keep a view on their control points. Those need to
+        # outlive temporary inputs and must not alias them
+        bspline = self.bspline_2p2d()
+        stacked = c.np.vstack([bspline.cps, bspline.cps + 1.0])
+        knot_vectors = [c.np.asarray(kv) for kv in bspline.knot_vectors]
+        bsplines = c.splinepy.helpme.create.many(
+            degrees=[bspline.degrees] * 2,
+            control_points=stacked,
+            knot_vectors=[knot_vectors] * 2,
+            nthreads=2,
+        )
+        stacked[:] = 0.0
+        for i, spline in enumerate(bsplines):
+            self.assertTrue(isinstance(spline, c.splinepy.BSpline))
+            self.assertTrue(
+                c.np.allclose(
+                    spline.evaluate(queries),
+                    bspline.evaluate(queries) + float(i),
+                )
+            )
+        bsplines[0].cps[0] += 1.0
+        self.assertTrue(
+            c.np.allclose(
+                bsplines[1].evaluate(queries), bspline.evaluate(queries) + 1.0
+            )
+        )
+
+        # decreasing knot vector offsets
+        with self.assertRaises(RuntimeError):
+            c.splinepy.helpme.create.many(
+                degrees=[bspline.degrees] * 2,
+                control_points=stacked,
+                knot_vectors=c.np.concatenate(knot_vectors * 2),
+                knot_vector_offsets=[0, 13, 7, 20, 26],
+            )
+
+        # bezier types as multipatch
+        bezier = self.bezier_2p2d()
+        multipatch = c.splinepy.helpme.create.many(
+            degrees=[bezier.degrees] * 3,
+            control_points=c.np.vstack([bezier.cps] * 3),
+            as_multipatch=True,
+        )
+        self.assertTrue(isinstance(multipatch, c.splinepy.Multipatch))
+        self.assertEqual(len(multipatch.patches), 3)
+        self.assertTrue(isinstance(multipatch.patches[0], c.splinepy.Bezier))
+
+        # invalid number of control points
+        with self.assertRaises(RuntimeError):
+            c.splinepy.helpme.create.many(
+                degrees=[bezier.degrees] * 3,
+                control_points=c.np.vstack([bezier.cps] * 2),
+            )
+
 
 if __name__ == "__main__":
     c.unittest.main()
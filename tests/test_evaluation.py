@@ -653,6 +653,103 @@ class TestSplinepyEvaluation(c.SplineBasedTestCase):
             ).all()
             assert c.np.allclose(multi_jac, single_jac)
 
+    def test_fixed_degree_kernels(self):
+        """Compile-time degree kernels should match the generic path"""
+        core = c.splinepy.splinepy_core
+        combinations = [
+            (para_dim, degree, dim)
+            for para_dim in (1, 2, 3)
+            for degree in (1, 2, 3)
+            for dim in (1, 3)
+        ]
+        for para_dim, degree, dim in combinations:
+            n_cps = (degree + 1) ** para_dim
+            bezier = c.splinepy.Bezier(
+                degrees=[degree] * para_dim,
+                control_points=c.np.random.rand(n_cps, dim),
+            )
+            queries = c.np.random.rand(7, para_dim)
+            orders = c.np.random.randint(0, 3, para_dim)
+
+            results = []
+            for use in (False, True):
+                previous = core.use_fixed_degree_kernels(use)
+                try:
+                    results.append(
+                        (
+                            bezier.evaluate(queries),
+                            bezier.derivative(queries, orders),
+                            bezier.basis(queries),
+                            bezier.basis_derivative(queries, orders),
+                        )
+                    )
+                finally:
+                    core.use_fixed_degree_kernels(previous)
+
+            for generic, fixed in zip(*results):
+                assert c.np.allclose(generic, fixed)
+
+    def test_fixed_degree_kernels_rational_and_knots(self):
+        """Compile-time degree kernels of splines with knot vectors and
+        weights should match the generic path, including queries on knots"""
+        core = c.splinepy.splinepy_core
+        combinations = [
+            (para_dim, degree)
+            for para_dim in (1, 2, 3)
+            for degree in (0, 1, 2, 3)
+        ]
+        for para_dim, degree in combinations:
+            # repeated interior knot
+            knots = [0.0] * (degree + 1) + [0.3, 0.5, 0.5]
+            knots += [1.0] * (degree + 1)
+            n_cps_1d = len(knots) - degree - 1
+            n_cps = n_cps_1d**para_dim
+            control_points = c.np.random.rand(n_cps, 2)
+            weights = c.np.random.rand(n_cps, 1) + 0.5
+            bspline = c.splinepy.BSpline(
+                degrees=[degree] * para_dim,
+                knot_vectors=[knots] * para_dim,
+                control_points=control_points,
+            )
+            nurbs = c.splinepy.NURBS(**bspline.todict(), weights=weights)
+            rational_bezier = c.splinepy.RationalBezier(
+                degrees=[degree] * para_dim,
+                control_points=c.np.random.rand((degree + 1) ** para_dim, 2),
+                weights=c.np.random.rand((degree + 1) ** para_dim, 1) + 0.5,
+            )
+            queries = c.np.vstack(
+                (
+                    c.np.random.rand(7, para_dim),
+                    c.np.full((1, para_dim), 0.5),
+                    c.np.zeros((1, para_dim)),
+                    c.np.ones((1, para_dim)),
+                )
+            )
+            orders = c.np.random.randint(0, 3, para_dim)
+
+            results = []
+            for use in (False, True):
+                previous = core.use_fixed_degree_kernels(use)
+                try:
+                    results.append(
+                        (
+                            bspline.evaluate(queries),
+                            bspline.derivative(queries, orders),
+                            bspline.basis(queries),
+                            bspline.support(queries),
+                            bspline.basis_derivative(queries, orders),
+                            nurbs.evaluate(queries),
+                            nurbs.basis_derivative(queries, orders),
+                            rational_bezier.evaluate(queries),
+                            rational_bezier.basis(queries),
+                        )
+                    )
+                finally:
+                    core.use_fixed_degree_kernels(previous)
+
+            for generic, fixed in zip(*results):
+                assert c.np.allclose(generic, fixed)
+
 
 if __name__ == "__main__":
     c.unittest.main()
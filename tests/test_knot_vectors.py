@@ -38,6 +38,57 @@ class KnotVectorsTest(c.SplineBasedTestCase):
                     c.np.array(spl_kv), c.np.repeat(u_kv, kn_m)
                 )
 
+    def test_shared_knot_vectors(self):
+        """Splines with identical knot vectors may share them internally.
+        Modifying one must not affect the others."""
+        for create in (self.bspline_2p2d, self.nurbs_2p2d):
+            reference = create()
+            ref_kvs = [c.np.array(kv) for kv in reference.knot_vectors]
+            queries = c.np.random.rand(10, 2)
+            ref_evaluated = reference.evaluate(queries)
+
+            refined, elevated, edited = create(), create(), create()
+            refined.insert_knots(0, [0.3])
+            elevated.elevate_degrees([1])
+            edited.knot_vectors[0][-1] = 2.0
+
+            # copies share, too
+            copied = create().copy()
+            assert c.np.allclose(copied.evaluate(queries), ref_evaluated)
+
+            for spline in (reference, copied):
+                for kv, ref_kv in zip(spline.knot_vectors, ref_kvs):
+                    assert c.np.allclose(c.np.array(kv), ref_kv)
+            assert len(refined.knot_vectors[0]) == len(ref_kvs[0]) + 1
+            assert c.np.isclose(edited.knot_vectors[0][-1], 2.0)
+            assert c.np.allclose(refined.evaluate(queries), ref_evaluated)
+            assert c.np.allclose(elevated.evaluate(queries), ref_evaluated)
+
+    def test_reads_keep_sharing(self):
+        """Only writes through knot vectors give a spline its own copy."""
+        for create in (self.bspline_2p2d, self.nurbs_2p2d):
+            a, b = create(), create()
+            address = b.knot_vectors._address()
+            assert a.knot_vectors._address() == address
+
+            # reads
+            kvs = a.knot_vectors
+            kvs[0].numpy()
+            list(kvs[1])
+            c.np.asarray(kvs[0])
+            kvs[0][1:3]
+            kvs.unique_knots()
+            kvs.copy()
+            a.knot_multiplicities
+            assert a.knot_vectors._address() == address
+
+            # write
+            kvs[0][-1] = 2.0
+            assert a.knot_vectors._address() != address
+            assert b.knot_vectors._address() == address
+            assert c.np.isclose(a.knot_vectors[0][-1], 2.0)
+            assert c.np.isclose(b.knot_vectors[0][-1], 1.0)
+
 
 if __name__ == "__main__":
     c.unittest.main()
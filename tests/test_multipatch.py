@@ -225,6 +225,599 @@ class MultipatchTest(c.unittest.TestCase):
 
         self.assertTrue(len(multipatch.boundary_patch_ids(8)) == 0)
 
+    def test_signed_distance_field(self):
+        # unit square -> analytic signed distance
+        square = c.splinepy.Bezier(
+            degrees=[1, 1],
+            control_points=[[0, 0], [1, 0], [0, 1], [1, 1]],
+        )
+        multipatch = c.splinepy.Multipatch([square])
+
+        bounds = [[-0.5, -0.5], [1.5, 1.5]]
+        resolutions = [5, 5]
+        grid = c.splinepy.utils.data.cartesian_product(
+            [c.np.linspace(-0.5, 1.5, 5)] * 2
+        )
+        q = abs(grid - 0.5) - 0.5
+        reference = c.np.linalg.norm(
+            c.np.maximum(q, 0.0), axis=1
+        ) + c.np.minimum(q.max(axis=1), 0.0)
+
+        sdf = multipatch.signed_distance_field(bounds, resolutions)
+        self.assertTrue(c.np.allclose(sdf, reference))
+
+        # narrow band
+        ids, values = multipatch.signed_distance_field(
+            bounds, resolutions, band_width=0.3, sparse=True
+        )
+        self.assertTrue(c.np.allclose(values, reference[ids]))
+        self.assertTrue(c.np.all(abs(values) < 0.3 + 1e-10))
+
+    def test_locate_points(self):
+        left = c.splinepy.Bezier(
+            degrees=[1, 1],
+            control_points=[[0, 0], [1, 0], [0, 1], [1, 1]],
+        )
+        right = c.splinepy.Bezier(
+            degrees=[1, 1],
+            control_points=[[1, 0], [2, 0], [1, 1], [2, 1]],
+        )
+        multipatch = c.splinepy.Multipatch([left, right])
+
+        queries = [[0.5, 0.5], [1.5, 0.25], [3.0, 3.0], [1.0, 0.5]]
+        patch_ids, para_coords = multipatch.locate_points(queries)
+
+        self.assertTrue(c.np.array_equal(patch_ids, [0, 1, -1, 0]))
+        self.assertTrue(
+            c.np.allclose(
+                para_coords[[0, 1, 3]], [[0.5, 0.5], [0.5, 0.25], [1.0, 0.5]]
+            )
+        )
+        self.assertTrue(c.np.isnan(para_coords[2]).all())
+
+        # cached location structure is rebuilt with new control points
+        patch_ids, _ = multipatch.locate_points(queries)
+        self.assertTrue(c.np.array_equal(patch_ids, [0, 1, -1, 0]))
+        multipatch.set_control_points(multipatch.control_points + [2.0, 2.0])
+        patch_ids, para_coords = multipatch.locate_points(
+            [[2.5, 2.5], [0.5, 0.5]]
+        )
+        self.assertTrue(c.np.array_equal(patch_ids, [0, -1]))
+        self.assertTrue(c.np.allclose(para_coords[0], [0.5, 0.5]))
+
+    def test_patch_targeted_evaluation(self):
+        left = c.splinepy.Bezier(
+            degrees=[1, 1],
+            control_points=[[0, 0], [1, 0], [0, 1], [1, 1]],
+        )
+        right = c.splinepy.Bezier(
+            degrees=[2, 1],
+            control_points=[
+                [1, 0],
+                [1.5, 0.2],
+                [2, 0],
+                [1, 1],
+                [1.5, 1.2],
+                [2, 1],
+            ],
+        )
+        multipatch = c.splinepy.Multipatch([left, right])
+
+        queries = c.np.random.random((9, 2))
+        patch_ids = c.np.array([1, 0, 1, 1, 0, 0, 1, 0, 1])
+        patches = [left, right]
+
+        def per_query(func):
+            return c.np.vstack(
+                [
+                    getattr(patches[p], func)(q.reshape(1, -1))
+                    for p, q in zip(patch_ids, queries)
+                ]
+            )
+
+        self.assertTrue(
+            c.np.allclose(
+                multipatch.evaluate(queries, patch_ids=patch_ids),
+                per_query("evaluate"),
+            )
+        )
+        self.assertTrue(
+            c.np.allclose(
+                multipatch.jacobian(queries, patch_ids=patch_ids),
+                per_query("jacobian"),
+            )
+        )
+        orders = [1, 0]
+        self.assertTrue(
+            c.np.allclose(
+                multipatch.derivative(queries, orders, patch_ids=patch_ids),
+                c.np.vstack(
+                    [
+                        patches[p].derivative(q.reshape(1, -1), orders)
+                        for p, q in zip(patch_ids, queries)
+                    ]
+                ),
+            )
+        )
+
+        # different number of supports
+        with self.assertRaises(RuntimeError):
+            multipatch.basis_and_support(queries, patch_ids=patch_ids)
+        basis, support = multipatch.basis_and_support(
+            queries[patch_ids == 0], patch_ids=patch_ids[patch_ids == 0]
+        )
+        ref_basis, ref_support = left.basis_and_support(
+            queries[patch_ids == 0]
+        )
+        self.assertTrue(c.np.allclose(basis, ref_basis))
+        self.assertTrue(c.np.array_equal(support, ref_support))
+
+        # without patch ids, all queries are evaluated at all patches
+        self.assertTrue(
+            c.np.allclose(
+                multipatch.jacobian(queries),
+                c.np.vstack([p.jacobian(queries) for p in patches]),
+            )
+        )
+        self.assertTrue(
+            c.np.allclose(
+                multipatch.derivative(queries, orders),
+                c.np.vstack([p.derivative(queries, orders) for p in patches]),
+            )
+        )
+
+    def test_homogeneous_evaluation(self):
+        def patch(knot):
+            return c.splinepy.BSpline(
+                degrees=[1, 1],
+                knot_vectors=[[0, 0, knot, 1, 1], [0, 0, 1, 1]],
+                control_points=c.np.random.random((6, 2)),
+            )
+
+        patches = [patch(0.5) for _ in range(4)]
+        multipatch = c.splinepy.Multipatch(patches)
+        self.assertTrue(multipatch.is_homogeneous)
+
+        queries = c.np.random.random((7, 2))
+        reference = c.np.vstack([p.evaluate(queries) for p in patches])
+        self.assertTrue(c.np.allclose(multipatch.evaluate(queries), reference))
+
+        # in-place changes are visible
+        patches[2].control_points[3] += 1.0
+        reference = c.np.vstack([p.evaluate(queries) for p in patches])
+        self.assertTrue(c.np.allclose(multipatch.evaluate(queries), reference))
+        self.assertTrue(
+            c.np.allclose(
+                multipatch.sample(3),
+                c.np.vstack([p.sample([3, 3]) for p in patches]),
+            )
+        )
+
+        # control points set through multipatch
+        multipatch.set_control_points(c.np.random.random((24, 2)))
+        reference = c.np.vstack([p.evaluate(queries) for p in patches])
+        self.assertTrue(c.np.allclose(multipatch.evaluate(queries), reference))
+        self.assertTrue(multipatch.is_homogeneous)
+
+        # in-place knot change of one patch
+        patches[0].knot_vectors[0][2] = 0.4
+        self.assertFalse(multipatch.is_homogeneous)
+        patches[0].knot_vectors[0][2] = 0.5
+        self.assertTrue(multipatch.is_homogeneous)
+
+        # in-place refinement changes the basis of one patch
+        patches[1].elevate_degrees([0])
+        patches[3].insert_knots(1, [0.5])
+        reference = c.np.vstack([p.evaluate(queries) for p in patches])
+        self.assertTrue(c.np.allclose(multipatch.evaluate(queries), reference))
+        self.assertFalse(multipatch.is_homogeneous)
+
+        # different knot vectors
+        patches[1] = patch(0.3)
+        self.assertFalse(c.splinepy.Multipatch(patches).is_homogeneous)
+
+    def test_set_control_points(self):
+        bezier = c.splinepy.Bezier(
+            degrees=[1, 1],
+            control_points=[[0, 0], [1, 0], [0, 1], [1, 1]],
+        )
+        nurbs = c.splinepy.NURBS(
+            degrees=[1, 1],
+            knot_vectors=[[0, 0, 1, 1], [0, 0, 1, 1]],
+            control_points=[[1, 0], [2, 0], [1, 1], [2, 1]],
+            weights=[1, 0.5, 1, 2],
+        )
+        multipatch = c.splinepy.Multipatch([bezier, nurbs])
+
+        new_control_points = multipatch.control_points + 0.5
+        multipatch.set_control_points(new_control_points)
+
+        self.assertTrue(
+            c.np.allclose(multipatch.control_points, new_control_points)
+        )
+        offsets = multipatch.control_point_offsets()
+        self.assertTrue(
+            c.np.allclose(
+                bezier.control_points, new_control_points[: offsets[1]]
+            )
+        )
+        self.assertTrue(
+            c.np.allclose(
+                nurbs.control_points, new_control_points[offsets[1] :]
+            )
+        )
+        queries = c.np.random.random((5, 2))
+        self.assertTrue(
+            c.np.allclose(
+                multipatch.evaluate(queries),
+                c.np.vstack(
+                    [bezier.evaluate(queries), nurbs.evaluate(queries)]
+                ),
+            )
+        )
+
+    def test_interfaces_non_manifold_and_append(self):
+        def square(x, y):
+            return c.splinepy.Bezier(
+                degrees=[1, 1],
+                control_points=[
+                    [x, y],
+                    [x + 1, y],
+                    [x, y + 1],
+                    [x + 1, y + 1],
+                ],
+            )
+
+        multipatch = c.splinepy.Multipatch([square(0, 0), square(1, 0)])
+        multipatch.determine_interfaces()
+        self.assertTrue(
+            c.np.array_equal(
+                multipatch.interfaces, [[-1, 4, -1, -1], [1, -1, -1, -1]]
+            )
+        )
+
+        # appended patch connects to the top of the first patch
+        multipatch.append_patches([square(0, 1)])
+        self.assertTrue(
+            c.np.array_equal(
+                multipatch.interfaces,
+                [[-1, 4, -1, 10], [1, -1, -1, -1], [-1, -1, 3, -1]],
+            )
+        )
+        self.assertEqual(len(multipatch.non_manifold_faces), 0)
+
+        # three coinciding faces are reported, instead of raising
+        multipatch.append_patches([square(0, 1)])
+        self.assertTrue(
+            c.np.array_equal(multipatch.non_manifold_faces, [3, 10, 14])
+        )
+        self.assertTrue(
+            c.np.array_equal(
+                multipatch.interfaces,
+                [
+                    [-1, 4, -1, -1],
+                    [1, -1, -1, -1],
+                    [12, 13, -1, 15],
+                    [8, 9, -1, 11],
+                ],
+            )
+        )
+
+        # two new faces match the same existing face, but not each other
+        multipatch = c.splinepy.Multipatch([square(0, 0)])
+        multipatch.tolerance = 0.1
+        multipatch.determine_interfaces(tolerance=0.1)
+        multipatch.append_patches([square(-0.08, 1), square(0.08, 1)])
+        self.assertTrue(
+            c.np.array_equal(multipatch.non_manifold_faces, [3, 6, 10])
+        )
+        self.assertTrue(c.np.all(multipatch.interfaces == -1))
+
+    def test_global_control_point_ids(self):
+        left = c.splinepy.Bezier(
+            degrees=[1, 1],
+            control_points=[[0, 0], [1, 0], [0, 1], [1, 1]],
+        )
+        right = c.splinepy.Bezier(
+            degrees=[1, 1],
+            control_points=[[1, 0], [2, 0], [1, 1], [2, 1]],
+        )
+        multipatch = c.splinepy.Multipatch([left, right])
+        local_to_global, n_unique = multipatch.global_control_point_ids()
+
+        self.assertEqual(n_unique, 6)
+        self.assertTrue(
+            c.np.array_equal(local_to_global, [0, 1, 2, 3, 1, 4, 3, 5])
+        )
+
+        # mismatching interfaces raise, also with multiple threads
+        multipatch.interfaces = [[-1, 4, -1, -1], [-1, -1, -1, -1]]
+        with self.assertRaises(RuntimeError):
+            multipatch.global_control_point_ids(nthreads=2)
+
+        # flipped and non-conforming neighbor
+        top = c.splinepy.Bezier(
+            degrees=[2, 1],
+            control_points=[
+                [1, 2],
+                [0.5, 2],
+                [0, 2],
+                [1, 1],
+                [0.5, 1],
+                [0, 1],
+            ],
+        )
+        multipatch = c.splinepy.Multipatch([left, right, top])
+        local_to_global, n_unique = multipatch.global_control_point_ids()
+
+        self.assertEqual(n_unique, 10)
+        cps = multipatch.control_points
+        for global_id in range(n_unique):
+            coincident = cps[local_to_global == global_id]
+            self.assertTrue(c.np.allclose(coincident, coincident[0]))
+
+    def test_basis_matrix(self):
+        left = c.splinepy.BSpline(
+            degrees=[2, 1],
+            knot_vectors=[[0, 0, 0, 0.5, 1, 1, 1], [0, 0, 1, 1]],
+            control_points=[
+                [0, 0],
+                [0.3, 0],
+                [0.7, 0],
+                [1, 0],
+                [0, 1],
+                [0.3, 1.2],
+                [0.7, 1.2],
+                [1, 1],
+            ],
+        )
+        right = c.splinepy.Bezier(
+            degrees=[1, 1],
+            control_points=[[1, 0], [2, 0], [1, 1], [2, 1]],
+        )
+        multipatch = c.splinepy.Multipatch([left, right])
+
+        queries = c.np.random.random((10, 2))
+        patch_ids = c.np.random.randint(0, 2, 10)
+        reference = multipatch.evaluate(queries, patch_ids=patch_ids)
+        control_points = multipatch.control_points
+
+        matrix = multipatch.basis_matrix(queries, patch_ids, as_array=True)
+        self.assertEqual(matrix.shape, (10, 12))
+        self.assertTrue(c.np.allclose(matrix @ control_points, reference))
+
+        local_to_global, n_unique = multipatch.global_control_point_ids()
+        unique_control_points = c.np.empty((n_unique, 2))
+        unique_control_points[local_to_global] = control_points
+        merged = multipatch.basis_matrix(
+            queries, patch_ids, merge=True, as_array=True
+        )
+        self.assertEqual(merged.shape, (10, n_unique))
+        self.assertTrue(
+            c.np.allclose(merged @ unique_control_points, reference)
+        )
+
+        # derivatives
+        derivative = multipatch.basis_matrix(
+            queries, patch_ids, orders=[1, 0], as_array=True
+        )
+        self.assertTrue(
+            c.np.allclose(
+                derivative @ control_points,
+                multipatch.derivative(queries, [1, 0], patch_ids=patch_ids),
+            )
+        )
+
+    def test_evaluate_with_fields(self):
+        left = c.splinepy.Bezier(
+            degrees=[1, 1],
+            control_points=[[0, 0], [1, 0], [0, 1], [1, 1]],
+        )
+        right = c.splinepy.Bezier(
+            degrees=[1, 1],
+            control_points=[[1, 0], [2, 0], [1, 1], [2, 1]],
+        )
+        multipatch = c.splinepy.Multipatch([left, right])
+
+        # shared basis, null spline and a field with different weights
+        scalar = [
+            c.splinepy.Bezier(
+                degrees=[1, 1], control_points=[[1], [2], [3], [4]]
+            ),
+            None,
+        ]
+        rational = [
+            c.splinepy.RationalBezier(
+                degrees=[1, 1],
+                control_points=[[1, 1], [2, 2], [3, 3], [4, 4]],
+                weights=[1, 0.5, 0.5, 1],
+            ),
+            c.splinepy.Bezier(
+                degrees=[1, 1], control_points=[[0, 1], [1, 1], [0, 2], [1, 2]]
+            ),
+        ]
+        multipatch.add_fields([scalar], field_dim=1, check_compliance=False)
+        multipatch.add_fields([rational], field_dim=2, check_compliance=False)
+
+        queries = c.np.random.random((7, 2))
+        geometry, fields = multipatch.evaluate_with_fields(queries)
+        self.assertTrue(c.np.allclose(geometry, multipatch.evaluate(queries)))
+        self.assertEqual(len(fields), 2)
+        self.assertTrue(
+            c.np.allclose(fields[0][:7], scalar[0].evaluate(queries))
+        )
+        self.assertTrue(c.np.allclose(fields[0][7:], 0.0))
+        self.assertTrue(
+            c.np.allclose(fields[1][:7], rational[0].evaluate(queries))
+        )
+        self.assertTrue(
+            c.np.allclose(fields[1][7:], rational[1].evaluate(queries))
+        )
+
+        # patch targeted
+        patch_ids = c.np.array([0, 1, 1, 0, 1, 0, 0])
+        geometry, fields = multipatch.evaluate_with_fields(
+            queries, patch_ids=patch_ids
+        )
+        self.assertTrue(
+            c.np.allclose(
+                geometry, multipatch.evaluate(queries, patch_ids=patch_ids)
+            )
+        )
+        self.assertTrue(
+            c.np.allclose(
+                fields[1][patch_ids == 1],
+                rational[1].evaluate(queries[patch_ids == 1]),
+            )
+        )
+
+    def test_partition(self):
+        # 4 x 2 grid of unit squares
+        patches = []
+        for j in range(2):
+            for i in range(4):
+                patches.append(
+                    c.splinepy.Bezier(
+                        degrees=[1, 1],
+                        control_points=c.np.array(
+                            [[0, 0], [1, 0], [0, 1], [1, 1]]
+                        )
+                        + [i, j],
+                    )
+                )
+        multipatch = c.splinepy.Multipatch(patches)
+
+        parts = multipatch.partition(2, weights="uniform")
+        self.assertEqual(parts.shape, (8,))
+        self.assertTrue(c.np.array_equal(c.np.bincount(parts), [4, 4]))
+        # parts are connected
+        self.assertTrue(c.np.all(parts[[0, 1, 4, 5]] == parts[0]))
+
+        # heavy patch is alone
+        weights = c.np.ones(8)
+        weights[3] = 7
+        parts = multipatch.partition(2, weights=weights)
+        self.assertEqual(c.np.sum(parts == parts[3]), 1)
+
+        parts, order = multipatch.partition(4, renumber=True)
+        self.assertTrue(c.np.array_equal(c.np.sort(order), c.np.arange(8)))
+        self.assertTrue(c.np.all(c.np.diff(parts[order]) >= 0))
+
+        with self.assertRaises(RuntimeError):
+            multipatch.partition(2, weights="unknown")
+
+    def test_sample_watertight(self):
+        left = c.splinepy.Bezier(
+            degrees=[1, 1],
+            control_points=[[0, 0], [1, 0], [0, 1], [1, 1]],
+        )
+        # flipped parametrization
+        right = c.splinepy.Bezier(
+            degrees=[1, 1],
+            control_points=[[1, 1], [1, 0], [2, 1], [2, 0]],
+        )
+        top = c.splinepy.Bezier(
+            degrees=[1, 1],
+            control_points=[[0, 1], [1, 1], [0, 2], [1, 2]],
+        )
+        multipatch = c.splinepy.Multipatch([left, right, top])
+
+        resolution = 4
+        vertices, connectivity = multipatch.sample_watertight(resolution)
+
+        # 3 patches with 16 samples, 2 interfaces with 4 shared samples
+        self.assertEqual(vertices.shape, (3 * 16 - 2 * 4, 2))
+        self.assertEqual(connectivity.shape, (3 * 9, 4))
+        self.assertEqual(
+            c.np.unique(vertices.round(8), axis=0).shape[0], vertices.shape[0]
+        )
+
+        # each patch references its own samples
+        sampled = multipatch.sample(resolution).reshape(3, -1, 2)
+        connectivity = connectivity.reshape(3, 9, 4)
+        for i in range(3):
+            used = c.np.unique(connectivity[i])
+            self.assertEqual(used.size, 16)
+            self.assertTrue(
+                c.np.allclose(
+                    c.np.sort(vertices[used], axis=0),
+                    c.np.sort(sampled[i], axis=0),
+                )
+            )
+
+        # first quad of first patch in VTK ordering
+        self.assertTrue(
+            c.np.allclose(
+                vertices[connectivity[0, 0]],
+                [[0, 0], [1 / 3, 0], [1 / 3, 1 / 3], [0, 1 / 3]],
+            )
+        )
+
+        # distance and angle tolerances are independent. Sample points that
+        # are farther apart than the distance tolerance are kept
+        loose, _ = multipatch.sample_watertight(
+            resolution, tolerance=1e-8, angle_tolerance=1e-3
+        )
+        self.assertEqual(loose.shape, vertices.shape)
+
+        top.cps[0] += [0, 1e-6]
+        multipatch = c.splinepy.Multipatch([left, right, top])
+        multipatch.determine_interfaces(tolerance=1e-5)
+        merged, _ = multipatch.sample_watertight(
+            resolution, tolerance=1e-5, angle_tolerance=1e-3
+        )
+        self.assertEqual(merged.shape, vertices.shape)
+        # only the shared corner at (1, 1) coincides
+        split, _ = multipatch.sample_watertight(
+            resolution, tolerance=1e-8, angle_tolerance=1e-3
+        )
+        self.assertEqual(split.shape[0], vertices.shape[0] + 3)
+
+    def test_sample_patches(self):
+        small = c.splinepy.Bezier(
+            degrees=[1, 1],
+            control_points=[[0, 0], [0.1, 0], [0, 0.1], [0.1, 0.1]],
+        )
+        large = c.splinepy.BSpline(
+            degrees=[1, 2],
+            knot_vectors=[[0, 0, 1, 1], [0, 0, 0, 0.5, 1, 1, 1]],
+            control_points=[
+                [1, 0],
+                [3, 0],
+                [1, 0.5],
+                [3, 0.5],
+                [1, 1],
+                [3, 1],
+                [1, 2],
+                [3, 2],
+            ],
+        )
+        multipatch = c.splinepy.Multipatch([small, large])
+
+        resolutions = multipatch.sample_resolutions(0.5)
+        self.assertTrue(c.np.array_equal(resolutions, [[2, 2], [5, 5]]))
+
+        sampled, offsets = multipatch.sample_patches(resolutions)
+        self.assertTrue(c.np.array_equal(offsets, [0, 4, 29]))
+        self.assertTrue(c.np.allclose(sampled[:4], small.sample([2, 2])))
+        self.assertTrue(c.np.allclose(sampled[4:], large.sample([5, 5])))
+
+        # uniform per patch and threaded
+        sampled, offsets = multipatch.sample_patches([3, 4], nthreads=3)
+        self.assertTrue(c.np.array_equal(offsets, [0, 9, 25]))
+        self.assertTrue(c.np.allclose(sampled[9:], large.sample([4, 4])))
+
+        sampled_default, _ = multipatch.sample_patches(spacing=0.5)
+        self.assertEqual(sampled_default.shape, (29, 2))
+
+        # a single sample per axis can't span the parametric bounds
+        with self.assertRaises(RuntimeError):
+            multipatch.sample_patches([1, 4], nthreads=2)
+        with self.assertRaises(RuntimeError):
+            multipatch.sample_patches([[2, 2], [1, 3]])
+        with self.assertRaises(RuntimeError):
+            multipatch.sample_resolutions(0.5, min_resolution=1)
+
 
 if __name__ == "__main__":
     c.unittest.main()
@@ -83,6 +83,57 @@ class orientationTest(c.unittest.TestCase):
         self.assertTrue(c.np.all(expected_mappings == axis_mapping))
         self.assertTrue(c.np.all(expected_orientations == axis_orientation))
 
+    def test_interface_orientations(self):
+        # same setup as above, but batched over all interfaces of a multipatch
+        spline_list = [
+            c.splinepy.Bezier(
+                degrees=[1, 1], control_points=[[1, 1], [2, 1], [1, 2], [2, 2]]
+            ),
+            c.splinepy.Bezier(
+                degrees=[1, 1], control_points=[[2, 1], [2, 2], [3, 1], [3, 2]]
+            ),
+            c.splinepy.Bezier(
+                degrees=[1, 1], control_points=[[1, 2], [2, 2], [1, 3], [2, 3]]
+            ),
+            c.splinepy.Bezier(
+                degrees=[1, 1], control_points=[[0, 2], [1, 2], [0, 1], [1, 1]]
+            ),
+            c.splinepy.Bezier(
+                degrees=[1, 1], control_points=[[2, 1], [1, 1], [2, 0], [1, 0]]
+            ),
+        ]
+        multipatch = c.splinepy.Multipatch(spline_list)
+
+        # more threads than interfaces and faces must not split past the end
+        for nthreads in (1, 3, 4, 7, 16):
+            (
+                start_ids,
+                start_face_ids,
+                neighbor_ids,
+                neighbor_face_ids,
+                axis_mapping,
+                axis_orientation,
+            ) = multipatch.interface_orientations(
+                tolerance=0.00001, nthreads=nthreads
+            )
+
+            self.assertTrue(c.np.all(start_ids == 0))
+            self.assertTrue(c.np.all(start_face_ids == [0, 1, 2, 3]))
+            self.assertTrue(c.np.all(neighbor_ids == [3, 1, 4, 2]))
+            self.assertTrue(c.np.all(neighbor_face_ids == [1, 2, 2, 2]))
+
+            expected_mappings = [[0, 1], [1, 0], [0, 1], [0, 1]]
+            expected_orientations = [
+                [True, False],
+                [True, True],
+                [False, False],
+                [True, True],
+            ]
+            self.assertTrue(c.np.all(expected_mappings == axis_mapping))
+            self.assertTrue(
+                c.np.all(expected_orientations == axis_orientation)
+            )
+
 
 if __name__ == "__main__":
     c.unittest.main()
@@ -30,6 +30,51 @@ class ProximityTest(c.unittest.TestCase):
                 para_q, prox_r[0]
             ), f"WRONG proximity query for {spline.whatami}"
 
+    def test_proximity_statistics(self):
+        """
+        Statistics are only recorded if requested.
+        """
+        for spline in c.spline_types_as_list():
+            para_q = c.np.random.random((10, spline.para_dim))
+            phys_q = spline.evaluate(para_q)
+
+            prox_r, stats = spline.proximities(
+                queries=phys_q,
+                initial_guess_sample_resolutions=[10] * spline.para_dim,
+                nthreads=2,
+                return_statistics=True,
+            )
+
+            assert c.np.allclose(para_q, prox_r)
+            assert stats["n_kdtree_plantings"] == 1
+            assert stats["n_samples"] == 10**spline.para_dim
+            assert stats["n_queries"] == len(phys_q)
+            assert len(stats["iterations"]) == len(phys_q)
+            assert stats["n_iterations"] == stats["iterations"].sum()
+            assert stats["n_evaluations"] == stats["n_iterations"] + len(
+                phys_q
+            )
+
+    def test_nearly_singular_jacobian(self):
+        """
+        Newton systems of a nearly degenerate parametrization are too
+        ill-conditioned for closed form inversion and use the fallback.
+        """
+        spline = c.splinepy.Bezier(
+            degrees=[1, 1],
+            control_points=[[0, 0], [1, 0], [1, 1e-7], [2, 1e-7]],
+        )
+        para_q = c.np.random.random((10, 2))
+        phys_q = spline.evaluate(para_q)
+
+        prox_r = spline.proximities(
+            queries=phys_q,
+            initial_guess_sample_resolutions=[10, 10],
+            nthreads=1,
+        )
+
+        assert c.np.allclose(spline.evaluate(prox_r), phys_q, atol=1e-12)
+
 
 if __name__ == "__main__":
     c.unittest.main()
@@ -210,6 +210,63 @@ class TestSplineConstructors(c.unittest.TestCase):
             weights=c.np.random.rand(9),
         )
 
+    def testHighDimensional(self):
+        """Splines beyond template instantiations use a runtime dimensioned
+        fallback, which should match the templated ones"""
+        degrees = [2, 3]
+        n_cps = 12
+        control_points = c.np.random.rand(n_cps, 12)
+        weights = c.np.random.rand(n_cps) + 0.5
+        queries = c.np.random.rand(10, 2)
+        orders = [1, 2]
+
+        for high, low in (
+            (
+                c.splinepy.Bezier(
+                    degrees=degrees, control_points=control_points
+                ),
+                c.splinepy.Bezier(
+                    degrees=degrees, control_points=control_points[:, :3]
+                ),
+            ),
+            (
+                c.splinepy.RationalBezier(
+                    degrees=degrees,
+                    control_points=control_points,
+                    weights=weights,
+                ),
+                c.splinepy.RationalBezier(
+                    degrees=degrees,
+                    control_points=control_points[:, :3],
+                    weights=weights,
+                ),
+            ),
+        ):
+            assert high.dim == 12
+            assert c.np.allclose(
+                high.evaluate(queries)[:, :3], low.evaluate(queries)
+            )
+            assert c.np.allclose(
+                high.derivative(queries, orders)[:, :3],
+                low.derivative(queries, orders),
+            )
+            assert c.np.allclose(high.basis(queries), low.basis(queries))
+            assert c.np.allclose(
+                high.jacobian(queries)[:, :3], low.jacobian(queries)
+            )
+            assert c.np.allclose(high.control_points, control_points)
+
+            # boundaries are control mesh slices, same as templated ones
+            for high_boundary, low_boundary in zip(
+                high.extract.boundaries(), low.extract.boundaries()
+            ):
+                assert high_boundary.para_dim == 1
+                assert high_boundary.dim == 12
+                assert c.np.allclose(
+                    high_boundary.evaluate(queries[:, :1])[:, :3],
+                    low_boundary.evaluate(queries[:, :1]),
+                )
+
 
 if __name__ == "__main__":
     c.unittest.main()